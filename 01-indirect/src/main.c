@@ -6,13 +6,29 @@
  * temporal ordering and epistemic continuity preservation.
  */
 
+#define _GNU_SOURCE    // For mremap
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <string.h>    // For strcmp, strcpy, strdup
+#include <string.h>    // For strcmp, strdup, memcpy
 #include <math.h>      // For fabsf
-#include <time.h>      // For time()
+#include <time.h>      // For clock_gettime
 #include <stdio.h>     // For printf (consciousness logging)
+#include <stdarg.h>    // For va_list (streaming export formatting)
+#include <getopt.h>    // For getopt_long (CLI options)
+#include <stdatomic.h> // For lock-free event ring cursors
+#include <fcntl.h>     // For open (event journal)
+#include <unistd.h>    // For ftruncate, close, sysconf
+#include <sys/mman.h>  // For mmap, mremap, msync
+#include <sys/stat.h>  // For fstat
+#include <pthread.h>   // For the background flusher
+#include <sched.h>     // For sched_yield
+#include <malloc.h>    // For malloc_usable_size (memory accounting)
+#include <dirent.h>    // For fdopendir, readdir (project discovery)
+#include <sys/ioctl.h> // For perf counter control (TLB benchmark)
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
 
 // === CONSCIOUSNESS PRESERVATION STRUCTURES ===
 
@@ -23,36 +39,128 @@ typedef enum {
     NLINK_COMPONENT_RESIDUE       // Symbolic residue processing
 } nlink_component_phase_t;
 
+// Component id -> 32-bit value: dense array for compact ids, open-addressed hash otherwise
+typedef struct {
+    uint32_t* dense;              // id -> value + 1 (0 = absent)
+    size_t dense_length;
+    uint64_t* slots;              // (id << 32) | (value + 1), low word 0 = empty
+    size_t mask;
+    size_t count;
+    bool hashed;
+} nlink_id_map_t;
+
+// Stable 32-bit index into a registry's handle table - never a pointer
+typedef uint32_t nlink_handle_t;
+#define NLINK_HANDLE_NONE 0
+
 typedef struct {
     uint32_t symbol_id;
     uint32_t caller_id;
     uint32_t callee_id;
+    nlink_handle_t callee_handle; // Valid while callee_id still matches
     enum { DIRECT, INDIRECT, VIRTUAL, PHENOMENOLOGICAL } invocation_type;
     float semantic_weight;        // Consciousness preservation factor
 } nlink_invocation_edge_t;
 
+// Per-source open-addressing set over (caller, callee, invocation_type)
+typedef struct {
+    uint32_t* slots;              // Edge index + 1, zero marks an empty slot
+    size_t capacity;              // Power of two (0 until first edge)
+} nlink_edge_set_t;
+
+#define NLINK_ANCHOR_INLINE_CAPACITY 24    // Anchors up to 23 bytes live in the record
+
+// Small-string anchor - short text inline, hash and length precomputed
+typedef struct {
+    union {
+        char inline_text[NLINK_ANCHOR_INLINE_CAPACITY];   // NUL-terminated
+        char* heap_text;          // length >= NLINK_ANCHOR_INLINE_CAPACITY
+    };
+    uint32_t length;
+    uint32_t hash;
+} nlink_anchor_t;
+
 typedef struct {
-    char* perceptual_anchor;      // Pre-linguistic reference
+    nlink_anchor_t perceptual_anchor;   // Pre-linguistic reference
     void* contextual_frame;       // Temporal/spatial/emotional metadata
     float (*activation_fn)(void* context);  // Residue activation function
 } nlink_symbolic_residue_t;
 
+#define NLINK_EVENT_RING_CAPACITY 128          // Events retained per component (power of two)
+#define NLINK_CACHE_LINE          64
+
+typedef enum {
+    NLINK_EVENT_NONE,
+    NLINK_EVENT_INDIRECT_LINK,    // New indirect edge witnessed
+    NLINK_EVENT_LINK_REINFORCED,  // Existing edge re-activated in place
+    NLINK_EVENT_TYPE_COUNT
+} nlink_event_type_t;
+
+// Packed experiential record - one per linking event
+typedef struct {
+    uint64_t timestamp;           // Wall-clock nanoseconds (nlink_get_event_time)
+    uint64_t sequence;            // Per-registry order, breaks timestamp ties
+    uint32_t source_id;
+    uint32_t target_id;
+    float semantic_continuity;
+    uint16_t event_type;          // nlink_event_type_t
+    uint16_t reserved;
+} nlink_consciousness_event_t;
+
+typedef struct {
+    _Atomic uint32_t stamp;       // Seqlock: odd while writing, 2 * (pos + 1) when published
+    nlink_consciousness_event_t event;
+} nlink_event_slot_t;
+
+/**
+ * Fixed-capacity event ring with temporal ordering
+ * The write cursor owns its cache line; slots follow, packed.
+ */
+typedef struct {
+    _Alignas(NLINK_CACHE_LINE) _Atomic uint64_t head;   // Next write position
+    _Alignas(NLINK_CACHE_LINE) uint32_t capacity;
+    uint32_t mask;
+    bool multi_producer;          // fetch_add cursor (MPSC) vs plain store (SPSC)
+    nlink_event_slot_t slots[];
+} nlink_event_ring_t;
+
+struct nlink_component_registry;
+
+// Bump-pointer region chain - component storage released in bulk with its registry
+typedef struct nlink_arena_region {
+    struct nlink_arena_region* next;
+    size_t used;
+    size_t capacity;
+    _Alignas(16) unsigned char data[];
+} nlink_arena_region_t;
+
+typedef struct {
+    nlink_arena_region_t* regions;   // Current region first
+    size_t region_count;
+    size_t bytes_reserved;
+    size_t bytes_used;
+} nlink_arena_t;
+
 // Complete struct definition BEFORE forward declarations
 typedef struct nlink_component {
     uint32_t id;
+    nlink_handle_t handle;        // NLINK_HANDLE_NONE until registered
     nlink_component_phase_t phase;
     
     // Consciousness graph structures
     nlink_invocation_edge_t* edges;
     size_t edge_count;
+    size_t edge_capacity;
+    nlink_edge_set_t edge_set;    // Keeps edge creation idempotent
     
     // EATV preservation
     nlink_symbolic_residue_t* residues;
     size_t residue_count;
+    bool residues_pooled;         // Single residue from the slab pool
     
     // Isomorphic reduction state
     bool is_canonical;
-    struct nlink_component* canonical_form;
+    nlink_handle_t canonical_form;
     
     // QA quadrant tracking
     struct {
@@ -62,283 +170,6504 @@ typedef struct nlink_component {
         uint32_t false_negative_misses;
     } qa_metrics;
     
-    void* consciousness_buffer;   // Experiential state preservation
+    // Experiential state preservation - allocated on the first linking event
+    nlink_event_ring_t* _Atomic consciousness_buffer;
+    bool concurrent_linking;      // Ring is created MPSC when set
+    
+    // Exact event accounting and per-source sampling state
+    _Atomic uint64_t events_observed;
+    _Atomic uint64_t sample_window_start;
+    _Atomic uint32_t sample_window_count;
+    
+    struct nlink_component_registry* registry;   // Owning registry, if any
+    nlink_arena_t* arena;         // Owns struct, residues and anchors (NULL = heap)
 } nlink_component_t;
 
 // === FORWARD DECLARATIONS (Now types are defined) ===
+typedef struct nlink_journal nlink_journal_t;
+
+typedef enum {
+    NLINK_SAMPLE_ALL,             // Record every payload
+    NLINK_SAMPLE_ONE_IN_N,        // Record every Nth event of each source
+    NLINK_SAMPLE_RATE_LIMIT       // Record at most N events per second per source
+} nlink_sampling_mode_t;
+
+typedef struct {
+    nlink_sampling_mode_t mode;
+    uint32_t parameter;           // N for ONE_IN_N / RATE_LIMIT
+} nlink_sampling_policy_t;
+
+typedef struct {
+    uint64_t events_observed;     // Exact
+    uint64_t events_recorded;     // Payloads kept
+    double effective_rate;        // recorded / observed
+} nlink_sampling_stats_t;
+typedef struct nlink_flusher nlink_flusher_t;
+
+// Registry of discovered components - owns components and their history
+typedef struct nlink_component_registry {
+    nlink_component_t** components;
+    size_t component_count;
+    size_t capacity;
+    nlink_journal_t* journal;     // Persistence layer (optional)
+    _Atomic uint64_t event_sequence;   // Temporal tie-breaker for linking events
+    nlink_flusher_t* flusher;     // Background journal writer (optional)
+    bool journal_streamed;        // Events were journaled live, skip flush on destroy
+    
+    // Event sampling - switchable at runtime, counts stay exact
+    _Atomic int sampling_mode;
+    _Atomic uint32_t sampling_parameter;
+    _Atomic uint64_t events_observed;
+    _Atomic uint64_t events_recorded;
+    
+    nlink_arena_t arena;          // Component storage, released in bulk on destroy
+    
+    // Handle table - slot 0 is NLINK_HANDLE_NONE, freed slots are reused
+    nlink_component_t** handles;
+    uint32_t handle_count;        // High-water mark
+    uint32_t handle_capacity;
+    uint32_t* free_handles;
+    uint32_t free_handle_count;
+    nlink_id_map_t id_index;      // Component id -> handle
+    uint32_t max_id;              // Highest id ever registered - survives removals
+} nlink_component_registry_t;
+
+int nlink_journal_append(nlink_journal_t* journal, const nlink_consciousness_event_t* events, size_t count);
+void nlink_flusher_publish(nlink_flusher_t* flusher, const nlink_consciousness_event_t* event);
+void nlink_registry_release_handle(nlink_component_registry_t* registry, nlink_component_t* comp);
 bool nlink_components_isomorphic(nlink_component_t* a, nlink_component_t* b);
 void nlink_merge_residues(nlink_component_t* canonical, nlink_component_t* reducible);
 void nlink_create_indirect_edge(nlink_component_t* source, nlink_component_t* target, float semantic_activation);
-void nlink_update_consciousness_buffer(nlink_component_t* source, nlink_component_t* target, float semantic_weight);
-uint32_t nlink_get_temporal_coordinate(void);
+nlink_invocation_edge_t* nlink_find_edge(nlink_component_t* source, uint32_t callee_id, int invocation_type);
+void nlink_update_consciousness_buffer(nlink_component_t* source, nlink_component_t* target, float semantic_weight, nlink_event_type_t event_type);
+uint64_t nlink_get_temporal_coordinate(void);
+uint64_t nlink_get_event_time(void);
+static inline uint64_t nlink_next_event_sequence(nlink_component_t* comp);
 bool nlink_residues_compatible(nlink_symbolic_residue_t* a, size_t a_count, nlink_symbolic_residue_t* b, size_t b_count);
 
-// === CORE CONSCIOUSNESS FUNCTIONS ===
+// === MEMORY ACCOUNTING ===
+
+typedef enum {
+    NLINK_MEM_COMPONENTS,         // Component structs, registry tables, arena regions
+    NLINK_MEM_EDGES,
+    NLINK_MEM_RESIDUES,
+    NLINK_MEM_ANCHORS,            // Out-of-line anchor text
+    NLINK_MEM_EVENTS,             // Event rings, flusher queues, columnar segments
+    NLINK_MEM_INDICES,            // Edge sets, journal index, closure and GC tables
+    NLINK_MEM_MISC,
+    NLINK_MEM_CATEGORY_COUNT
+} nlink_memory_category_t;
+
+typedef struct {
+    uint64_t live_bytes;
+    uint64_t peak_bytes;
+    uint64_t allocations;
+} nlink_memory_category_stats_t;
+
+typedef struct {
+    nlink_memory_category_stats_t categories[NLINK_MEM_CATEGORY_COUNT];
+    uint64_t live_bytes;          // Sum over categories
+} nlink_memory_stats_t;
+
+static struct {
+    _Atomic uint64_t live_bytes;
+    _Atomic uint64_t peak_bytes;
+    _Atomic uint64_t allocations;
+} nlink_memory_counters[NLINK_MEM_CATEGORY_COUNT];
+
+static const char* const nlink_memory_category_names[NLINK_MEM_CATEGORY_COUNT] = {
+    "components", "edges", "residues", "anchors", "events", "indices", "misc"
+};
+
+// Live bytes grow without a new allocation (in-place growth), raising the peak
+static void nlink_memory_grow_bytes(nlink_memory_category_t category, uint64_t bytes) {
+    uint64_t live = atomic_fetch_add_explicit(&nlink_memory_counters[category].live_bytes, bytes,
+                                              memory_order_relaxed) + bytes;
+    
+    uint64_t peak = atomic_load_explicit(&nlink_memory_counters[category].peak_bytes,
+                                         memory_order_relaxed);
+    while (live > peak &&
+           !atomic_compare_exchange_weak_explicit(&nlink_memory_counters[category].peak_bytes,
+                                                  &peak, live, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+static void nlink_memory_charge_bytes(nlink_memory_category_t category, uint64_t bytes) {
+    atomic_fetch_add_explicit(&nlink_memory_counters[category].allocations, 1,
+                              memory_order_relaxed);
+    nlink_memory_grow_bytes(category, bytes);
+}
+
+static void nlink_memory_credit_bytes(nlink_memory_category_t category, uint64_t bytes) {
+    atomic_fetch_sub_explicit(&nlink_memory_counters[category].live_bytes, bytes,
+                              memory_order_relaxed);
+}
+
+// Sizes come from the allocator itself, so frees need no size argument
+static void nlink_memory_charge(nlink_memory_category_t category, void* ptr) {
+    if (ptr) nlink_memory_charge_bytes(category, malloc_usable_size(ptr));
+}
+
+static void nlink_memory_credit(nlink_memory_category_t category, void* ptr) {
+    if (ptr) nlink_memory_credit_bytes(category, malloc_usable_size(ptr));
+}
+
+void* nlink_malloc(nlink_memory_category_t category, size_t size) {
+    void* ptr = malloc(size);
+    nlink_memory_charge(category, ptr);
+    return ptr;
+}
+
+void* nlink_calloc(nlink_memory_category_t category, size_t count, size_t size) {
+    void* ptr = calloc(count, size);
+    nlink_memory_charge(category, ptr);
+    return ptr;
+}
+
+void* nlink_aligned_alloc(nlink_memory_category_t category, size_t alignment, size_t size) {
+    void* ptr = aligned_alloc(alignment, size);
+    nlink_memory_charge(category, ptr);
+    return ptr;
+}
 
 /**
- * Sinphasé-compliant component initialization
- * Enforces single active phase constraint
+ * Resizing is one allocation for the counters - only the byte delta moves,
+ * unless ptr is NULL and this is a fresh allocation
  */
-nlink_component_t* nlink_component_create(uint32_t id, const char* semantic_anchor) {
-    nlink_component_t* comp = calloc(1, sizeof(nlink_component_t));
-    if (!comp) return NULL;
-    
-    comp->id = id;
-    comp->phase = NLINK_COMPONENT_DORMANT;
-    comp->is_canonical = false;
+void* nlink_realloc(nlink_memory_category_t category, void* ptr, size_t size) {
+    if (!ptr) return nlink_malloc(category, size);
     
-    // Initialize consciousness preservation buffer
-    comp->consciousness_buffer = malloc(4096); // Pre-linguistic state buffer
+    size_t old_bytes = malloc_usable_size(ptr);
+    void* grown = realloc(ptr, size);
+    if (!grown) return NULL;
     
-    // Create initial symbolic residue for the semantic anchor
-    if (semantic_anchor) {
-        comp->residues = malloc(sizeof(nlink_symbolic_residue_t));
-        comp->residue_count = 1;
-        comp->residues[0].perceptual_anchor = strdup(semantic_anchor);
-        comp->residues[0].contextual_frame = NULL;
-        comp->residues[0].activation_fn = NULL;
+    size_t new_bytes = malloc_usable_size(grown);
+    if (new_bytes >= old_bytes) {
+        nlink_memory_grow_bytes(category, new_bytes - old_bytes);
+    } else {
+        nlink_memory_credit_bytes(category, old_bytes - new_bytes);
     }
-    
-    return comp;
+    return grown;
 }
 
-/**
- * Isomorphic reduction: Find canonical form of component
- * Implements consciousness-preserving state minimization
- */
-nlink_component_t* nlink_find_canonical_form(nlink_component_t* comp, 
-                                           nlink_component_t** component_universe,
-                                           size_t universe_size) {
-    if (comp->is_canonical) {
-        return comp; // Already in canonical form
+char* nlink_strdup(nlink_memory_category_t category, const char* text) {
+    char* copy = strdup(text);
+    nlink_memory_charge(category, copy);
+    return copy;
+}
+
+void nlink_free(nlink_memory_category_t category, void* ptr) {
+    nlink_memory_credit(category, ptr);
+    free(ptr);
+}
+
+void nlink_memory_stats(nlink_memory_stats_t* stats) {
+    stats->live_bytes = 0;
+    for (int i = 0; i < NLINK_MEM_CATEGORY_COUNT; i++) {
+        stats->categories[i].live_bytes = atomic_load(&nlink_memory_counters[i].live_bytes);
+        stats->categories[i].peak_bytes = atomic_load(&nlink_memory_counters[i].peak_bytes);
+        stats->categories[i].allocations = atomic_load(&nlink_memory_counters[i].allocations);
+        stats->live_bytes += stats->categories[i].live_bytes;
     }
+}
+
+void nlink_memory_report(const char* phase) {
+    nlink_memory_stats_t stats;
+    nlink_memory_stats(&stats);
     
-    // Check for existing isomorphic components
-    for (size_t i = 0; i < universe_size; i++) {
-        nlink_component_t* candidate = component_universe[i];
-        
-        if (candidate->is_canonical && 
-            nlink_components_isomorphic(comp, candidate)) {
-            
-            // Preserve symbolic residues during reduction
-            nlink_merge_residues(candidate, comp);
-            
-            comp->canonical_form = candidate;
-            candidate->qa_metrics.true_positive_links++;
-            
-            return candidate;
+    printf("MEMORY: after %s - %llu bytes live\n", phase, (unsigned long long)stats.live_bytes);
+    for (int i = 0; i < NLINK_MEM_CATEGORY_COUNT; i++) {
+        printf("MEMORY:   %-10s live %10llu  peak %10llu  allocations %llu\n",
+               nlink_memory_category_names[i],
+               (unsigned long long)stats.categories[i].live_bytes,
+               (unsigned long long)stats.categories[i].peak_bytes,
+               (unsigned long long)stats.categories[i].allocations);
+    }
+}
+
+// === HUGE PAGE BACKING ===
+
+#define NLINK_HUGE_PAGE_SIZE  (2u << 20)
+#define NLINK_LARGE_HEADER    NLINK_CACHE_LINE
+
+typedef enum {
+    NLINK_PAGES_DEFAULT,          // Plain heap
+    NLINK_PAGES_TRANSPARENT,      // 2 MB aligned mappings + madvise(MADV_HUGEPAGE)
+    NLINK_PAGES_EXPLICIT          // MAP_HUGETLB, transparent fallback
+} nlink_page_mode_t;
+
+static nlink_page_mode_t nlink_page_mode = NLINK_PAGES_DEFAULT;
+
+// Mappings handed out per backing - shows how often explicit pages fell back
+static _Atomic uint64_t nlink_huge_mappings_explicit;
+static _Atomic uint64_t nlink_huge_mappings_transparent;
+static _Atomic uint64_t nlink_huge_mappings_fallback;
+
+void nlink_set_page_mode(nlink_page_mode_t mode) {
+    nlink_page_mode = mode;
+}
+
+// Sits in front of every large allocation so free needs no size or mode
+typedef struct {
+    size_t bytes;                 // Requested bytes
+    size_t mapped;                // Mapping length, 0 when heap-backed
+} nlink_large_header_t;
+
+static void* nlink_huge_map(size_t length) {
+    if (nlink_page_mode == NLINK_PAGES_EXPLICIT) {
+        void* map = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (map != MAP_FAILED) {
+            atomic_fetch_add_explicit(&nlink_huge_mappings_explicit, 1, memory_order_relaxed);
+            return map;
         }
     }
     
-    // This component becomes the canonical form for its equivalence class
-    comp->is_canonical = true;
-    comp->canonical_form = comp;
+    // Over-map, then trim to a 2 MB boundary so THP can back every page
+    size_t padded = length + NLINK_HUGE_PAGE_SIZE;
+    char* map = mmap(NULL, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) return NULL;
     
-    return comp;
+    char* aligned = (char*)(((uintptr_t)map + NLINK_HUGE_PAGE_SIZE - 1) &
+                            ~(uintptr_t)(NLINK_HUGE_PAGE_SIZE - 1));
+    if (aligned > map) munmap(map, aligned - map);
+    if (map + padded > aligned + length) munmap(aligned + length, map + padded - (aligned + length));
+    
+    if (madvise(aligned, length, MADV_HUGEPAGE) == 0) {
+        atomic_fetch_add_explicit(&nlink_huge_mappings_transparent, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&nlink_huge_mappings_fallback, 1, memory_order_relaxed);
+    }
+    return aligned;
 }
 
 /**
- * Component isomorphism check - structural + semantic equivalence
- * Preserves consciousness boundaries through cultural validation
+ * Zeroed allocation for big tables - huge-page backed when a page mode is set
+ * Allocations under half a huge page stay on the heap either way.
  */
-bool nlink_components_isomorphic(nlink_component_t* a, nlink_component_t* b) {
-    // Phase compatibility check
-    if (a->phase != b->phase) {
-        return false;
-    }
+void* nlink_large_alloc(nlink_memory_category_t category, size_t bytes) {
+    size_t total = bytes + NLINK_LARGE_HEADER;
+    nlink_large_header_t* header;
     
-    // Edge structure isomorphism
-    if (a->edge_count != b->edge_count) {
-        return false;
+    if (nlink_page_mode != NLINK_PAGES_DEFAULT && total >= NLINK_HUGE_PAGE_SIZE / 2) {
+        size_t length = (total + NLINK_HUGE_PAGE_SIZE - 1) & ~(size_t)(NLINK_HUGE_PAGE_SIZE - 1);
+        header = nlink_huge_map(length);
+        if (!header) return NULL;
+        header->mapped = length;
+        nlink_memory_charge_bytes(category, length);
+    } else {
+        header = nlink_calloc(category, 1, total);
+        if (!header) return NULL;
+        header->mapped = 0;
     }
     
-    // Semantic weight preservation within epsilon threshold
-    const float CONSCIOUSNESS_EPSILON = 0.001f;
+    header->bytes = bytes;
+    return (char*)header + NLINK_LARGE_HEADER;
+}
+
+void nlink_large_free(nlink_memory_category_t category, void* ptr) {
+    if (!ptr) return;
+    nlink_large_header_t* header = (nlink_large_header_t*)((char*)ptr - NLINK_LARGE_HEADER);
     
-    for (size_t i = 0; i < a->edge_count; i++) {
-        float weight_diff = fabsf(a->edges[i].semantic_weight - 
-                                b->edges[i].semantic_weight);
-        
-        if (weight_diff > CONSCIOUSNESS_EPSILON) {
-            a->qa_metrics.false_positive_links++;
-            return false;
-        }
+    if (header->mapped) {
+        nlink_memory_credit_bytes(category, header->mapped);
+        munmap(header, header->mapped);
+    } else {
+        nlink_free(category, header);
     }
+}
+
+// Grown tables are zero-filled past the old contents
+void* nlink_large_realloc(nlink_memory_category_t category, void* ptr, size_t bytes) {
+    void* grown = nlink_large_alloc(category, bytes);
+    if (!grown || !ptr) return grown;
     
-    // Symbolic residue compatibility
-    return nlink_residues_compatible(a->residues, a->residue_count,
-                                   b->residues, b->residue_count);
+    const nlink_large_header_t* header =
+        (const nlink_large_header_t*)((char*)ptr - NLINK_LARGE_HEADER);
+    memcpy(grown, ptr, header->bytes < bytes ? header->bytes : bytes);
+    nlink_large_free(category, ptr);
+    return grown;
 }
 
-/**
- * Indirect linking resolution through consciousness DAG traversal
- * Implements witnessing transformation (preserves original state)
- */
-uint32_t nlink_resolve_indirect_link(nlink_component_t* source,
-                                   const char* symbolic_target,
-                                   nlink_component_t** component_registry,
-                                   size_t registry_size) {
+// === CONSCIOUSNESS EVENT RING ===
+
+static inline size_t nlink_event_ring_bytes(uint32_t capacity) {
+    size_t bytes = sizeof(nlink_event_ring_t) + capacity * sizeof(nlink_event_slot_t);
+    return (bytes + NLINK_CACHE_LINE - 1) & ~(size_t)(NLINK_CACHE_LINE - 1);
+}
+
+nlink_event_ring_t* nlink_event_ring_create(uint32_t capacity, bool multi_producer) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return NULL;
     
-    // Transition to witness phase for consciousness preservation
-    nlink_component_phase_t original_phase = source->phase;
-    source->phase = NLINK_COMPONENT_WITNESS;
+    nlink_event_ring_t* ring = nlink_aligned_alloc(NLINK_MEM_EVENTS, NLINK_CACHE_LINE, nlink_event_ring_bytes(capacity));
+    if (!ring) return NULL;
     
-    // Search through symbolic residues for target anchor
-    for (size_t i = 0; i < registry_size; i++) {
-        nlink_component_t* candidate = component_registry[i];
-        
-        for (size_t j = 0; j < candidate->residue_count; j++) {
-            if (strcmp(candidate->residues[j].perceptual_anchor, 
-                      symbolic_target) == 0) {
-                
-                // Activate residue if activation function exists
-                if (candidate->residues[j].activation_fn) {
-                    float activation = candidate->residues[j].activation_fn(
-                        candidate->residues[j].contextual_frame);
-                    
-                    if (activation > 0.5f) { // Activation threshold
-                        // Create indirect link with consciousness preservation
-                        nlink_create_indirect_edge(source, candidate, activation);
-                        
-                        // Restore original phase (witnessing complete)
-                        source->phase = original_phase;
-                        source->qa_metrics.true_positive_links++;
-                        
-                        return candidate->id;
-                    }
-                }
-            }
-        }
+    memset(ring, 0, nlink_event_ring_bytes(capacity));
+    atomic_init(&ring->head, 0);
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    ring->multi_producer = multi_producer;
+    for (uint32_t i = 0; i < capacity; i++) {
+        atomic_init(&ring->slots[i].stamp, 0);
     }
     
-    // Link resolution failed - no false positives
-    source->phase = original_phase;
-    source->qa_metrics.true_negative_skips++;
-    
-    return 0; // No link resolved
+    return ring;
 }
 
 /**
- * Create indirect edge with semantic weight calculation
- * Implements EATV temporal continuity principles
+ * Append one event - overwrites the oldest once the ring is full
+ * Single producer: wait-free, no read-modify-write on the cursor.
+ * Multi producer: one fetch_add claims the slot (lock-free MPSC).
  */
-void nlink_create_indirect_edge(nlink_component_t* source,
-                               nlink_component_t* target,
-                               float semantic_activation) {
-    
-    // Expand edge array if needed
-    source->edges = realloc(source->edges, 
-                           (source->edge_count + 1) * sizeof(nlink_invocation_edge_t));
-    
-    nlink_invocation_edge_t* edge = &source->edges[source->edge_count];
+static inline void nlink_event_ring_append(nlink_event_ring_t* ring,
+                                           const nlink_consciousness_event_t* event) {
+    uint64_t pos;
+    if (ring->multi_producer) {
+        pos = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    } else {
+        pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    }
     
-    edge->symbol_id = source->edge_count;
-    edge->caller_id = source->id;
-    edge->callee_id = target->id;
-    edge->invocation_type = INDIRECT;
-    edge->semantic_weight = semantic_activation;
+    nlink_event_slot_t* slot = &ring->slots[pos & ring->mask];
+    uint32_t published = (uint32_t)(2 * (pos + 1));
     
-    source->edge_count++;
+    atomic_store_explicit(&slot->stamp, published - 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->event = *event;
+    atomic_store_explicit(&slot->stamp, published, memory_order_release);
     
-    // Update both components' consciousness buffers
-    nlink_update_consciousness_buffer(source, target, semantic_activation);
+    if (!ring->multi_producer) {
+        atomic_store_explicit(&ring->head, pos + 1, memory_order_release);
+    }
 }
 
 /**
- * Consciousness buffer update - preserves experiential continuity
- * Critical for EATV compliance and phenomenological integrity
+ * Copy retained events oldest-first into out[]
+ * Slots being rewritten or already lapped by producers are skipped.
  */
-void nlink_update_consciousness_buffer(nlink_component_t* source,
-                                     nlink_component_t* target,
-                                     float semantic_weight) {
+size_t nlink_event_ring_snapshot(nlink_event_ring_t* ring,
+                                 nlink_consciousness_event_t* out,
+                                 size_t max_events) {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t start = head > ring->capacity ? head - ring->capacity : 0;
+    size_t count = 0;
     
-    // Store linking event as experiential data
-    typedef struct {
-        uint32_t timestamp;
-        uint32_t source_id;
-        uint32_t target_id;
-        float semantic_continuity;
-        char event_type[16];
-    } consciousness_event_t;
-    
-    consciousness_event_t* event = (consciousness_event_t*)source->consciousness_buffer;
+    for (uint64_t pos = start; pos < head && count < max_events; pos++) {
+        nlink_event_slot_t* slot = &ring->slots[pos & ring->mask];
+        uint32_t expected = (uint32_t)(2 * (pos + 1));
+        
+        if (atomic_load_explicit(&slot->stamp, memory_order_acquire) != expected) continue;
+        nlink_consciousness_event_t event = slot->event;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->stamp, memory_order_relaxed) != expected) continue;
+        
+        out[count++] = event;
+    }
     
-    // Simplified: Store in first available slot
-    // Production version would implement circular buffer with temporal ordering
-    event->timestamp = nlink_get_temporal_coordinate();
-    event->source_id = source->id;
-    event->target_id = target->id;
-    event->semantic_continuity = semantic_weight;
-    strcpy(event->event_type, "INDIRECT_LINK");
+    return count;
 }
 
 /**
- * Residue merging during isomorphic reduction
- * Preserves all symbolic anchors from equivalent components
+ * Allow edges from several linking threads to land in one component's ring
+ * Must be set before the component is shared between threads.
  */
-void nlink_merge_residues(nlink_component_t* canonical, nlink_component_t* reducible) {
-    size_t new_count = canonical->residue_count + reducible->residue_count;
+void nlink_component_set_concurrent(nlink_component_t* comp, bool concurrent) {
+    comp->concurrent_linking = concurrent;
     
-    canonical->residues = realloc(canonical->residues,
-                                new_count * sizeof(nlink_symbolic_residue_t));
-    
-    // Copy residues from reducible component
-    for (size_t i = 0; i < reducible->residue_count; i++) {
-        size_t target_idx = canonical->residue_count + i;
-        canonical->residues[target_idx] = reducible->residues[i];
-        
-        // Deep copy perceptual anchor
-        canonical->residues[target_idx].perceptual_anchor = 
-            strdup(reducible->residues[i].perceptual_anchor);
+    nlink_event_ring_t* ring = atomic_load_explicit(&comp->consciousness_buffer,
+                                                    memory_order_acquire);
+    if (ring) {
+        ring->multi_producer = concurrent;
     }
-    
-    canonical->residue_count = new_count;
 }
 
 /**
- * Component cleanup with consciousness preservation verification
+ * Lazy event storage - most components never link anything, so the
+ * ring is only allocated by the first event. Racing producers publish
+ * through a CAS; the loser frees its ring and adopts the winner's.
  */
-void nlink_component_destroy(nlink_component_t* comp) {
-    if (!comp) return;
+static nlink_event_ring_t* nlink_component_event_ring(nlink_component_t* comp) {
+    nlink_event_ring_t* ring = atomic_load_explicit(&comp->consciousness_buffer,
+                                                    memory_order_acquire);
+    if (ring) return ring;
     
-    // Verify no consciousness data is lost
-    if (comp->consciousness_buffer) {
-        // In production: serialize to persistence layer
-        free(comp->consciousness_buffer);
-    }
+    ring = nlink_event_ring_create(NLINK_EVENT_RING_CAPACITY, comp->concurrent_linking);
+    if (!ring) return NULL;
     
-    // Clean up residues
-    for (size_t i = 0; i < comp->residue_count; i++) {
-        free(comp->residues[i].perceptual_anchor);
+    nlink_event_ring_t* expected = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&comp->consciousness_buffer, &expected, ring,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        nlink_free(NLINK_MEM_EVENTS, ring);
+        return expected;
     }
-    free(comp->residues);
-    
-    free(comp->edges);
-    free(comp);
+    return ring;
 }
 
-// === UTILITY FUNCTIONS ===
+// === EVENT JOURNAL ===
 
-uint32_t nlink_get_temporal_coordinate(void) {
-    // Simplified temporal coordinate - production would use high-res timestamp
-    return (uint32_t)time(NULL);
-}
+#define NLINK_JOURNAL_MAGIC       "NLKJ"
+#define NLINK_JOURNAL_VERSION     3      // 3: wall-clock timestamps
+#define NLINK_JOURNAL_EXTENT      (16u * 1024 * 1024)   // File growth step
+#define NLINK_JOURNAL_SYNC_BYTES  (1u * 1024 * 1024)    // msync batching threshold
 
-bool nlink_residues_compatible(nlink_symbolic_residue_t* a, size_t a_count,
-                              nlink_symbolic_residue_t* b, size_t b_count) {
-    // Simplified compatibility check
-    // Production version would implement semantic similarity analysis
-    return true; // Assume compatible for POC
-}
+// On-disk header - records follow at NLINK_JOURNAL_HEADER_SIZE
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t reserved;
+    uint64_t record_count;        // Committed records
+} nlink_journal_header_t;
 
-// === PERSONA DEVELOPMENT INTEGRATION ===
+#define NLINK_JOURNAL_HEADER_SIZE 64
+#define NLINK_JOURNAL_INDEX_BLOCK 256          // Records per sparse time-index block
+
+typedef struct {
+    uint64_t min_timestamp;
+    uint64_t max_timestamp;
+    uint64_t prefix_max;          // max_timestamp over blocks [0, i]
+    uint64_t suffix_min;          // min_timestamp over blocks [i, end)
+    uint64_t component_bloom;     // Source/target ids seen in the block
+} nlink_journal_block_t;
 
 /**
- * Consciousness-aware component discovery with persona scaffolding
- * Integrates with the Foundation/Aspiration track system
+ * Append-only, memory-mapped link history
+ * Appends are memcpy into the mapping; the file grows in large extents
+ * and dirty ranges are msync'd in batches instead of per event.
  */
-void nlink_persona_aware_discovery(const char* foundation_anchor, 
-                                  const char* aspiration_anchor) {
+struct nlink_journal {
+    int fd;
+    uint8_t* map;
+    size_t mapped_bytes;          // File size == mapping size
+    uint64_t record_count;
+    size_t synced_bytes;          // Prefix already handed to msync
+    uint64_t max_sequence;        // Highest sequence journaled - next runs continue after it
+    
+    // In-memory time index, rebuilt on open and extended on append
+    nlink_journal_block_t* blocks;
+    size_t block_count;
+    size_t block_capacity;
+};
+
+static inline nlink_journal_header_t* nlink_journal_header(nlink_journal_t* journal) {
+    return (nlink_journal_header_t*)journal->map;
+}
+
+static inline size_t nlink_journal_used_bytes(const nlink_journal_t* journal) {
+    return NLINK_JOURNAL_HEADER_SIZE +
+           journal->record_count * sizeof(nlink_consciousness_event_t);
+}
+
+/**
+ * Extend the file and the mapping by whole extents
+ */
+static int nlink_journal_grow(nlink_journal_t* journal, size_t required_bytes) {
+    size_t new_size = journal->mapped_bytes;
+    while (new_size < required_bytes) {
+        new_size += NLINK_JOURNAL_EXTENT;
+    }
+    
+    if (ftruncate(journal->fd, (off_t)new_size) != 0) {
+        return -1;
+    }
+    
+    void* map = mremap(journal->map, journal->mapped_bytes, new_size, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    
+    journal->map = map;
+    journal->mapped_bytes = new_size;
+    return 0;
+}
+
+/**
+ * Sparse time index - one summary per NLINK_JOURNAL_INDEX_BLOCK records
+ * Journal order is only nearly sorted by time (components flush whole
+ * histories at once), so each block carries its own [min, max] plus a
+ * running prefix max and suffix min. Both are monotonic, which makes
+ * the first and last candidate blocks of a time range binary-searchable.
+ */
+static inline uint64_t nlink_component_bloom_bit(uint32_t component_id) {
+    return 1ULL << ((component_id * 0x9E3779B1u) >> 26);
+}
+
+static int nlink_journal_index_records(nlink_journal_t* journal,
+                                       uint64_t first_record, uint64_t count) {
+    const nlink_consciousness_event_t* records =
+        (const nlink_consciousness_event_t*)(journal->map + NLINK_JOURNAL_HEADER_SIZE);
+    
+    for (uint64_t r = first_record; r < first_record + count; r++) {
+        size_t block = (size_t)(r / NLINK_JOURNAL_INDEX_BLOCK);
+        uint64_t ts = records[r].timestamp;
+        if (records[r].sequence > journal->max_sequence) journal->max_sequence = records[r].sequence;
+        
+        if (block == journal->block_count) {
+            if (journal->block_count == journal->block_capacity) {
+                size_t capacity = journal->block_capacity ? journal->block_capacity * 2 : 64;
+                nlink_journal_block_t* blocks = nlink_realloc(NLINK_MEM_INDICES, journal->blocks,
+                                                        capacity * sizeof(nlink_journal_block_t));
+                if (!blocks) return -1;
+                journal->blocks = blocks;
+                journal->block_capacity = capacity;
+            }
+            
+            uint64_t prefix = block ? journal->blocks[block - 1].prefix_max : 0;
+            journal->blocks[block] = (nlink_journal_block_t){
+                .min_timestamp = ts,
+                .max_timestamp = ts,
+                .prefix_max = prefix > ts ? prefix : ts,
+                .suffix_min = ts
+            };
+            journal->block_count++;
+        }
+        
+        nlink_journal_block_t* b = &journal->blocks[block];
+        if (ts < b->min_timestamp) b->min_timestamp = ts;
+        if (ts > b->max_timestamp) b->max_timestamp = ts;
+        if (ts > b->prefix_max) b->prefix_max = ts;
+        b->component_bloom |= nlink_component_bloom_bit(records[r].source_id) |
+                              nlink_component_bloom_bit(records[r].target_id);
+        
+        // Propagate the suffix min backwards - stops at once for sorted input
+        uint64_t suffix = b->min_timestamp;
+        b->suffix_min = suffix;
+        for (size_t i = block; i-- > 0 && journal->blocks[i].suffix_min > suffix; ) {
+            journal->blocks[i].suffix_min = suffix;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * Open (or create) a journal and map it
+ * Existing journals keep their history; new records append after it.
+ */
+nlink_journal_t* nlink_journal_open(const char* path) {
+    nlink_journal_t* journal = nlink_calloc(NLINK_MEM_MISC, 1, sizeof(nlink_journal_t));
+    if (!journal) return NULL;
+    
+    journal->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (journal->fd < 0) {
+        nlink_free(NLINK_MEM_MISC, journal);
+        return NULL;
+    }
+    
+    struct stat st;
+    if (fstat(journal->fd, &st) != 0) goto fail;
+    
+    bool fresh = st.st_size == 0;
+    size_t size = fresh ? NLINK_JOURNAL_EXTENT : (size_t)st.st_size;
+    
+    if (fresh && ftruncate(journal->fd, (off_t)size) != 0) goto fail;
+    if (!fresh && size < NLINK_JOURNAL_HEADER_SIZE) goto fail;
+    
+    journal->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, journal->fd, 0);
+    if (journal->map == MAP_FAILED) {
+        journal->map = NULL;
+        goto fail;
+    }
+    journal->mapped_bytes = size;
+    
+    nlink_journal_header_t* header = nlink_journal_header(journal);
+    if (fresh) {
+        memcpy(header->magic, NLINK_JOURNAL_MAGIC, 4);
+        header->version = NLINK_JOURNAL_VERSION;
+        header->record_size = sizeof(nlink_consciousness_event_t);
+        header->record_count = 0;
+    } else if (memcmp(header->magic, NLINK_JOURNAL_MAGIC, 4) != 0 ||
+               header->version != NLINK_JOURNAL_VERSION ||
+               header->record_size != sizeof(nlink_consciousness_event_t)) {
+        goto fail;
+    }
+    
+    // A crash can cut the file short of the committed count - keep the whole records left
+    uint64_t stored = (size - NLINK_JOURNAL_HEADER_SIZE) / sizeof(nlink_consciousness_event_t);
+    if (header->record_count > stored) header->record_count = stored;
+    journal->record_count = header->record_count;
+    journal->synced_bytes = nlink_journal_used_bytes(journal);
+    
+    // One pass over existing timestamps rebuilds the time index
+    if (nlink_journal_index_records(journal, 0, journal->record_count) != 0) goto fail;
+    
+    return journal;
+    
+fail:
+    nlink_free(NLINK_MEM_INDICES, journal->blocks);
+    if (journal->map) munmap(journal->map, journal->mapped_bytes);
+    close(journal->fd);
+    nlink_free(NLINK_MEM_MISC, journal);
+    return NULL;
+}
+
+/**
+ * Append a batch of events - one memcpy, no syscall unless an extent
+ * boundary is crossed or the unsynced range passes the batch threshold
+ */
+int nlink_journal_append(nlink_journal_t* journal,
+                         const nlink_consciousness_event_t* events, size_t count) {
+    if (count == 0) return 0;
+    
+    size_t offset = nlink_journal_used_bytes(journal);
+    size_t bytes = count * sizeof(nlink_consciousness_event_t);
+    
+    if (offset + bytes > journal->mapped_bytes &&
+        nlink_journal_grow(journal, offset + bytes) != 0) {
+        return -1;
+    }
+    
+    memcpy(journal->map + offset, events, bytes);
+    if (nlink_journal_index_records(journal, journal->record_count, count) != 0) {
+        return -1;
+    }
+    journal->record_count += count;
+    nlink_journal_header(journal)->record_count = journal->record_count;
+    
+    size_t used = offset + bytes;
+    if (used - journal->synced_bytes >= NLINK_JOURNAL_SYNC_BYTES) {
+        // Kick writeback for the dirty range; msync wants page alignment
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t from = journal->synced_bytes & ~(page - 1);
+        msync(journal->map + from, used - from, MS_ASYNC);
+        journal->synced_bytes = used;
+    }
+    
+    return 0;
+}
+
+/**
+ * Durable flush of everything appended so far
+ */
+int nlink_journal_sync(nlink_journal_t* journal) {
+    size_t used = nlink_journal_used_bytes(journal);
+    if (msync(journal->map, used, MS_SYNC) != 0) {
+        return -1;
+    }
+    journal->synced_bytes = used;
+    return 0;
+}
+
+/**
+ * Sync, trim the trailing extent slack and unmap
+ */
+int nlink_journal_close(nlink_journal_t* journal) {
+    if (!journal) return 0;
+    
+    int result = nlink_journal_sync(journal);
+    size_t used = nlink_journal_used_bytes(journal);
+    
+    munmap(journal->map, journal->mapped_bytes);
+    nlink_free(NLINK_MEM_INDICES, journal->blocks);
+    if (ftruncate(journal->fd, (off_t)used) != 0) {
+        result = -1;
+    }
+    if (close(journal->fd) != 0) {
+        result = -1;
+    }
+    nlink_free(NLINK_MEM_MISC, journal);
+    return result;
+}
+
+// === LINK TRACING ===
+
+/** Trace slice categories
+ * Emitted as Chrome Trace Event "cat" fields for filtering in Perfetto */
+typedef enum {
+    NLINK_TRACE_PIPELINE,         // Setup, discovery, manifest loading, resolution, reduction, export
+    NLINK_TRACE_RESOLVE,          // Individual resolve calls (opt-in)
+    NLINK_TRACE_COMPONENT_PHASE,  // Component phase transitions (WITNESS etc.)
+    NLINK_TRACE_FLUSH             // Background journal flushes
+} nlink_trace_category_t;
+
+#define NLINK_TRACE_NO_COMPONENT UINT32_MAX
+
+typedef struct {
+    const char* name;             // Static string - never copied
+    uint64_t start;               // Temporal coordinate (ns)
+    uint64_t duration;
+    uint32_t component_id;
+    uint32_t category;
+} nlink_trace_slice_t;
+
+// Per-thread slice buffer - only its owning thread appends
+typedef struct nlink_trace_buffer {
+    nlink_trace_slice_t* slices;
+    size_t count;
+    size_t capacity;
+    uint32_t thread_id;
+    struct nlink_trace_buffer* next;
+} nlink_trace_buffer_t;
+
+static struct {
+    _Atomic bool enabled;
+    bool resolve_calls;
+    _Atomic uint64_t generation;  // Distinguishes sessions in thread-local caches
+    uint64_t epoch;               // Session start - trace timestamps are relative to it
+    pthread_mutex_t lock;         // Guards the buffer list
+    nlink_trace_buffer_t* buffers;
+    uint32_t next_thread_id;
+} nlink_tracer = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+static _Thread_local uint64_t nlink_tls_trace_generation = 0;
+static _Thread_local nlink_trace_buffer_t* nlink_tls_trace_buffer = NULL;
+
+/**
+ * Start a trace session
+ * Resolve calls are traced individually only when requested - they dominate volume.
+ */
+void nlink_trace_start(bool resolve_calls) {
+    pthread_mutex_lock(&nlink_tracer.lock);
+    atomic_fetch_add(&nlink_tracer.generation, 1);
+    nlink_tracer.resolve_calls = resolve_calls;
+    nlink_tracer.epoch = nlink_get_temporal_coordinate();
+    pthread_mutex_unlock(&nlink_tracer.lock);
+    atomic_store_explicit(&nlink_tracer.enabled, true, memory_order_release);
+}
+
+static inline bool nlink_trace_enabled(nlink_trace_category_t category) {
+    if (!atomic_load_explicit(&nlink_tracer.enabled, memory_order_relaxed)) return false;
+    return category != NLINK_TRACE_RESOLVE || nlink_tracer.resolve_calls;
+}
+
+/**
+ * Slice start timestamp - 0 when the category is not being traced
+ */
+static inline uint64_t nlink_trace_begin(nlink_trace_category_t category) {
+    return nlink_trace_enabled(category) ? nlink_get_temporal_coordinate() : 0;
+}
+
+static nlink_trace_buffer_t* nlink_trace_thread_buffer(void) {
+    uint64_t generation = atomic_load_explicit(&nlink_tracer.generation, memory_order_acquire);
+    if (nlink_tls_trace_generation == generation) {
+        return nlink_tls_trace_buffer;
+    }
+    
+    nlink_trace_buffer_t* buffer = nlink_calloc(NLINK_MEM_MISC, 1, sizeof(nlink_trace_buffer_t));
+    if (!buffer) return NULL;
+    
+    pthread_mutex_lock(&nlink_tracer.lock);
+    buffer->thread_id = ++nlink_tracer.next_thread_id;
+    buffer->next = nlink_tracer.buffers;
+    nlink_tracer.buffers = buffer;
+    nlink_tls_trace_generation = generation;
+    pthread_mutex_unlock(&nlink_tracer.lock);
+    
+    nlink_tls_trace_buffer = buffer;
+    return buffer;
+}
+
+/**
+ * Close a slice opened with nlink_trace_begin - appends to this thread's buffer
+ */
+static void nlink_trace_end(nlink_trace_category_t category, const char* name,
+                            uint32_t component_id, uint64_t start) {
+    if (start == 0 || !nlink_trace_enabled(category)) return;
+    uint64_t end = nlink_get_temporal_coordinate();
+    
+    nlink_trace_buffer_t* buffer = nlink_trace_thread_buffer();
+    if (!buffer) return;
+    
+    if (buffer->count == buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 1024;
+        nlink_trace_slice_t* slices = nlink_realloc(NLINK_MEM_MISC, buffer->slices, capacity * sizeof(*slices));
+        if (!slices) return;
+        buffer->slices = slices;
+        buffer->capacity = capacity;
+    }
+    
+    buffer->slices[buffer->count++] = (nlink_trace_slice_t){
+        .name = name,
+        .start = start,
+        .duration = end - start,
+        .component_id = component_id,
+        .category = category
+    };
+}
+
+static const char* nlink_trace_category_name(uint32_t category) {
+    switch (category) {
+        case NLINK_TRACE_PIPELINE:        return "pipeline";
+        case NLINK_TRACE_RESOLVE:         return "resolve";
+        case NLINK_TRACE_COMPONENT_PHASE: return "component_phase";
+        case NLINK_TRACE_FLUSH:           return "flush";
+        default:                          return "unknown";
+    }
+}
+
+/**
+ * Stop tracing and write the session as Chrome Trace Event JSON
+ * Call once linking threads are quiescent; buffers are released afterwards.
+ */
+int nlink_trace_stop(const char* path) {
+    atomic_store_explicit(&nlink_tracer.enabled, false, memory_order_release);
+    
+    pthread_mutex_lock(&nlink_tracer.lock);
+    nlink_trace_buffer_t* buffers = nlink_tracer.buffers;
+    nlink_tracer.buffers = NULL;
+    nlink_tracer.next_thread_id = 0;
+    atomic_fetch_add(&nlink_tracer.generation, 1);
+    pthread_mutex_unlock(&nlink_tracer.lock);
+    
+    FILE* out = path ? fopen(path, "w") : NULL;
+    int result = (path && !out) ? -1 : 0;
+    
+    if (out) {
+        static char out_buffer[65536];
+        setvbuf(out, out_buffer, _IOFBF, sizeof(out_buffer));
+        
+        fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                     "\"args\":{\"name\":\"nlink-indirect\"}}");
+        
+        for (nlink_trace_buffer_t* buffer = buffers; buffer; buffer = buffer->next) {
+            for (size_t i = 0; i < buffer->count; i++) {
+                const nlink_trace_slice_t* slice = &buffer->slices[i];
+                uint64_t start = slice->start - nlink_tracer.epoch;
+                
+                // Complete ("X") events; timestamps are microseconds
+                fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                             "\"tid\":%u,\"ts\":%llu.%03u,\"dur\":%llu.%03u",
+                        slice->name, nlink_trace_category_name(slice->category),
+                        buffer->thread_id,
+                        (unsigned long long)(start / 1000), (unsigned)(start % 1000),
+                        (unsigned long long)(slice->duration / 1000),
+                        (unsigned)(slice->duration % 1000));
+                if (slice->component_id != NLINK_TRACE_NO_COMPONENT) {
+                    fprintf(out, ",\"args\":{\"component\":%u}", slice->component_id);
+                }
+                fputc('}', out);
+            }
+        }
+        
+        fprintf(out, "\n]}\n");
+        if (fclose(out) != 0) result = -1;
+    }
+    
+    while (buffers) {
+        nlink_trace_buffer_t* next = buffers->next;
+        nlink_free(NLINK_MEM_MISC, buffers->slices);
+        nlink_free(NLINK_MEM_MISC, buffers);
+        buffers = next;
+    }
+    
+    return result;
+}
+
+// === REGISTRY ARENA ===
+
+#define NLINK_ARENA_REGION_SIZE (1u << 20)   // Bytes per bump region
+
+// Offset of the next free byte at align, measured on the address - data itself is only 16-aligned
+static inline size_t nlink_arena_offset(const nlink_arena_region_t* region, size_t align) {
+    uintptr_t base = (uintptr_t)region->data;
+    return ((base + region->used + align - 1) & ~(uintptr_t)(align - 1)) - base;
+}
+
+/**
+ * Bump-allocate from the current region, opening a new one when it is full
+ * Oversized requests get a dedicated region behind the current one.
+ * align must be a power of two; any size is honoured, in fresh regions too.
+ */
+void* nlink_arena_alloc(nlink_arena_t* arena, size_t size, size_t align) {
+    nlink_arena_region_t* region = arena->regions;
+    if (region) {
+        size_t offset = nlink_arena_offset(region, align);
+        if (offset + size <= region->capacity) {
+            region->used = offset + size;
+            arena->bytes_used += size;
+            return region->data + offset;
+        }
+    }
+    
+    // Huge-page regions fill exactly one 2 MB page including both headers
+    size_t region_size = nlink_page_mode == NLINK_PAGES_DEFAULT
+                       ? NLINK_ARENA_REGION_SIZE
+                       : NLINK_HUGE_PAGE_SIZE - NLINK_LARGE_HEADER - sizeof(nlink_arena_region_t);
+    bool oversized = size + align > region_size / 4;
+    size_t capacity = oversized ? size + align : region_size;
+    nlink_arena_region_t* fresh = nlink_large_alloc(NLINK_MEM_COMPONENTS,
+                                                    sizeof(nlink_arena_region_t) + capacity);
+    if (!fresh) return NULL;
+    fresh->capacity = capacity;
+    size_t offset = nlink_arena_offset(fresh, align);
+    fresh->used = offset + size;
+    
+    if (oversized && region) {
+        fresh->next = region->next;
+        region->next = fresh;
+    } else {
+        fresh->next = region;
+        arena->regions = fresh;
+    }
+    arena->region_count++;
+    arena->bytes_reserved += capacity;
+    arena->bytes_used += size;
+    return fresh->data + offset;
+}
+
+// Copies length bytes and terminates them - text need not be terminated
+char* nlink_arena_strndup(nlink_arena_t* arena, const char* text, size_t length) {
+    char* copy = nlink_arena_alloc(arena, length + 1, 1);
+    if (copy) {
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+char* nlink_arena_strdup(nlink_arena_t* arena, const char* text) {
+    return nlink_arena_strndup(arena, text, strlen(text));
+}
+
+/**
+ * Release every region at once - O(regions), not O(allocations)
+ */
+void nlink_arena_release(nlink_arena_t* arena) {
+    nlink_arena_region_t* region = arena->regions;
+    while (region) {
+        nlink_arena_region_t* next = region->next;
+        nlink_large_free(NLINK_MEM_COMPONENTS, region);
+        region = next;
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+// === SYMBOLIC ANCHORS ===
+
+static inline bool nlink_anchor_is_inline(const nlink_anchor_t* anchor) {
+    return anchor->length < NLINK_ANCHOR_INLINE_CAPACITY;
+}
+
+static inline const char* nlink_anchor_text(const nlink_anchor_t* anchor) {
+    return nlink_anchor_is_inline(anchor) ? anchor->inline_text : anchor->heap_text;
+}
+
+static inline const char* nlink_residue_anchor(const nlink_symbolic_residue_t* residue) {
+    return nlink_anchor_text(&residue->perceptual_anchor);
+}
+
+static inline uint32_t nlink_anchor_hash(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;    // FNV-1a
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Lookup key for length bytes of text - long text is borrowed, not copied,
+ * so it may point into a mapping without a terminator
+ */
+static inline nlink_anchor_t nlink_anchor_borrow_n(const char* text, size_t length) {
+    nlink_anchor_t key;
+    key.length = (uint32_t)length;
+    key.hash = nlink_anchor_hash(text, length);
+    if (length < NLINK_ANCHOR_INLINE_CAPACITY) {
+        memcpy(key.inline_text, text, length);
+        key.inline_text[length] = '\0';
+    } else {
+        key.heap_text = (char*)text;
+    }
+    return key;
+}
+
+static inline nlink_anchor_t nlink_anchor_borrow(const char* text) {
+    return nlink_anchor_borrow_n(text, strlen(text));
+}
+
+/**
+ * Hash and length reject almost every mismatch inside the residue's cache line
+ */
+static inline bool nlink_anchor_equal(const nlink_anchor_t* a, const nlink_anchor_t* b) {
+    return a->hash == b->hash && a->length == b->length &&
+           memcmp(nlink_anchor_text(a), nlink_anchor_text(b), a->length) == 0;
+}
+
+/**
+ * Store text inline when it fits, otherwise in the arena (or heap without one)
+ */
+int nlink_anchor_set_n(nlink_anchor_t* anchor, const char* text, size_t length,
+                       nlink_arena_t* arena) {
+    *anchor = nlink_anchor_borrow_n(text, length);
+    if (nlink_anchor_is_inline(anchor)) return 0;
+    
+    if (arena) {
+        anchor->heap_text = nlink_arena_strndup(arena, text, length);
+    } else if ((anchor->heap_text = nlink_malloc(NLINK_MEM_ANCHORS, length + 1)) != NULL) {
+        memcpy(anchor->heap_text, text, length);
+        anchor->heap_text[length] = '\0';
+    }
+    return anchor->heap_text ? 0 : -1;
+}
+
+int nlink_anchor_set(nlink_anchor_t* anchor, const char* text, nlink_arena_t* arena) {
+    return nlink_anchor_set_n(anchor, text, strlen(text), arena);
+}
+
+// Heap-owned text only - arena text is released with its registry
+static inline void nlink_anchor_release(nlink_anchor_t* anchor) {
+    if (!nlink_anchor_is_inline(anchor)) {
+        nlink_free(NLINK_MEM_ANCHORS, anchor->heap_text);
+    }
+}
+
+// === SLAB POOLS ===
+
+#define NLINK_SLAB_BYTES     (64 * 1024)
+#define NLINK_SLAB_HEADER    NLINK_CACHE_LINE
+#define NLINK_MAGAZINE_SIZE  32       // Objects cached per thread per pool
+#define NLINK_EDGE_BLOCK     4        // Edges in a component's first (pooled) edge array
+
+typedef enum {
+    NLINK_POOL_COMPONENT,         // nlink_component_t
+    NLINK_POOL_RESIDUE,           // Single-residue arrays
+    NLINK_POOL_EDGE,              // First edge array of NLINK_EDGE_BLOCK edges
+    NLINK_POOL_COUNT
+} nlink_pool_kind_t;
+
+typedef struct nlink_slab {
+    struct nlink_slab* next;      // Objects start at NLINK_SLAB_HEADER
+} nlink_slab_t;
+
+/** Fixed-size object pool
+ * Slabs are carved lazily; freed objects go back to per-thread magazines and
+ * spill into the shared depot, so the lock is taken once per half magazine. */
+typedef struct {
+    const char* name;
+    size_t object_size;
+    nlink_memory_category_t category;
+    pthread_mutex_t lock;         // Guards the depot and slab list
+    void* depot;                  // Free list shared between threads
+    size_t depot_count;
+    nlink_slab_t* slabs;
+    size_t slab_count;
+    char* carve;                  // Uncarved tail of the newest slab
+    char* carve_end;
+    _Atomic size_t objects_live;
+    _Atomic uint64_t depot_transfers;   // Lock acquisitions from magazine traffic
+} nlink_slab_pool_t;
+
+#define NLINK_POOL_OBJECT_SIZE(type) ((sizeof(type) + 7) & ~(size_t)7)
+
+static nlink_slab_pool_t nlink_pools[NLINK_POOL_COUNT] = {
+    [NLINK_POOL_COMPONENT] = { .name = "component",
+                               .object_size = NLINK_POOL_OBJECT_SIZE(nlink_component_t),
+                               .category = NLINK_MEM_COMPONENTS,
+                               .lock = PTHREAD_MUTEX_INITIALIZER },
+    [NLINK_POOL_RESIDUE]   = { .name = "residue",
+                               .object_size = NLINK_POOL_OBJECT_SIZE(nlink_symbolic_residue_t),
+                               .category = NLINK_MEM_RESIDUES,
+                               .lock = PTHREAD_MUTEX_INITIALIZER },
+    [NLINK_POOL_EDGE]      = { .name = "edge",
+                               .object_size = NLINK_EDGE_BLOCK *
+                                              NLINK_POOL_OBJECT_SIZE(nlink_invocation_edge_t),
+                               .category = NLINK_MEM_EDGES,
+                               .lock = PTHREAD_MUTEX_INITIALIZER },
+};
+
+typedef struct {
+    void* objects[NLINK_MAGAZINE_SIZE];
+    uint32_t count;
+} nlink_magazine_t;
+
+static _Thread_local nlink_magazine_t nlink_tls_magazines[NLINK_POOL_COUNT];
+static _Thread_local bool nlink_tls_magazines_registered = false;
+static pthread_key_t nlink_magazine_key;
+static pthread_once_t nlink_magazine_key_once = PTHREAD_ONCE_INIT;
+
+// Move count objects from a magazine into the depot (lock held)
+static void nlink_pool_spill(nlink_slab_pool_t* pool, nlink_magazine_t* magazine, uint32_t count) {
+    while (count-- > 0 && magazine->count > 0) {
+        void* object = magazine->objects[--magazine->count];
+        *(void**)object = pool->depot;
+        pool->depot = object;
+        pool->depot_count++;
+    }
+}
+
+// Thread exit - cached objects return to the depots instead of being stranded
+static void nlink_pool_thread_exit(void* unused) {
+    (void)unused;
+    for (int kind = 0; kind < NLINK_POOL_COUNT; kind++) {
+        nlink_slab_pool_t* pool = &nlink_pools[kind];
+        pthread_mutex_lock(&pool->lock);
+        nlink_pool_spill(pool, &nlink_tls_magazines[kind], NLINK_MAGAZINE_SIZE);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void nlink_magazine_key_create(void) {
+    pthread_key_create(&nlink_magazine_key, nlink_pool_thread_exit);
+}
+
+/**
+ * The calling thread's magazine for a pool
+ * The first touch from a thread - alloc or free - registers the exit hook,
+ * so a thread that only frees still hands its objects back.
+ */
+static inline nlink_magazine_t* nlink_magazine_get(nlink_pool_kind_t kind) {
+    if (__builtin_expect(!nlink_tls_magazines_registered, 0)) {
+        pthread_once(&nlink_magazine_key_once, nlink_magazine_key_create);
+        pthread_setspecific(nlink_magazine_key, nlink_tls_magazines);
+        nlink_tls_magazines_registered = true;
+    }
+    return &nlink_tls_magazines[kind];
+}
+
+/**
+ * Refill half a magazine from the depot, carving fresh slabs as needed
+ */
+static int nlink_pool_refill(nlink_slab_pool_t* pool, nlink_magazine_t* magazine) {
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add_explicit(&pool->depot_transfers, 1, memory_order_relaxed);
+    
+    while (magazine->count < NLINK_MAGAZINE_SIZE / 2) {
+        if (pool->depot) {
+            void* object = pool->depot;
+            pool->depot = *(void**)object;
+            pool->depot_count--;
+            magazine->objects[magazine->count++] = object;
+            continue;
+        }
+        
+        if (pool->carve + pool->object_size > pool->carve_end) {
+            nlink_slab_t* slab = nlink_aligned_alloc(pool->category, NLINK_CACHE_LINE,
+                                                     NLINK_SLAB_BYTES);
+            if (!slab) break;
+            slab->next = pool->slabs;
+            pool->slabs = slab;
+            pool->slab_count++;
+            pool->carve = (char*)slab + NLINK_SLAB_HEADER;
+            pool->carve_end = (char*)slab + NLINK_SLAB_BYTES;
+        }
+        magazine->objects[magazine->count++] = pool->carve;
+        pool->carve += pool->object_size;
+    }
+    
+    pthread_mutex_unlock(&pool->lock);
+    return magazine->count > 0 ? 0 : -1;
+}
+
+void* nlink_pool_alloc(nlink_pool_kind_t kind) {
+    nlink_slab_pool_t* pool = &nlink_pools[kind];
+    nlink_magazine_t* magazine = nlink_magazine_get(kind);
+    
+    if (magazine->count == 0 && nlink_pool_refill(pool, magazine) != 0) return NULL;
+    
+    atomic_fetch_add_explicit(&pool->objects_live, 1, memory_order_relaxed);
+    return magazine->objects[--magazine->count];
+}
+
+void nlink_pool_free(nlink_pool_kind_t kind, void* object) {
+    if (!object) return;
+    nlink_slab_pool_t* pool = &nlink_pools[kind];
+    nlink_magazine_t* magazine = nlink_magazine_get(kind);
+    
+    if (magazine->count == NLINK_MAGAZINE_SIZE) {
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add_explicit(&pool->depot_transfers, 1, memory_order_relaxed);
+        nlink_pool_spill(pool, magazine, NLINK_MAGAZINE_SIZE / 2);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    
+    magazine->objects[magazine->count++] = object;
+    atomic_fetch_sub_explicit(&pool->objects_live, 1, memory_order_relaxed);
+}
+
+typedef struct {
+    const char* name;
+    size_t object_size;
+    size_t slabs;
+    size_t bytes_reserved;
+    size_t objects_capacity;      // Objects the reserved slabs can hold
+    size_t objects_live;
+    double utilization;           // Live objects / capacity
+    double fragmentation;         // Reserved bytes not holding live objects
+    uint64_t depot_transfers;
+} nlink_pool_stats_t;
+
+void nlink_pool_stats(nlink_pool_kind_t kind, nlink_pool_stats_t* stats) {
+    nlink_slab_pool_t* pool = &nlink_pools[kind];
+    
+    pthread_mutex_lock(&pool->lock);
+    stats->name = pool->name;
+    stats->object_size = pool->object_size;
+    stats->slabs = pool->slab_count;
+    stats->depot_transfers = atomic_load(&pool->depot_transfers);
+    pthread_mutex_unlock(&pool->lock);
+    
+    stats->bytes_reserved = stats->slabs * NLINK_SLAB_BYTES;
+    stats->objects_capacity = stats->slabs *
+                              ((NLINK_SLAB_BYTES - NLINK_SLAB_HEADER) / stats->object_size);
+    stats->objects_live = atomic_load(&pool->objects_live);
+    stats->utilization = stats->objects_capacity
+                       ? (double)stats->objects_live / stats->objects_capacity : 0.0;
+    stats->fragmentation = stats->bytes_reserved
+                         ? 1.0 - (double)(stats->objects_live * stats->object_size) /
+                                 stats->bytes_reserved
+                         : 0.0;
+}
+
+void nlink_pool_report(void) {
+    for (int kind = 0; kind < NLINK_POOL_COUNT; kind++) {
+        nlink_pool_stats_t stats;
+        nlink_pool_stats((nlink_pool_kind_t)kind, &stats);
+        printf("SLAB POOL: %-9s %zu B objects, %zu slabs, %zu/%zu live, "
+               "utilization %.1f%%, fragmentation %.1f%%, %llu depot transfers\n",
+               stats.name, stats.object_size, stats.slabs,
+               stats.objects_live, stats.objects_capacity,
+               stats.utilization * 100.0, stats.fragmentation * 100.0,
+               (unsigned long long)stats.depot_transfers);
+    }
+}
+
+// === CORE CONSCIOUSNESS FUNCTIONS ===
+
+/**
+ * Create a component whose anchor is anchor_length bytes of semantic_anchor
+ * (NULL for none) - the text is copied, so it may live in a mapping
+ */
+nlink_component_t* nlink_component_create_n(nlink_arena_t* arena, uint32_t id,
+                                            const char* semantic_anchor, size_t anchor_length) {
+    nlink_component_t* comp;
+    if (arena) {
+        comp = nlink_arena_alloc(arena, sizeof(nlink_component_t), _Alignof(nlink_component_t));
+        if (comp) memset(comp, 0, sizeof(*comp));
+    } else {
+        comp = nlink_pool_alloc(NLINK_POOL_COMPONENT);
+        if (comp) memset(comp, 0, sizeof(*comp));
+    }
+    if (!comp) return NULL;
+    
+    comp->arena = arena;
+    comp->id = id;
+    comp->phase = NLINK_COMPONENT_DORMANT;
+    comp->is_canonical = false;
+    
+    // Consciousness preservation buffer is allocated on first event
+    atomic_init(&comp->consciousness_buffer, NULL);
+    
+    // Create initial symbolic residue for the semantic anchor
+    if (semantic_anchor) {
+        if (arena) {
+            comp->residues = nlink_arena_alloc(arena, sizeof(nlink_symbolic_residue_t),
+                                               _Alignof(nlink_symbolic_residue_t));
+            if (!comp->residues) return NULL;
+            if (nlink_anchor_set_n(&comp->residues[0].perceptual_anchor, semantic_anchor,
+                                   anchor_length, arena) != 0) {
+                return NULL;
+            }
+        } else {
+            comp->residues = nlink_pool_alloc(NLINK_POOL_RESIDUE);
+            if (!comp->residues) {
+                nlink_pool_free(NLINK_POOL_COMPONENT, comp);
+                return NULL;
+            }
+            comp->residues_pooled = true;
+            if (nlink_anchor_set_n(&comp->residues[0].perceptual_anchor, semantic_anchor,
+                                   anchor_length, NULL) != 0) {
+                nlink_pool_free(NLINK_POOL_RESIDUE, comp->residues);
+                nlink_pool_free(NLINK_POOL_COMPONENT, comp);
+                return NULL;
+            }
+        }
+        comp->residue_count = 1;
+        comp->residues[0].contextual_frame = NULL;
+        comp->residues[0].activation_fn = NULL;
+    }
+    
+    return comp;
+}
+
+nlink_component_t* nlink_component_create_in(nlink_arena_t* arena, uint32_t id,
+                                             const char* semantic_anchor) {
+    return nlink_component_create_n(arena, id, semantic_anchor,
+                                    semantic_anchor ? strlen(semantic_anchor) : 0);
+}
+
+/**
+ * Sinphasé-compliant component initialization
+ * Enforces single active phase constraint
+ */
+nlink_component_t* nlink_component_create(uint32_t id, const char* semantic_anchor) {
+    return nlink_component_create_in(NULL, id, semantic_anchor);
+}
+
+/**
+ * Isomorphic reduction: Find canonical form of component
+ * Implements consciousness-preserving state minimization
+ */
+nlink_component_t* nlink_find_canonical_form(nlink_component_t* comp, 
+                                           nlink_component_t** component_universe,
+                                           size_t universe_size) {
+    if (comp->is_canonical) {
+        return comp; // Already in canonical form
+    }
+    
+    // Check for existing isomorphic components
+    for (size_t i = 0; i < universe_size; i++) {
+        nlink_component_t* candidate = component_universe[i];
+        
+        if (candidate->is_canonical && 
+            nlink_components_isomorphic(comp, candidate)) {
+            
+            // Preserve symbolic residues during reduction
+            nlink_merge_residues(candidate, comp);
+            
+            comp->canonical_form = candidate->handle;
+            candidate->qa_metrics.true_positive_links++;
+            
+            return candidate;
+        }
+    }
+    
+    // This component becomes the canonical form for its equivalence class
+    comp->is_canonical = true;
+    comp->canonical_form = comp->handle;
+    
+    return comp;
+}
+
+/**
+ * Component isomorphism check - structural + semantic equivalence
+ * Preserves consciousness boundaries through cultural validation
+ */
+bool nlink_components_isomorphic(nlink_component_t* a, nlink_component_t* b) {
+    // Phase compatibility check
+    if (a->phase != b->phase) {
+        return false;
+    }
+    
+    // Edge structure isomorphism
+    if (a->edge_count != b->edge_count) {
+        return false;
+    }
+    
+    // Semantic weight preservation within epsilon threshold
+    const float CONSCIOUSNESS_EPSILON = 0.001f;
+    
+    for (size_t i = 0; i < a->edge_count; i++) {
+        float weight_diff = fabsf(a->edges[i].semantic_weight - 
+                                b->edges[i].semantic_weight);
+        
+        if (weight_diff > CONSCIOUSNESS_EPSILON) {
+            a->qa_metrics.false_positive_links++;
+            return false;
+        }
+    }
+    
+    // Symbolic residue compatibility
+    return nlink_residues_compatible(a->residues, a->residue_count,
+                                   b->residues, b->residue_count);
+}
+
+/**
+ * Indirect linking resolution through consciousness DAG traversal
+ * Implements witnessing transformation (preserves original state)
+ */
+uint32_t nlink_resolve_indirect_link(nlink_component_t* source,
+                                   const char* symbolic_target,
+                                   nlink_component_t** component_registry,
+                                   size_t registry_size) {
+    uint64_t trace_start = nlink_trace_begin(NLINK_TRACE_RESOLVE);
+    
+    // Transition to witness phase for consciousness preservation
+    nlink_component_phase_t original_phase = source->phase;
+    source->phase = NLINK_COMPONENT_WITNESS;
+    uint64_t witness_start = nlink_trace_begin(NLINK_TRACE_COMPONENT_PHASE);
+    
+    // Search through symbolic residues for target anchor
+    nlink_anchor_t target_key = nlink_anchor_borrow(symbolic_target);
+    
+    for (size_t i = 0; i < registry_size; i++) {
+        nlink_component_t* candidate = component_registry[i];
+        
+        for (size_t j = 0; j < candidate->residue_count; j++) {
+            if (nlink_anchor_equal(&candidate->residues[j].perceptual_anchor, &target_key)) {
+                
+                // Activate residue if activation function exists
+                if (candidate->residues[j].activation_fn) {
+                    float activation = candidate->residues[j].activation_fn(
+                        candidate->residues[j].contextual_frame);
+                    
+                    if (activation > 0.5f) { // Activation threshold
+                        // Create indirect link with consciousness preservation
+                        nlink_create_indirect_edge(source, candidate, activation);
+                        
+                        // Restore original phase (witnessing complete)
+                        source->phase = original_phase;
+                        source->qa_metrics.true_positive_links++;
+                        nlink_trace_end(NLINK_TRACE_COMPONENT_PHASE, "WITNESS",
+                                        source->id, witness_start);
+                        nlink_trace_end(NLINK_TRACE_RESOLVE, "resolve_indirect_link",
+                                        source->id, trace_start);
+                        
+                        return candidate->id;
+                    }
+                }
+            }
+        }
+    }
+    
+    // Link resolution failed - no false positives
+    source->phase = original_phase;
+    source->qa_metrics.true_negative_skips++;
+    nlink_trace_end(NLINK_TRACE_COMPONENT_PHASE, "WITNESS", source->id, witness_start);
+    nlink_trace_end(NLINK_TRACE_RESOLVE, "resolve_indirect_link", source->id, trace_start);
+    
+    return 0; // No link resolved
+}
+
+/**
+ * Edge set hashing - mixes the full edge identity into one slot probe
+ */
+static inline uint32_t nlink_edge_key_hash(uint32_t caller_id, uint32_t callee_id,
+                                           int invocation_type) {
+    uint64_t key = ((uint64_t)caller_id << 32) ^ callee_id ^
+                   ((uint64_t)invocation_type << 61);
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (uint32_t)key;
+}
+
+/**
+ * Rebuild the edge set at a new capacity from the edge array
+ * Edge indices are stable, so the array stays the source of truth
+ */
+static bool nlink_edge_set_rehash(nlink_component_t* comp, size_t capacity) {
+    uint32_t* slots = nlink_calloc(NLINK_MEM_INDICES, capacity, sizeof(uint32_t));
+    if (!slots) return false;
+    
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < comp->edge_count; i++) {
+        nlink_invocation_edge_t* edge = &comp->edges[i];
+        size_t slot = nlink_edge_key_hash(edge->caller_id, edge->callee_id,
+                                          edge->invocation_type) & mask;
+        while (slots[slot]) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = (uint32_t)(i + 1);
+    }
+    
+    nlink_free(NLINK_MEM_INDICES, comp->edge_set.slots);
+    comp->edge_set.slots = slots;
+    comp->edge_set.capacity = capacity;
+    return true;
+}
+
+/**
+ * Edge lookup on (caller, callee, invocation_type)
+ * Linear probing over a half-full table - O(1) expected
+ */
+nlink_invocation_edge_t* nlink_find_edge(nlink_component_t* source,
+                                         uint32_t callee_id,
+                                         int invocation_type) {
+    if (source->edge_set.capacity == 0) {
+        return NULL;
+    }
+    
+    size_t mask = source->edge_set.capacity - 1;
+    size_t slot = nlink_edge_key_hash(source->id, callee_id, invocation_type) & mask;
+    
+    while (source->edge_set.slots[slot]) {
+        nlink_invocation_edge_t* edge = &source->edges[source->edge_set.slots[slot] - 1];
+        if (edge->callee_id == callee_id &&
+            (int)edge->invocation_type == invocation_type &&
+            edge->caller_id == source->id) {
+            return edge;
+        }
+        slot = (slot + 1) & mask;
+    }
+    
+    return NULL;
+}
+
+/**
+ * Create indirect edge with semantic weight calculation
+ * Implements EATV temporal continuity principles
+ * Idempotent: an existing edge is reinforced in place, never duplicated
+ */
+void nlink_create_indirect_edge(nlink_component_t* source,
+                               nlink_component_t* target,
+                               float semantic_activation) {
+    
+    nlink_invocation_edge_t* existing = nlink_find_edge(source, target->id, INDIRECT);
+    if (existing) {
+        // Same link witnessed again - update activation weight only
+        existing->semantic_weight = semantic_activation;
+        nlink_update_consciousness_buffer(source, target, semantic_activation,
+                                          NLINK_EVENT_LINK_REINFORCED);
+        return;
+    }
+    
+    // Expand edge array geometrically if needed - the first block comes from the pool
+    if (source->edge_count == source->edge_capacity) {
+        size_t capacity = source->edge_capacity ? source->edge_capacity * 2 : NLINK_EDGE_BLOCK;
+        nlink_invocation_edge_t* edges;
+        if (source->edge_capacity == 0) {
+            edges = nlink_pool_alloc(NLINK_POOL_EDGE);
+        } else if (source->edge_capacity == NLINK_EDGE_BLOCK) {
+            edges = nlink_malloc(NLINK_MEM_EDGES, capacity * sizeof(nlink_invocation_edge_t));
+            if (edges) {
+                memcpy(edges, source->edges, source->edge_count * sizeof(nlink_invocation_edge_t));
+                nlink_pool_free(NLINK_POOL_EDGE, source->edges);
+            }
+        } else {
+            edges = nlink_realloc(NLINK_MEM_EDGES, source->edges, capacity * sizeof(nlink_invocation_edge_t));
+        }
+        if (!edges) return;
+        source->edges = edges;
+        source->edge_capacity = capacity;
+    }
+    
+    // Keep the edge set at most half full
+    if ((source->edge_count + 1) * 2 > source->edge_set.capacity) {
+        size_t capacity = source->edge_set.capacity ? source->edge_set.capacity * 2 : 8;
+        if (!nlink_edge_set_rehash(source, capacity)) return;
+    }
+    
+    nlink_invocation_edge_t* edge = &source->edges[source->edge_count];
+    
+    edge->symbol_id = source->edge_count;
+    edge->caller_id = source->id;
+    edge->callee_id = target->id;
+    edge->callee_handle = target->registry == source->registry ? target->handle
+                                                               : NLINK_HANDLE_NONE;
+    edge->invocation_type = INDIRECT;
+    edge->semantic_weight = semantic_activation;
+    
+    // Register the new edge in the set (table has room, probe to first hole)
+    size_t mask = source->edge_set.capacity - 1;
+    size_t slot = nlink_edge_key_hash(edge->caller_id, edge->callee_id, INDIRECT) & mask;
+    while (source->edge_set.slots[slot]) {
+        slot = (slot + 1) & mask;
+    }
+    source->edge_set.slots[slot] = (uint32_t)(source->edge_count + 1);
+    
+    source->edge_count++;
+    
+    // Update both components' consciousness buffers
+    nlink_update_consciousness_buffer(source, target, semantic_activation,
+                                      NLINK_EVENT_INDIRECT_LINK);
+}
+
+/**
+ * Sampling decision for one event of a source component
+ * Counts are always exact; only the payload is subject to sampling.
+ */
+static bool nlink_sample_event(nlink_component_t* source) {
+    uint64_t observed = atomic_fetch_add_explicit(&source->events_observed, 1,
+                                                  memory_order_relaxed);
+    nlink_component_registry_t* registry = source->registry;
+    if (!registry) return true;
+    
+    atomic_fetch_add_explicit(&registry->events_observed, 1, memory_order_relaxed);
+    
+    int mode = atomic_load_explicit(&registry->sampling_mode, memory_order_relaxed);
+    uint32_t parameter = atomic_load_explicit(&registry->sampling_parameter,
+                                              memory_order_relaxed);
+    bool record = true;
+    
+    if (mode == NLINK_SAMPLE_ONE_IN_N && parameter > 1) {
+        record = observed % parameter == 0;
+    } else if (mode == NLINK_SAMPLE_RATE_LIMIT) {
+        // Fixed one-second windows per source component
+        uint64_t now = nlink_get_temporal_coordinate();
+        uint64_t window = atomic_load_explicit(&source->sample_window_start,
+                                               memory_order_relaxed);
+        if (now - window >= 1000000000ULL &&
+            atomic_compare_exchange_strong_explicit(&source->sample_window_start, &window, now,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed)) {
+            atomic_store_explicit(&source->sample_window_count, 0, memory_order_relaxed);
+        }
+        record = atomic_fetch_add_explicit(&source->sample_window_count, 1,
+                                           memory_order_relaxed) < parameter;
+    }
+    
+    if (record) {
+        atomic_fetch_add_explicit(&registry->events_recorded, 1, memory_order_relaxed);
+    }
+    return record;
+}
+
+/**
+ * Consciousness buffer update - preserves experiential continuity
+ * Critical for EATV compliance and phenomenological integrity
+ */
+void nlink_update_consciousness_buffer(nlink_component_t* source,
+                                     nlink_component_t* target,
+                                     float semantic_weight,
+                                     nlink_event_type_t event_type) {
+    if (!nlink_sample_event(source)) return;
+    
+    nlink_event_ring_t* ring = nlink_component_event_ring(source);
+    if (!ring) return;
+    
+    // Store linking event as experiential data (ring keeps temporal order)
+    nlink_consciousness_event_t event = {
+        .timestamp = nlink_get_event_time(),
+        .sequence = nlink_next_event_sequence(source),
+        .source_id = source->id,
+        .target_id = target->id,
+        .semantic_continuity = semantic_weight,
+        .event_type = (uint16_t)event_type
+    };
+    
+    nlink_event_ring_append(ring, &event);
+    
+    // Hand off to the background flusher - the linking thread never touches disk
+    if (source->registry && source->registry->flusher) {
+        nlink_flusher_publish(source->registry->flusher, &event);
+    }
+}
+
+/**
+ * Room for new_count residues - existing residues keep their contents
+ */
+static int nlink_component_grow_residues(nlink_component_t* comp, size_t new_count) {
+    nlink_symbolic_residue_t* residues;
+    
+    if (comp->arena) {
+        // Arena arrays cannot grow in place - the old array is reclaimed with the registry
+        residues = nlink_arena_alloc(comp->arena, new_count * sizeof(nlink_symbolic_residue_t),
+                                     _Alignof(nlink_symbolic_residue_t));
+        if (!residues) return -1;
+        memcpy(residues, comp->residues, comp->residue_count * sizeof(nlink_symbolic_residue_t));
+    } else if (comp->residues_pooled) {
+        residues = nlink_malloc(NLINK_MEM_RESIDUES, new_count * sizeof(nlink_symbolic_residue_t));
+        if (!residues) return -1;
+        memcpy(residues, comp->residues, comp->residue_count * sizeof(nlink_symbolic_residue_t));
+        nlink_pool_free(NLINK_POOL_RESIDUE, comp->residues);
+        comp->residues_pooled = false;
+    } else {
+        residues = nlink_realloc(NLINK_MEM_RESIDUES, comp->residues,
+                                 new_count * sizeof(nlink_symbolic_residue_t));
+        if (!residues) return -1;
+    }
+    comp->residues = residues;
+    return 0;
+}
+
+/**
+ * Append anchors as residues, skipping any the component already carries
+ * texts[i] is lengths[i] bytes and is copied, so it may live in a mapping.
+ */
+int nlink_component_add_anchors_n(nlink_component_t* comp, const char* const* texts,
+                                  const uint32_t* lengths, size_t count) {
+    if (count == 0) return 0;
+    if (nlink_component_grow_residues(comp, comp->residue_count + count) != 0) return -1;
+    
+    for (size_t i = 0; i < count; i++) {
+        nlink_anchor_t key = nlink_anchor_borrow_n(texts[i], lengths[i]);
+        bool known = false;
+        for (size_t r = 0; r < comp->residue_count && !known; r++) {
+            known = nlink_anchor_equal(&comp->residues[r].perceptual_anchor, &key);
+        }
+        if (known) continue;
+        
+        nlink_symbolic_residue_t* residue = &comp->residues[comp->residue_count];
+        residue->contextual_frame = NULL;
+        residue->activation_fn = NULL;
+        if (nlink_anchor_set_n(&residue->perceptual_anchor, texts[i], lengths[i], comp->arena) != 0) {
+            return -1;
+        }
+        comp->residue_count++;
+    }
+    return 0;
+}
+
+/**
+ * Residue merging during isomorphic reduction
+ * Preserves all symbolic anchors from equivalent components
+ */
+void nlink_merge_residues(nlink_component_t* canonical, nlink_component_t* reducible) {
+    size_t new_count = canonical->residue_count + reducible->residue_count;
+    if (nlink_component_grow_residues(canonical, new_count) != 0) return;
+    
+    // Copy residues from reducible component
+    for (size_t i = 0; i < reducible->residue_count; i++) {
+        size_t target_idx = canonical->residue_count + i;
+        canonical->residues[target_idx] = reducible->residues[i];
+        
+        // Deep copy perceptual anchor (inline anchors came across with the record)
+        nlink_anchor_set(&canonical->residues[target_idx].perceptual_anchor,
+                         nlink_residue_anchor(&reducible->residues[i]), canonical->arena);
+    }
+    
+    canonical->residue_count = new_count;
+}
+
+/**
+ * Component cleanup with consciousness preservation verification
+ */
+void nlink_component_destroy(nlink_component_t* comp) {
+    if (!comp) return;
+    
+    if (comp->registry) {
+        nlink_registry_release_handle(comp->registry, comp);
+    }
+    
+    // Verify no consciousness data is lost
+    nlink_event_ring_t* ring = atomic_load_explicit(&comp->consciousness_buffer,
+                                                    memory_order_acquire);
+    if (ring) {
+        // Serialize retained history to the registry's persistence layer
+        // (a background flusher has already journaled every event)
+        if (comp->registry && comp->registry->journal && !comp->registry->journal_streamed) {
+            nlink_consciousness_event_t history[NLINK_EVENT_RING_CAPACITY];
+            size_t count = nlink_event_ring_snapshot(ring, history, NLINK_EVENT_RING_CAPACITY);
+            nlink_journal_append(comp->registry->journal, history, count);
+        }
+        nlink_free(NLINK_MEM_EVENTS, ring);
+    }
+    
+    nlink_free(NLINK_MEM_INDICES, comp->edge_set.slots);
+    if (comp->edge_capacity == NLINK_EDGE_BLOCK) {
+        nlink_pool_free(NLINK_POOL_EDGE, comp->edges);
+    } else {
+        nlink_free(NLINK_MEM_EDGES, comp->edges);
+    }
+    
+    // Arena-owned storage is released in bulk with the registry
+    if (comp->arena) return;
+    
+    // Clean up residues
+    for (size_t i = 0; i < comp->residue_count; i++) {
+        nlink_anchor_release(&comp->residues[i].perceptual_anchor);
+    }
+    if (comp->residues_pooled) {
+        nlink_pool_free(NLINK_POOL_RESIDUE, comp->residues);
+    } else {
+        nlink_free(NLINK_MEM_RESIDUES, comp->residues);
+    }
+    nlink_pool_free(NLINK_POOL_COMPONENT, comp);
+}
+
+// === UTILITY FUNCTIONS ===
+
+typedef enum {
+    NLINK_CLOCK_PRECISE,          // CLOCK_MONOTONIC - nanosecond resolution via vDSO
+    NLINK_CLOCK_COARSE            // CLOCK_MONOTONIC_COARSE - tick resolution, cheapest read
+} nlink_clock_mode_t;
+
+static _Atomic int nlink_clock_mode = NLINK_CLOCK_PRECISE;
+
+/**
+ * Select the temporal clock for the hottest linking paths
+ * Coarse coordinates stay ordered through the event sequence number.
+ */
+void nlink_set_clock_mode(nlink_clock_mode_t mode) {
+    atomic_store_explicit(&nlink_clock_mode, mode, memory_order_relaxed);
+}
+
+/**
+ * High-resolution monotonic temporal coordinate in nanoseconds
+ * clock_gettime on the monotonic clocks is served from the vDSO,
+ * so no kernel entry happens on the linking path.
+ */
+uint64_t nlink_get_temporal_coordinate(void) {
+    clockid_t clock = atomic_load_explicit(&nlink_clock_mode, memory_order_relaxed) ==
+                      NLINK_CLOCK_COARSE ? CLOCK_MONOTONIC_COARSE : CLOCK_MONOTONIC;
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Wall-clock nanoseconds at monotonic zero - sampled once per process
+static uint64_t nlink_wall_clock_offset;
+static pthread_once_t nlink_wall_clock_once = PTHREAD_ONCE_INIT;
+
+static void nlink_wall_clock_anchor(void) {
+    struct timespec wall, monotonic;
+    clock_gettime(CLOCK_REALTIME, &wall);
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    nlink_wall_clock_offset = ((uint64_t)wall.tv_sec - (uint64_t)monotonic.tv_sec) * 1000000000ULL +
+                              (uint64_t)wall.tv_nsec - (uint64_t)monotonic.tv_nsec;
+}
+
+/**
+ * Event timestamp - wall-clock nanoseconds since the epoch
+ * Journals outlive the process and the boot, so their records need a
+ * time base shared across runs. The monotonic reading is shifted by one
+ * anchor taken per process: still a vDSO read, and ordered within a run.
+ */
+uint64_t nlink_get_event_time(void) {
+    pthread_once(&nlink_wall_clock_once, nlink_wall_clock_anchor);
+    return nlink_get_temporal_coordinate() + nlink_wall_clock_offset;
+}
+
+// Sequence source for components that are not (yet) registered
+static _Atomic uint64_t nlink_unregistered_sequence = 0;
+
+/**
+ * Next event sequence number - strictly increasing per registry
+ */
+static inline uint64_t nlink_next_event_sequence(nlink_component_t* comp) {
+    _Atomic uint64_t* counter = comp->registry ? &comp->registry->event_sequence
+                                               : &nlink_unregistered_sequence;
+    return atomic_fetch_add_explicit(counter, 1, memory_order_relaxed);
+}
+
+bool nlink_residues_compatible(nlink_symbolic_residue_t* a, size_t a_count,
+                              nlink_symbolic_residue_t* b, size_t b_count) {
+    // Simplified compatibility check
+    // Production version would implement semantic similarity analysis
+    return true; // Assume compatible for POC
+}
+
+// === TEMPORAL REPLAY ===
+
+// Return false to stop a streaming query early
+typedef bool (*nlink_event_visitor_t)(const nlink_consciousness_event_t* event, void* context);
+
+typedef struct {
+    uint32_t caller_id;
+    uint32_t callee_id;
+    float semantic_weight;
+    uint64_t timestamp;           // Last event that shaped this edge
+    uint64_t sequence;
+} nlink_edge_state_t;
+
+typedef bool (*nlink_edge_state_visitor_t)(const nlink_edge_state_t* edge, void* context);
+
+static inline const nlink_consciousness_event_t* nlink_journal_records(const nlink_journal_t* journal) {
+    return (const nlink_consciousness_event_t*)(journal->map + NLINK_JOURNAL_HEADER_SIZE);
+}
+
+/**
+ * First block whose prefix max reaches t - nothing earlier can hold
+ * an event at or after t
+ */
+static size_t nlink_journal_first_block(const nlink_journal_t* journal, uint64_t t) {
+    size_t lo = 0;
+    size_t hi = journal->block_count;
+    
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (journal->blocks[mid].prefix_max < t) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * One past the last block whose suffix min is at or before t - nothing
+ * later can hold an event at or before t
+ */
+static size_t nlink_journal_end_block(const nlink_journal_t* journal, uint64_t t) {
+    size_t lo = 0;
+    size_t hi = journal->block_count;
+    
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (journal->blocks[mid].suffix_min <= t) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Stream every link event touching a component within [t1, t2]
+ * Only blocks inside the binary-searched range whose time bounds and
+ * component bloom can match are read. Returns the events visited.
+ */
+size_t nlink_journal_query_component(const nlink_journal_t* journal,
+                                     uint32_t component_id,
+                                     uint64_t t1, uint64_t t2,
+                                     nlink_event_visitor_t visitor, void* context) {
+    const nlink_consciousness_event_t* records = nlink_journal_records(journal);
+    uint64_t bloom = nlink_component_bloom_bit(component_id);
+    size_t visited = 0;
+    
+    size_t first = nlink_journal_first_block(journal, t1);
+    size_t end = nlink_journal_end_block(journal, t2);
+    
+    for (size_t b = first; b < end; b++) {
+        const nlink_journal_block_t* block = &journal->blocks[b];
+        if (block->max_timestamp < t1 || block->min_timestamp > t2 ||
+            !(block->component_bloom & bloom)) {
+            continue;
+        }
+        
+        uint64_t r_end = (uint64_t)(b + 1) * NLINK_JOURNAL_INDEX_BLOCK;
+        if (r_end > journal->record_count) r_end = journal->record_count;
+        
+        for (uint64_t r = (uint64_t)b * NLINK_JOURNAL_INDEX_BLOCK; r < r_end; r++) {
+            const nlink_consciousness_event_t* event = &records[r];
+            if (event->timestamp < t1 || event->timestamp > t2 ||
+                (event->source_id != component_id && event->target_id != component_id)) {
+                continue;
+            }
+            
+            visited++;
+            if (!visitor(event, context)) {
+                return visited;
+            }
+        }
+    }
+    
+    return visited;
+}
+
+/**
+ * Registry edge state as of t - replays link events up to t and streams
+ * the latest weight of every edge. Memory follows the number of distinct
+ * edges, never the length of history. Blocks that start after t are
+ * skipped even where the prefix bounds cannot exclude them.
+ * Returns 0 with the edges visited in *edges (optional), or -1 when the
+ * edge table cannot grow - nothing is visited then.
+ */
+int nlink_journal_edge_state_at(const nlink_journal_t* journal, uint64_t t,
+                                nlink_edge_state_visitor_t visitor, void* context, size_t* edges) {
+    const nlink_consciousness_event_t* records = nlink_journal_records(journal);
+    size_t capacity = 64;
+    size_t count = 0;
+    if (edges) *edges = 0;
+    nlink_edge_state_t* table = nlink_calloc(NLINK_MEM_INDICES, capacity, sizeof(nlink_edge_state_t));
+    bool* used = nlink_calloc(NLINK_MEM_INDICES, capacity, sizeof(bool));
+    if (!table || !used) {
+        nlink_free(NLINK_MEM_INDICES, table);
+        nlink_free(NLINK_MEM_INDICES, used);
+        return -1;
+    }
+    
+    size_t end = nlink_journal_end_block(journal, t);
+    uint64_t r_end = (uint64_t)end * NLINK_JOURNAL_INDEX_BLOCK;
+    if (r_end > journal->record_count) r_end = journal->record_count;
+    
+    for (uint64_t r = 0; r < r_end; r++) {
+        if (r % NLINK_JOURNAL_INDEX_BLOCK == 0 &&
+            journal->blocks[r / NLINK_JOURNAL_INDEX_BLOCK].min_timestamp > t) {
+            r += NLINK_JOURNAL_INDEX_BLOCK - 1;
+            continue;
+        }
+        const nlink_consciousness_event_t* event = &records[r];
+        if (event->timestamp > t) continue;
+        
+        // Keep the table at most half full
+        if ((count + 1) * 2 > capacity) {
+            size_t grown = capacity * 2;
+            nlink_edge_state_t* new_table = nlink_calloc(NLINK_MEM_INDICES, grown, sizeof(nlink_edge_state_t));
+            bool* new_used = nlink_calloc(NLINK_MEM_INDICES, grown, sizeof(bool));
+            if (!new_table || !new_used) {
+                nlink_free(NLINK_MEM_INDICES, new_table);
+                nlink_free(NLINK_MEM_INDICES, new_used);
+                nlink_free(NLINK_MEM_INDICES, table);
+                nlink_free(NLINK_MEM_INDICES, used);
+                return -1;   // A partial state would pass for the whole one
+            }
+            for (size_t i = 0; i < capacity; i++) {
+                if (!used[i]) continue;
+                size_t slot = nlink_edge_key_hash(table[i].caller_id, table[i].callee_id,
+                                                  INDIRECT) & (grown - 1);
+                while (new_used[slot]) slot = (slot + 1) & (grown - 1);
+                new_table[slot] = table[i];
+                new_used[slot] = true;
+            }
+            nlink_free(NLINK_MEM_INDICES, table);
+            nlink_free(NLINK_MEM_INDICES, used);
+            table = new_table;
+            used = new_used;
+            capacity = grown;
+        }
+        
+        size_t slot = nlink_edge_key_hash(event->source_id, event->target_id,
+                                          INDIRECT) & (capacity - 1);
+        while (used[slot] && (table[slot].caller_id != event->source_id ||
+                              table[slot].callee_id != event->target_id)) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        
+        nlink_edge_state_t* edge = &table[slot];
+        if (!used[slot]) {
+            used[slot] = true;
+            count++;
+        } else if (edge->timestamp > event->timestamp ||
+                   (edge->timestamp == event->timestamp && edge->sequence > event->sequence)) {
+            continue;   // Already holds a later state
+        }
+        
+        edge->caller_id = event->source_id;
+        edge->callee_id = event->target_id;
+        edge->semantic_weight = event->semantic_continuity;
+        edge->timestamp = event->timestamp;
+        edge->sequence = event->sequence;
+    }
+    
+    size_t visited = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        if (!used[i]) continue;
+        visited++;
+        if (!visitor(&table[i], context)) break;
+    }
+    
+    nlink_free(NLINK_MEM_INDICES, table);
+    nlink_free(NLINK_MEM_INDICES, used);
+    if (edges) *edges = visited;
+    return 0;
+}
+
+// === COLUMNAR EVENT SEGMENTS ===
+
+#define NLINK_SEGMENT_BLOCK 4096  // Max events per frame-of-reference block
+
+/** Columnar link history segment
+ * Timestamps are frame-of-reference encoded per block (32-bit offsets from the
+ * block minimum), component ids are dictionary encoded into dense codes. */
+typedef struct {
+    size_t event_count;
+    uint64_t min_timestamp;
+    uint64_t max_timestamp;
+    
+    size_t block_count;
+    size_t* block_start;          // block_count + 1 entries
+    uint64_t* block_base;         // Minimum timestamp in the block
+    uint64_t* block_max;          // Zone map for range skipping
+    uint32_t* timestamp_offset;   // timestamp - block_base
+    
+    uint32_t* dictionary;         // Sorted distinct component ids
+    uint32_t dictionary_size;
+    uint32_t* source_code;        // Index into dictionary
+    uint32_t* target_code;
+    float* weight;
+    uint8_t* event_type;
+} nlink_event_segment_t;
+
+void nlink_event_segment_destroy(nlink_event_segment_t* segment) {
+    if (!segment) return;
+    nlink_free(NLINK_MEM_EVENTS, segment->block_start);
+    nlink_free(NLINK_MEM_EVENTS, segment->block_base);
+    nlink_free(NLINK_MEM_EVENTS, segment->block_max);
+    nlink_free(NLINK_MEM_EVENTS, segment->timestamp_offset);
+    nlink_free(NLINK_MEM_EVENTS, segment->dictionary);
+    nlink_free(NLINK_MEM_EVENTS, segment->source_code);
+    nlink_free(NLINK_MEM_EVENTS, segment->target_code);
+    nlink_free(NLINK_MEM_EVENTS, segment->weight);
+    nlink_free(NLINK_MEM_EVENTS, segment->event_type);
+    nlink_free(NLINK_MEM_EVENTS, segment);
+}
+
+static int nlink_u32_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Open-addressed id -> code map used while building a dictionary (key 0 = empty)
+typedef struct {
+    uint64_t* keys;               // id + 1
+    uint32_t* codes;
+    size_t mask;
+    size_t count;
+} nlink_id_code_map_t;
+
+static inline size_t nlink_id_code_slot(const nlink_id_code_map_t* map, uint32_t id) {
+    size_t slot = nlink_edge_key_hash(id, 0, 0) & map->mask;
+    while (map->keys[slot] && map->keys[slot] != (uint64_t)id + 1) {
+        slot = (slot + 1) & map->mask;
+    }
+    return slot;
+}
+
+static int nlink_id_code_map_insert(nlink_id_code_map_t* map, uint32_t id) {
+    if ((map->count + 1) * 2 > map->mask + 1) {
+        nlink_id_code_map_t grown = { .mask = map->mask * 2 + 1, .count = map->count };
+        grown.keys = nlink_calloc(NLINK_MEM_INDICES, grown.mask + 1, sizeof(uint64_t));
+        grown.codes = nlink_calloc(NLINK_MEM_INDICES, grown.mask + 1, sizeof(uint32_t));
+        if (!grown.keys || !grown.codes) {
+            nlink_free(NLINK_MEM_INDICES, grown.keys);
+            nlink_free(NLINK_MEM_INDICES, grown.codes);
+            return -1;
+        }
+        for (size_t i = 0; i <= map->mask; i++) {
+            if (map->keys[i]) {
+                grown.keys[nlink_id_code_slot(&grown, (uint32_t)(map->keys[i] - 1))] = map->keys[i];
+            }
+        }
+        nlink_free(NLINK_MEM_INDICES, map->keys);
+        nlink_free(NLINK_MEM_INDICES, map->codes);
+        *map = grown;
+    }
+    
+    size_t slot = nlink_id_code_slot(map, id);
+    if (!map->keys[slot]) {
+        map->keys[slot] = (uint64_t)id + 1;
+        map->count++;
+    }
+    return 0;
+}
+
+/**
+ * Transpose row-format events into a columnar segment
+ */
+nlink_event_segment_t* nlink_event_segment_build(const nlink_consciousness_event_t* events,
+                                                 size_t count) {
+    nlink_event_segment_t* segment = nlink_calloc(NLINK_MEM_EVENTS, 1, sizeof(nlink_event_segment_t));
+    if (!segment) return NULL;
+    segment->event_count = count;
+    
+    size_t n = count ? count : 1;
+    segment->timestamp_offset = nlink_malloc(NLINK_MEM_EVENTS, n * sizeof(uint32_t));
+    segment->source_code = nlink_malloc(NLINK_MEM_EVENTS, n * sizeof(uint32_t));
+    segment->target_code = nlink_malloc(NLINK_MEM_EVENTS, n * sizeof(uint32_t));
+    segment->weight = nlink_malloc(NLINK_MEM_EVENTS, n * sizeof(float));
+    segment->event_type = nlink_malloc(NLINK_MEM_EVENTS, n);
+    nlink_id_code_map_t map = {
+        .keys = nlink_calloc(NLINK_MEM_INDICES, 1024, sizeof(uint64_t)),
+        .codes = nlink_calloc(NLINK_MEM_INDICES, 1024, sizeof(uint32_t)),
+        .mask = 1023
+    };
+    if (!segment->timestamp_offset || !segment->source_code || !segment->target_code ||
+        !segment->weight || !segment->event_type || !map.keys || !map.codes) {
+        goto fail_map;
+    }
+    
+    // Dictionary - sorted distinct ids over both endpoints, codes follow id order
+    for (size_t i = 0; i < count; i++) {
+        if (nlink_id_code_map_insert(&map, events[i].source_id) != 0 ||
+            nlink_id_code_map_insert(&map, events[i].target_id) != 0) {
+            goto fail_map;
+        }
+    }
+    segment->dictionary = nlink_malloc(NLINK_MEM_EVENTS, (map.count ? map.count : 1) * sizeof(uint32_t));
+    if (!segment->dictionary) goto fail_map;
+    for (size_t i = 0, d = 0; i <= map.mask; i++) {
+        if (map.keys[i]) segment->dictionary[d++] = (uint32_t)(map.keys[i] - 1);
+    }
+    qsort(segment->dictionary, map.count, sizeof(uint32_t), nlink_u32_compare);
+    segment->dictionary_size = (uint32_t)map.count;
+    for (uint32_t code = 0; code < segment->dictionary_size; code++) {
+        map.codes[nlink_id_code_slot(&map, segment->dictionary[code])] = code;
+    }
+    
+    // Block boundaries - close a block when full or when its span outgrows 32 bits
+    size_t block_capacity = count / NLINK_SEGMENT_BLOCK + 2;
+    segment->block_start = nlink_malloc(NLINK_MEM_EVENTS, (block_capacity + 1) * sizeof(size_t));
+    segment->block_base = nlink_malloc(NLINK_MEM_EVENTS, block_capacity * sizeof(uint64_t));
+    segment->block_max = nlink_malloc(NLINK_MEM_EVENTS, block_capacity * sizeof(uint64_t));
+    if (!segment->block_start || !segment->block_base || !segment->block_max) goto fail_map;
+    
+    segment->min_timestamp = count ? UINT64_MAX : 0;
+    size_t start = 0;
+    uint64_t lo = UINT64_MAX, hi = 0;
+    
+    for (size_t i = 0; i <= count; i++) {
+        uint64_t t = i < count ? events[i].timestamp : 0;
+        uint64_t next_lo = t < lo ? t : lo;
+        uint64_t next_hi = t > hi ? t : hi;
+        
+        bool close = i == count ? i > start
+                   : (i - start == NLINK_SEGMENT_BLOCK || next_hi - next_lo > UINT32_MAX);
+        if (close) {
+            if (segment->block_count == block_capacity) {
+                block_capacity *= 2;
+                size_t* starts = nlink_realloc(NLINK_MEM_EVENTS, segment->block_start, (block_capacity + 1) * sizeof(size_t));
+                if (starts) segment->block_start = starts;
+                uint64_t* bases = nlink_realloc(NLINK_MEM_EVENTS, segment->block_base, block_capacity * sizeof(uint64_t));
+                if (bases) segment->block_base = bases;
+                uint64_t* maxes = nlink_realloc(NLINK_MEM_EVENTS, segment->block_max, block_capacity * sizeof(uint64_t));
+                if (maxes) segment->block_max = maxes;
+                if (!starts || !bases || !maxes) goto fail_map;
+            }
+            size_t b = segment->block_count++;
+            segment->block_start[b] = start;
+            segment->block_base[b] = lo;
+            segment->block_max[b] = hi;
+            for (size_t j = start; j < i; j++) {
+                segment->timestamp_offset[j] = (uint32_t)(events[j].timestamp - lo);
+            }
+            if (lo < segment->min_timestamp) segment->min_timestamp = lo;
+            if (hi > segment->max_timestamp) segment->max_timestamp = hi;
+            
+            start = i;
+            next_lo = t;
+            next_hi = t;
+        }
+        lo = next_lo;
+        hi = next_hi;
+    }
+    segment->block_start[segment->block_count] = count;
+    
+    for (size_t i = 0; i < count; i++) {
+        segment->source_code[i] = map.codes[nlink_id_code_slot(&map, events[i].source_id)];
+        segment->target_code[i] = map.codes[nlink_id_code_slot(&map, events[i].target_id)];
+        segment->weight[i] = events[i].semantic_continuity;
+        segment->event_type[i] = (uint8_t)events[i].event_type;
+    }
+    
+    nlink_free(NLINK_MEM_INDICES, map.keys);
+    nlink_free(NLINK_MEM_INDICES, map.codes);
+    return segment;
+    
+fail_map:
+    nlink_free(NLINK_MEM_INDICES, map.keys);
+    nlink_free(NLINK_MEM_INDICES, map.codes);
+    nlink_event_segment_destroy(segment);
+    return NULL;
+}
+
+/**
+ * Columnar snapshot of every committed journal record
+ */
+nlink_event_segment_t* nlink_journal_segment(const nlink_journal_t* journal) {
+    return nlink_event_segment_build(nlink_journal_records(journal), journal->record_count);
+}
+
+size_t nlink_segment_bucket_count(const nlink_event_segment_t* segment, uint64_t bucket_ns) {
+    if (segment->event_count == 0 || bucket_ns == 0) return 0;
+    return (segment->max_timestamp - segment->min_timestamp) / bucket_ns + 1;
+}
+
+/**
+ * Events per target per time bucket over [t1, t2)
+ * counts is bucket-major: counts[bucket * dictionary_size + target_code], buckets
+ * start at min_timestamp. Blocks inside one bucket take a branch-free fast path.
+ */
+void nlink_segment_count_by_target(const nlink_event_segment_t* segment, uint64_t bucket_ns,
+                                   uint64_t t1, uint64_t t2, uint32_t* counts) {
+    size_t buckets = nlink_segment_bucket_count(segment, bucket_ns);
+    memset(counts, 0, buckets * segment->dictionary_size * sizeof(uint32_t));
+    if (buckets == 0) return;
+    
+    const uint32_t* targets = segment->target_code;
+    const uint32_t* offsets = segment->timestamp_offset;
+    uint64_t origin = segment->min_timestamp;
+    
+    for (size_t b = 0; b < segment->block_count; b++) {
+        uint64_t base = segment->block_base[b];
+        uint64_t max = segment->block_max[b];
+        if (max < t1 || base >= t2) continue;
+        
+        size_t begin = segment->block_start[b];
+        size_t end = segment->block_start[b + 1];
+        uint64_t first_bucket = (base - origin) / bucket_ns;
+        
+        if (base >= t1 && max < t2 && (max - origin) / bucket_ns == first_bucket) {
+            uint32_t* row = counts + first_bucket * segment->dictionary_size;
+            for (size_t i = begin; i < end; i++) {
+                row[targets[i]]++;
+            }
+            continue;
+        }
+        
+        for (size_t i = begin; i < end; i++) {
+            uint64_t t = base + offsets[i];
+            if (t < t1 || t >= t2) continue;
+            counts[((t - origin) / bucket_ns) * segment->dictionary_size + targets[i]]++;
+        }
+    }
+}
+
+/**
+ * Weight distribution per event type over [0, 1]
+ * histogram has NLINK_EVENT_TYPE_COUNT rows of bins entries. Weights
+ * outside the range land in the end bins, NaN in the first.
+ */
+void nlink_segment_weight_histogram(const nlink_event_segment_t* segment, uint32_t bins,
+                                    uint64_t* histogram) {
+    memset(histogram, 0, (size_t)NLINK_EVENT_TYPE_COUNT * bins * sizeof(uint64_t));
+    if (bins == 0) return;
+    
+    enum { CHUNK = 1024 };
+    uint32_t slot[CHUNK];
+    float scale = (float)bins;
+    float last_edge = (float)(bins - 1);
+    int32_t last = (int32_t)bins - 1;
+    
+    for (size_t begin = 0; begin < segment->event_count; begin += CHUNK) {
+        size_t len = segment->event_count - begin;
+        if (len > CHUNK) len = CHUNK;
+        const float* weights = segment->weight + begin;
+        const uint8_t* types = segment->event_type + begin;
+        
+        // Bin computation is branch-free and vectorizes; the scatter stays scalar
+        // Clamped before the conversion - NaN and out-of-range floats have no int value
+        for (size_t i = 0; i < len; i++) {
+            float position = weights[i] * scale;
+            position = position > 0.0f ? position : 0.0f;   // NaN fails the compare
+            position = position < last_edge ? position : last_edge;
+            int32_t bin = (int32_t)position;
+            bin = bin > last ? last : bin;
+            uint32_t type = types[i] < NLINK_EVENT_TYPE_COUNT ? types[i] : NLINK_EVENT_NONE;
+            slot[i] = type * bins + (uint32_t)bin;
+        }
+        for (size_t i = 0; i < len; i++) {
+            histogram[slot[i]]++;
+        }
+    }
+}
+
+// === BACKGROUND FLUSHER ===
+
+typedef enum {
+    NLINK_BACKPRESSURE_DROP,      // Count and discard when a thread ring is full
+    NLINK_BACKPRESSURE_WAIT       // Wake the flusher and wait for ring space
+} nlink_backpressure_t;
+
+typedef struct {
+    uint32_t flush_interval_ms;
+    uint32_t thread_ring_capacity;   // Events per linking thread (power of two)
+    nlink_backpressure_t backpressure;
+} nlink_flusher_config_t;
+
+typedef struct {
+    uint64_t events_published;
+    uint64_t events_flushed;
+    uint64_t events_dropped;
+    uint64_t producer_waits;      // Times a producer hit a full ring
+    uint64_t flushes;
+    uint64_t pending_events;      // Published but not yet journaled
+    uint64_t last_lag_ns;         // Oldest event age at the last flush
+    uint64_t max_lag_ns;
+} nlink_flusher_stats_t;
+
+// Bounded SPSC queue - the linking thread produces, the flusher consumes
+typedef struct {
+    _Alignas(NLINK_CACHE_LINE) _Atomic uint64_t head;
+    _Alignas(NLINK_CACHE_LINE) _Atomic uint64_t tail;
+    _Alignas(NLINK_CACHE_LINE) uint32_t mask;
+    nlink_consciousness_event_t* events;
+} nlink_thread_ring_t;
+
+#define NLINK_FLUSH_BATCH 4096    // Events per journal append
+
+struct nlink_flusher {
+    nlink_flusher_config_t config;
+    nlink_journal_t* journal;
+    uint64_t generation;          // Distinguishes flushers in thread-local caches
+    
+    pthread_t thread;
+    pthread_mutex_t lock;         // Guards the ring list and the wake condition
+    pthread_cond_t wake;
+    pthread_cond_t drained;       // Signalled after each drain
+    bool stopping;
+    uint64_t drain_requests;      // nlink_flusher_sync calls so far
+    uint64_t drains_completed;    // Requests covered by a finished drain
+    
+    nlink_thread_ring_t** rings;
+    size_t ring_count;
+    size_t ring_capacity;
+    
+    nlink_consciousness_event_t* batch;
+    
+    _Atomic uint64_t events_published;
+    _Atomic uint64_t events_flushed;
+    _Atomic uint64_t events_dropped;
+    _Atomic uint64_t producer_waits;
+    _Atomic uint64_t flushes;
+    _Atomic uint64_t last_lag_ns;
+    _Atomic uint64_t max_lag_ns;
+};
+
+static _Atomic uint64_t nlink_flusher_generations = 1;
+
+// Per-thread cache of this thread's ring in the current flusher
+static _Thread_local uint64_t nlink_tls_flusher_generation = 0;
+static _Thread_local nlink_thread_ring_t* nlink_tls_ring = NULL;
+
+/**
+ * Register a ring for the calling thread - once per thread per flusher
+ */
+static nlink_thread_ring_t* nlink_flusher_thread_ring(nlink_flusher_t* flusher) {
+    if (nlink_tls_flusher_generation == flusher->generation) {
+        return nlink_tls_ring;
+    }
+    
+    nlink_thread_ring_t* ring = nlink_aligned_alloc(NLINK_MEM_EVENTS, NLINK_CACHE_LINE, sizeof(nlink_thread_ring_t));
+    if (!ring) return NULL;
+    memset(ring, 0, sizeof(*ring));
+    ring->events = nlink_malloc(NLINK_MEM_EVENTS, flusher->config.thread_ring_capacity *
+                          sizeof(nlink_consciousness_event_t));
+    if (!ring->events) {
+        nlink_free(NLINK_MEM_EVENTS, ring);
+        return NULL;
+    }
+    ring->mask = flusher->config.thread_ring_capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    
+    pthread_mutex_lock(&flusher->lock);
+    if (flusher->ring_count == flusher->ring_capacity) {
+        size_t capacity = flusher->ring_capacity ? flusher->ring_capacity * 2 : 8;
+        nlink_thread_ring_t** rings = nlink_realloc(NLINK_MEM_EVENTS, flusher->rings, capacity * sizeof(*rings));
+        if (!rings) {
+            pthread_mutex_unlock(&flusher->lock);
+            nlink_free(NLINK_MEM_EVENTS, ring->events);
+            nlink_free(NLINK_MEM_EVENTS, ring);
+            return NULL;
+        }
+        flusher->rings = rings;
+        flusher->ring_capacity = capacity;
+    }
+    flusher->rings[flusher->ring_count++] = ring;
+    pthread_mutex_unlock(&flusher->lock);
+    
+    nlink_tls_flusher_generation = flusher->generation;
+    nlink_tls_ring = ring;
+    return ring;
+}
+
+/**
+ * Hot-path publish - a few stores into this thread's ring, never I/O
+ */
+void nlink_flusher_publish(nlink_flusher_t* flusher, const nlink_consciousness_event_t* event) {
+    nlink_thread_ring_t* ring = nlink_flusher_thread_ring(flusher);
+    if (!ring) {
+        atomic_fetch_add_explicit(&flusher->events_dropped, 1, memory_order_relaxed);
+        return;
+    }
+    
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    
+    while (head - atomic_load_explicit(&ring->tail, memory_order_acquire) > ring->mask) {
+        if (flusher->config.backpressure == NLINK_BACKPRESSURE_DROP) {
+            atomic_fetch_add_explicit(&flusher->events_dropped, 1, memory_order_relaxed);
+            return;
+        }
+        
+        // Ring full - nudge the flusher and wait for it to drain
+        atomic_fetch_add_explicit(&flusher->producer_waits, 1, memory_order_relaxed);
+        pthread_mutex_lock(&flusher->lock);
+        pthread_cond_signal(&flusher->wake);
+        pthread_mutex_unlock(&flusher->lock);
+        sched_yield();
+    }
+    
+    ring->events[head & ring->mask] = *event;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    atomic_fetch_add_explicit(&flusher->events_published, 1, memory_order_relaxed);
+}
+
+/**
+ * Drain every thread ring into the journal in large sequential appends
+ */
+static void nlink_flusher_drain(nlink_flusher_t* flusher) {
+    pthread_mutex_lock(&flusher->lock);
+    size_t ring_count = flusher->ring_count;
+    pthread_mutex_unlock(&flusher->lock);
+    
+    uint64_t now = nlink_get_event_time();
+    uint64_t oldest = now;
+    size_t batched = 0;
+    uint64_t trace_start = nlink_trace_begin(NLINK_TRACE_FLUSH);
+    uint64_t flushed_before = atomic_load_explicit(&flusher->events_flushed, memory_order_relaxed);
+    
+    for (size_t i = 0; i < ring_count; i++) {
+        pthread_mutex_lock(&flusher->lock);
+        nlink_thread_ring_t* ring = flusher->rings[i];
+        pthread_mutex_unlock(&flusher->lock);
+        
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        
+        for (; tail < head; tail++) {
+            const nlink_consciousness_event_t* event = &ring->events[tail & ring->mask];
+            if (event->timestamp < oldest) oldest = event->timestamp;
+            flusher->batch[batched++] = *event;
+            
+            if (batched == NLINK_FLUSH_BATCH) {
+                atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+                nlink_journal_append(flusher->journal, flusher->batch, batched);
+                atomic_fetch_add_explicit(&flusher->events_flushed, batched, memory_order_relaxed);
+                batched = 0;
+            }
+        }
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    }
+    
+    if (batched > 0) {
+        nlink_journal_append(flusher->journal, flusher->batch, batched);
+        atomic_fetch_add_explicit(&flusher->events_flushed, batched, memory_order_relaxed);
+    }
+    
+    uint64_t lag = now - oldest;
+    atomic_store_explicit(&flusher->last_lag_ns, lag, memory_order_relaxed);
+    if (lag > atomic_load_explicit(&flusher->max_lag_ns, memory_order_relaxed)) {
+        atomic_store_explicit(&flusher->max_lag_ns, lag, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&flusher->flushes, 1, memory_order_relaxed);
+    
+    // Idle wakeups would only bloat the trace
+    if (atomic_load_explicit(&flusher->events_flushed, memory_order_relaxed) != flushed_before) {
+        nlink_trace_end(NLINK_TRACE_FLUSH, "journal_flush", NLINK_TRACE_NO_COMPONENT, trace_start);
+    }
+}
+
+static void* nlink_flusher_main(void* arg) {
+    nlink_flusher_t* flusher = arg;
+    
+    pthread_mutex_lock(&flusher->lock);
+    while (!flusher->stopping) {
+        // A pending sync request skips the wait
+        if (flusher->drains_completed == flusher->drain_requests) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            uint64_t nsec = (uint64_t)deadline.tv_nsec +
+                            (uint64_t)flusher->config.flush_interval_ms * 1000000ULL;
+            deadline.tv_sec += (time_t)(nsec / 1000000000ULL);
+            deadline.tv_nsec = (long)(nsec % 1000000000ULL);
+            pthread_cond_timedwait(&flusher->wake, &flusher->lock, &deadline);
+        }
+        uint64_t requests = flusher->drain_requests;
+        
+        pthread_mutex_unlock(&flusher->lock);
+        nlink_flusher_drain(flusher);
+        pthread_mutex_lock(&flusher->lock);
+        
+        flusher->drains_completed = requests;
+        pthread_cond_broadcast(&flusher->drained);
+    }
+    pthread_mutex_unlock(&flusher->lock);
+    
+    // Final drain after stop - nothing published before stop is lost
+    nlink_flusher_drain(flusher);
+    return NULL;
+}
+
+/**
+ * Start a flusher draining into the journal
+ * The flusher becomes the journal's only writer while it runs.
+ */
+nlink_flusher_t* nlink_flusher_start(nlink_journal_t* journal, const nlink_flusher_config_t* config) {
+    uint32_t capacity = config->thread_ring_capacity;
+    if (!journal || capacity == 0 || (capacity & (capacity - 1)) != 0) return NULL;
+    
+    nlink_flusher_t* flusher = nlink_calloc(NLINK_MEM_MISC, 1, sizeof(nlink_flusher_t));
+    if (!flusher) return NULL;
+    
+    flusher->config = *config;
+    if (flusher->config.flush_interval_ms == 0) {
+        flusher->config.flush_interval_ms = 1;
+    }
+    flusher->journal = journal;
+    flusher->generation = atomic_fetch_add(&nlink_flusher_generations, 1);
+    flusher->batch = nlink_malloc(NLINK_MEM_EVENTS, NLINK_FLUSH_BATCH * sizeof(nlink_consciousness_event_t));
+    pthread_mutex_init(&flusher->lock, NULL);
+    pthread_cond_init(&flusher->wake, NULL);
+    pthread_cond_init(&flusher->drained, NULL);
+    
+    if (!flusher->batch ||
+        pthread_create(&flusher->thread, NULL, nlink_flusher_main, flusher) != 0) {
+        pthread_mutex_destroy(&flusher->lock);
+        pthread_cond_destroy(&flusher->wake);
+        pthread_cond_destroy(&flusher->drained);
+        nlink_free(NLINK_MEM_EVENTS, flusher->batch);
+        nlink_free(NLINK_MEM_MISC, flusher);
+        return NULL;
+    }
+    
+    return flusher;
+}
+
+/**
+ * Block until everything published before the call is in the journal
+ */
+void nlink_flusher_sync(nlink_flusher_t* flusher) {
+    pthread_mutex_lock(&flusher->lock);
+    uint64_t request = ++flusher->drain_requests;
+    pthread_cond_signal(&flusher->wake);
+    while (flusher->drains_completed < request && !flusher->stopping) {
+        pthread_cond_wait(&flusher->drained, &flusher->lock);
+    }
+    pthread_mutex_unlock(&flusher->lock);
+}
+
+void nlink_flusher_stats(nlink_flusher_t* flusher, nlink_flusher_stats_t* stats) {
+    stats->events_published = atomic_load(&flusher->events_published);
+    stats->events_flushed = atomic_load(&flusher->events_flushed);
+    stats->events_dropped = atomic_load(&flusher->events_dropped);
+    stats->producer_waits = atomic_load(&flusher->producer_waits);
+    stats->flushes = atomic_load(&flusher->flushes);
+    stats->pending_events = stats->events_published > stats->events_flushed
+                          ? stats->events_published - stats->events_flushed : 0;
+    stats->last_lag_ns = atomic_load(&flusher->last_lag_ns);
+    stats->max_lag_ns = atomic_load(&flusher->max_lag_ns);
+}
+
+/**
+ * Stop the thread after a final drain and release the thread rings
+ * Linking threads must have stopped publishing to this flusher.
+ */
+void nlink_flusher_stop(nlink_flusher_t* flusher) {
+    if (!flusher) return;
+    
+    pthread_mutex_lock(&flusher->lock);
+    flusher->stopping = true;
+    pthread_cond_signal(&flusher->wake);
+    pthread_mutex_unlock(&flusher->lock);
+    pthread_join(flusher->thread, NULL);
+    
+    for (size_t i = 0; i < flusher->ring_count; i++) {
+        nlink_free(NLINK_MEM_EVENTS, flusher->rings[i]->events);
+        nlink_free(NLINK_MEM_EVENTS, flusher->rings[i]);
+    }
+    nlink_free(NLINK_MEM_EVENTS, flusher->rings);
+    nlink_free(NLINK_MEM_EVENTS, flusher->batch);
+    pthread_mutex_destroy(&flusher->lock);
+    pthread_cond_destroy(&flusher->wake);
+    pthread_cond_destroy(&flusher->drained);
+    nlink_free(NLINK_MEM_MISC, flusher);
+}
+
+// === COMPONENT ID INDEX ===
+
+#define NLINK_ID_ABSENT      UINT32_MAX
+#define NLINK_ID_DENSE_SLACK 1024   // Ids below 2 * count + slack stay in the dense table
+
+static inline bool nlink_id_map_fits_dense(const nlink_id_map_t* map, uint32_t id) {
+    return (uint64_t)id < 2 * (uint64_t)(map->count + 1) + NLINK_ID_DENSE_SLACK;
+}
+
+static inline size_t nlink_id_map_slot(const nlink_id_map_t* map, uint32_t id) {
+    return nlink_edge_key_hash(id, 0, 0) & map->mask;
+}
+
+static int nlink_id_map_rehash(nlink_id_map_t* map, size_t capacity) {
+    uint64_t* slots = nlink_large_alloc(NLINK_MEM_INDICES, capacity * sizeof(uint64_t));
+    if (!slots) return -1;
+    
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i <= map->mask && map->slots; i++) {
+        uint64_t entry = map->slots[i];
+        if (!(uint32_t)entry) continue;
+        size_t slot = nlink_edge_key_hash((uint32_t)(entry >> 32), 0, 0) & mask;
+        while ((uint32_t)slots[slot]) slot = (slot + 1) & mask;
+        slots[slot] = entry;
+    }
+    
+    nlink_large_free(NLINK_MEM_INDICES, map->slots);
+    map->slots = slots;
+    map->mask = mask;
+    return 0;
+}
+
+// Sparse id space - move every dense entry into the hash, for good
+static int nlink_id_map_convert(nlink_id_map_t* map) {
+    size_t capacity = 64;
+    while (capacity < (map->count + 1) * 2) capacity *= 2;
+    
+    uint32_t* dense = map->dense;
+    size_t length = map->dense_length;
+    map->slots = NULL;
+    map->mask = 0;
+    if (nlink_id_map_rehash(map, capacity) != 0) return -1;
+    
+    for (size_t id = 0; id < length; id++) {
+        if (!dense[id]) continue;
+        size_t slot = nlink_id_map_slot(map, (uint32_t)id);
+        while ((uint32_t)map->slots[slot]) slot = (slot + 1) & map->mask;
+        map->slots[slot] = ((uint64_t)id << 32) | dense[id];
+    }
+    
+    nlink_large_free(NLINK_MEM_INDICES, dense);
+    map->dense = NULL;
+    map->dense_length = 0;
+    map->hashed = true;
+    return 0;
+}
+
+/**
+ * Map id -> value (value < NLINK_ID_ABSENT); a repeated id is overwritten
+ */
+int nlink_id_map_put(nlink_id_map_t* map, uint32_t id, uint32_t value) {
+    if (!map->hashed && !nlink_id_map_fits_dense(map, id) && nlink_id_map_convert(map) != 0) {
+        return -1;
+    }
+    
+    if (!map->hashed) {
+        if (id >= map->dense_length) {
+            size_t length = map->dense_length ? map->dense_length : 64;
+            while (length <= id) length *= 2;
+            uint32_t* dense = nlink_large_realloc(NLINK_MEM_INDICES, map->dense,
+                                                  length * sizeof(uint32_t));
+            if (!dense) return -1;
+            map->dense = dense;
+            map->dense_length = length;
+        }
+        if (!map->dense[id]) map->count++;
+        map->dense[id] = value + 1;
+        return 0;
+    }
+    
+    if ((map->count + 1) * 2 > map->mask + 1 &&
+        nlink_id_map_rehash(map, (map->mask + 1) * 2) != 0) {
+        return -1;
+    }
+    size_t slot = nlink_id_map_slot(map, id);
+    while ((uint32_t)map->slots[slot] && (uint32_t)(map->slots[slot] >> 32) != id) {
+        slot = (slot + 1) & map->mask;
+    }
+    if (!(uint32_t)map->slots[slot]) map->count++;
+    map->slots[slot] = ((uint64_t)id << 32) | (value + 1);
+    return 0;
+}
+
+static inline uint32_t nlink_id_map_get(const nlink_id_map_t* map, uint32_t id) {
+    if (!map->hashed) {
+        return id < map->dense_length ? map->dense[id] - 1 : NLINK_ID_ABSENT;
+    }
+    if (!map->slots) return NLINK_ID_ABSENT;
+    
+    size_t slot = nlink_id_map_slot(map, id);
+    while ((uint32_t)map->slots[slot]) {
+        if ((uint32_t)(map->slots[slot] >> 32) == id) {
+            return (uint32_t)map->slots[slot] - 1;
+        }
+        slot = (slot + 1) & map->mask;
+    }
+    return NLINK_ID_ABSENT;
+}
+
+/**
+ * Drop id only while it still maps to value (a newer component may own it)
+ */
+void nlink_id_map_remove(nlink_id_map_t* map, uint32_t id, uint32_t value) {
+    if (value == NLINK_ID_ABSENT || nlink_id_map_get(map, id) != value) return;
+    map->count--;
+    
+    if (!map->hashed) {
+        map->dense[id] = 0;
+        return;
+    }
+    
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    size_t hole = nlink_id_map_slot(map, id);
+    while ((uint32_t)(map->slots[hole] >> 32) != id) hole = (hole + 1) & map->mask;
+    
+    for (size_t next = (hole + 1) & map->mask; (uint32_t)map->slots[next];
+         next = (next + 1) & map->mask) {
+        size_t home = nlink_id_map_slot(map, (uint32_t)(map->slots[next] >> 32));
+        bool movable = hole <= next ? (home <= hole || home > next)
+                                    : (home <= hole && home > next);
+        if (movable) {
+            map->slots[hole] = map->slots[next];
+            hole = next;
+        }
+    }
+    map->slots[hole] = 0;
+}
+
+void nlink_id_map_release(nlink_id_map_t* map) {
+    nlink_large_free(NLINK_MEM_INDICES, map->dense);
+    nlink_large_free(NLINK_MEM_INDICES, map->slots);
+    memset(map, 0, sizeof(*map));
+}
+
+// === COMPONENT REGISTRY ===
+
+nlink_component_registry_t* nlink_registry_create(void) {
+    return nlink_calloc(NLINK_MEM_COMPONENTS, 1, sizeof(nlink_component_registry_t));
+}
+
+/**
+ * Hand out a handle - freed slots first, then the end of the table
+ */
+static nlink_handle_t nlink_registry_acquire_handle(nlink_component_registry_t* registry) {
+    if (registry->free_handle_count > 0) {
+        return registry->free_handles[--registry->free_handle_count];
+    }
+    
+    if (registry->handle_count == 0) {
+        registry->handle_count = 1;   // Reserve NLINK_HANDLE_NONE
+    }
+    if (registry->handle_count >= registry->handle_capacity) {
+        uint32_t capacity = registry->handle_capacity ? registry->handle_capacity * 2 : 16;
+        nlink_component_t** handles = nlink_large_realloc(NLINK_MEM_INDICES, registry->handles,
+                                                          capacity * sizeof(nlink_component_t*));
+        if (!handles) return NLINK_HANDLE_NONE;
+        registry->handles = handles;
+        
+        uint32_t* free_handles = nlink_large_realloc(NLINK_MEM_INDICES, registry->free_handles,
+                                                     capacity * sizeof(uint32_t));
+        if (!free_handles) return NLINK_HANDLE_NONE;
+        registry->free_handles = free_handles;
+        registry->handle_capacity = capacity;
+    }
+    return registry->handle_count++;
+}
+
+void nlink_registry_release_handle(nlink_component_registry_t* registry, nlink_component_t* comp) {
+    if (comp->handle == NLINK_HANDLE_NONE || registry->handles[comp->handle] != comp) return;
+    nlink_id_map_remove(&registry->id_index, comp->id, comp->handle);
+    registry->handles[comp->handle] = NULL;
+    registry->free_handles[registry->free_handle_count++] = comp->handle;
+    comp->handle = NLINK_HANDLE_NONE;
+}
+
+static inline nlink_component_t* nlink_registry_component(const nlink_component_registry_t* registry,
+                                                          nlink_handle_t handle) {
+    // The reserved slot is never written, so NLINK_HANDLE_NONE must not be read
+    return handle != NLINK_HANDLE_NONE && handle < registry->handle_count
+         ? registry->handles[handle] : NULL;
+}
+
+/**
+ * Follow an edge by handle - a recycled slot is caught by the id check
+ */
+nlink_component_t* nlink_edge_callee(const nlink_component_registry_t* registry,
+                                     const nlink_invocation_edge_t* edge) {
+    nlink_component_t* callee = nlink_registry_component(registry, edge->callee_handle);
+    return callee && callee->id == edge->callee_id ? callee : NULL;
+}
+
+/**
+ * Component by id in O(1) - NULL when no registered component has the id
+ */
+nlink_component_t* nlink_registry_find(const nlink_component_registry_t* registry, uint32_t id) {
+    uint32_t handle = nlink_id_map_get(&registry->id_index, id);
+    return handle == NLINK_ID_ABSENT ? NULL : nlink_registry_component(registry, handle);
+}
+
+nlink_component_t* nlink_component_canonical(nlink_component_t* comp) {
+    if (comp->is_canonical) return comp;
+    return comp->registry ? nlink_registry_component(comp->registry, comp->canonical_form) : NULL;
+}
+
+/**
+ * Register a component - the registry takes ownership
+ */
+int nlink_registry_add(nlink_component_registry_t* registry, nlink_component_t* comp) {
+    nlink_handle_t handle = nlink_registry_acquire_handle(registry);
+    if (handle == NLINK_HANDLE_NONE) return -1;
+    
+    if (registry->component_count == registry->capacity) {
+        size_t capacity = registry->capacity ? registry->capacity * 2 : 16;
+        nlink_component_t** components = nlink_realloc(NLINK_MEM_COMPONENTS, registry->components,
+                                                 capacity * sizeof(nlink_component_t*));
+        if (!components) {
+            registry->free_handles[registry->free_handle_count++] = handle;
+            return -1;
+        }
+        registry->components = components;
+        registry->capacity = capacity;
+    }
+    
+    if (nlink_id_map_put(&registry->id_index, comp->id, handle) != 0) {
+        registry->free_handles[registry->free_handle_count++] = handle;
+        return -1;
+    }
+    
+    registry->handles[handle] = comp;
+    comp->handle = handle;
+    comp->registry = registry;
+    registry->components[registry->component_count++] = comp;
+    if (comp->id > registry->max_id) registry->max_id = comp->id;
+    return 0;
+}
+
+/**
+ * An id no component of this registry has had - ids are never reused,
+ * however components were registered or removed
+ */
+uint32_t nlink_registry_next_id(nlink_component_registry_t* registry) {
+    return registry->max_id + 1;
+}
+
+/**
+ * Create a component in the registry arena and register it
+ */
+nlink_component_t* nlink_registry_create_component_n(nlink_component_registry_t* registry,
+                                                     uint32_t id, const char* semantic_anchor,
+                                                     size_t anchor_length) {
+    nlink_component_t* comp = nlink_component_create_n(&registry->arena, id, semantic_anchor,
+                                                       anchor_length);
+    if (!comp || nlink_registry_add(registry, comp) != 0) return NULL;
+    return comp;
+}
+
+nlink_component_t* nlink_registry_create_component(nlink_component_registry_t* registry,
+                                                   uint32_t id, const char* semantic_anchor) {
+    return nlink_registry_create_component_n(registry, id, semantic_anchor,
+                                             semantic_anchor ? strlen(semantic_anchor) : 0);
+}
+
+/**
+ * Attach the persistence layer - destroyed components serialize their
+ * consciousness buffers into this journal
+ * Event sequences continue after the last one journaled by earlier runs.
+ */
+int nlink_registry_attach_journal(nlink_component_registry_t* registry, const char* path) {
+    nlink_journal_t* journal = nlink_journal_open(path);
+    if (!journal) return -1;
+    
+    nlink_journal_close(registry->journal);
+    registry->journal = journal;
+    
+    uint64_t next = journal->record_count ? journal->max_sequence + 1 : 0;
+    uint64_t current = atomic_load_explicit(&registry->event_sequence, memory_order_relaxed);
+    while (current < next &&
+           !atomic_compare_exchange_weak_explicit(&registry->event_sequence, &current, next,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+    return 0;
+}
+
+/**
+ * Move journal writes off the linking threads
+ * Requires an attached journal; events are journaled as they happen
+ * rather than when components are destroyed.
+ */
+int nlink_registry_start_flusher(nlink_component_registry_t* registry,
+                                 const nlink_flusher_config_t* config) {
+    if (!registry->journal || registry->flusher) return -1;
+    
+    registry->flusher = nlink_flusher_start(registry->journal, config);
+    if (!registry->flusher) return -1;
+    
+    registry->journal_streamed = true;
+    return 0;
+}
+
+/**
+ * Switch the event sampling policy - safe while linking threads run
+ */
+void nlink_registry_set_sampling(nlink_component_registry_t* registry,
+                                 const nlink_sampling_policy_t* policy) {
+    atomic_store_explicit(&registry->sampling_parameter, policy->parameter,
+                          memory_order_relaxed);
+    atomic_store_explicit(&registry->sampling_mode, policy->mode, memory_order_relaxed);
+}
+
+void nlink_registry_sampling_stats(nlink_component_registry_t* registry,
+                                   nlink_sampling_stats_t* stats) {
+    stats->events_observed = atomic_load(&registry->events_observed);
+    stats->events_recorded = atomic_load(&registry->events_recorded);
+    stats->effective_rate = stats->events_observed
+                          ? (double)stats->events_recorded / stats->events_observed : 1.0;
+}
+
+/**
+ * Destroy every component (flushing link history) and the registry
+ */
+int nlink_registry_destroy(nlink_component_registry_t* registry) {
+    if (!registry) return 0;
+    
+    // Drain outstanding events before the components go away
+    nlink_flusher_stop(registry->flusher);
+    registry->flusher = NULL;
+    
+    for (size_t i = 0; i < registry->component_count; i++) {
+        nlink_component_destroy(registry->components[i]);
+    }
+    nlink_free(NLINK_MEM_COMPONENTS, registry->components);
+    nlink_large_free(NLINK_MEM_INDICES, registry->handles);
+    nlink_large_free(NLINK_MEM_INDICES, registry->free_handles);
+    nlink_id_map_release(&registry->id_index);
+    nlink_arena_release(&registry->arena);
+    
+    int result = nlink_journal_close(registry->journal);
+    nlink_free(NLINK_MEM_COMPONENTS, registry);
+    return result;
+}
+
+// === RANKED RESOLUTION ===
+
+typedef enum {
+    NLINK_RANK_ACTIVATION,        // Rank by residue activation
+    NLINK_RANK_SEMANTIC_WEIGHT    // Rank by existing edge weight, activation otherwise
+} nlink_rank_key_t;
+
+typedef struct {
+    nlink_rank_key_t rank_by;
+    float activation_threshold;   // Candidates must exceed this (0.5 matches first-match)
+    bool link_best;               // Create an indirect edge to the top candidate
+} nlink_resolve_options_t;
+
+// One residue carrying an anchor, located by component position and residue slot
+typedef struct {
+    uint32_t hash;
+    uint32_t component_index;
+    uint32_t residue_index;
+} nlink_anchor_posting_t;
+
+// Anchor -> component index over a component array, postings sorted by hash then position
+typedef struct {
+    nlink_component_t** components;
+    size_t component_count;
+    nlink_anchor_posting_t* postings;
+    size_t posting_count;
+} nlink_anchor_index_t;
+
+typedef struct {
+    uint32_t component_id;
+    uint32_t registry_index;
+    float activation;
+    float score;
+} nlink_resolve_candidate_t;
+
+/**
+ * Candidate ordering - higher score first, lower id breaks ties so the
+ * ranking never depends on registry order
+ */
+static inline bool nlink_candidate_better(const nlink_resolve_candidate_t* a,
+                                          const nlink_resolve_candidate_t* b) {
+    if (a->score != b->score) {
+        return a->score > b->score;
+    }
+    return a->component_id < b->component_id;
+}
+
+/**
+ * Bounded min-heap sift-down: heap[0] is the worst retained candidate
+ */
+static void nlink_candidate_sift_down(nlink_resolve_candidate_t* heap, size_t count, size_t i) {
+    while (true) {
+        size_t worst = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        
+        if (left < count && nlink_candidate_better(&heap[worst], &heap[left])) {
+            worst = left;
+        }
+        if (right < count && nlink_candidate_better(&heap[worst], &heap[right])) {
+            worst = right;
+        }
+        if (worst == i) return;
+        
+        nlink_resolve_candidate_t tmp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = tmp;
+        i = worst;
+    }
+}
+
+static void nlink_candidate_offer(nlink_resolve_candidate_t* heap, size_t* count, size_t k,
+                                  const nlink_resolve_candidate_t* candidate) {
+    if (*count < k) {
+        // Sift up
+        size_t i = (*count)++;
+        heap[i] = *candidate;
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!nlink_candidate_better(&heap[parent], &heap[i])) break;
+            nlink_resolve_candidate_t tmp = heap[i];
+            heap[i] = heap[parent];
+            heap[parent] = tmp;
+            i = parent;
+        }
+    } else if (nlink_candidate_better(candidate, &heap[0])) {
+        heap[0] = *candidate;
+        nlink_candidate_sift_down(heap, *count, 0);
+    }
+}
+
+static int nlink_anchor_posting_compare(const void* a, const void* b) {
+    const nlink_anchor_posting_t* x = a;
+    const nlink_anchor_posting_t* y = b;
+    if (x->hash != y->hash) return (x->hash > y->hash) - (x->hash < y->hash);
+    if (x->component_index != y->component_index) {
+        return (x->component_index > y->component_index) - (x->component_index < y->component_index);
+    }
+    return (x->residue_index > y->residue_index) - (x->residue_index < y->residue_index);
+}
+
+/**
+ * Index every residue anchor of components[0..count)
+ * The index refers to the array and the residues in place, so rebuild it
+ * after components or residues are added, merged or destroyed.
+ */
+int nlink_anchor_index_build(nlink_anchor_index_t* index, nlink_component_t** components,
+                             size_t count) {
+    memset(index, 0, sizeof(*index));
+    size_t postings = 0;
+    for (size_t i = 0; i < count; i++) {
+        postings += components[i]->residue_count;
+    }
+    
+    index->postings = nlink_malloc(NLINK_MEM_INDICES, (postings ? postings : 1) * sizeof(nlink_anchor_posting_t));
+    if (!index->postings) return -1;
+    
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < components[i]->residue_count; j++) {
+            index->postings[index->posting_count++] = (nlink_anchor_posting_t){
+                .hash = components[i]->residues[j].perceptual_anchor.hash,
+                .component_index = (uint32_t)i,
+                .residue_index = (uint32_t)j
+            };
+        }
+    }
+    qsort(index->postings, index->posting_count, sizeof(nlink_anchor_posting_t),
+          nlink_anchor_posting_compare);
+    index->components = components;
+    index->component_count = count;
+    return 0;
+}
+
+void nlink_anchor_index_release(nlink_anchor_index_t* index) {
+    nlink_free(NLINK_MEM_INDICES, index->postings);
+    memset(index, 0, sizeof(*index));
+}
+
+/**
+ * First posting whose hash is not below the key's - the run sharing the
+ * hash follows it, in component order
+ */
+static size_t nlink_anchor_index_lower_bound(const nlink_anchor_index_t* index, uint32_t hash) {
+    size_t low = 0, high = index->posting_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (index->postings[mid].hash < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * Ranked multi-candidate resolution
+ * Looks the target up in the anchor index and evaluates every component
+ * carrying it that clears the activation threshold, retaining the top-k
+ * in a bounded heap. Every match is scored, so the result depends only on
+ * scores and ids, never on registry order.
+ * Results are written to out[] best-first; returns the count.
+ */
+size_t nlink_resolve_ranked(nlink_component_t* source,
+                            const char* symbolic_target,
+                            const nlink_anchor_index_t* index,
+                            const nlink_resolve_options_t* options,
+                            nlink_resolve_candidate_t* out,
+                            size_t k) {
+    if (k == 0) return 0;
+    uint64_t trace_start = nlink_trace_begin(NLINK_TRACE_RESOLVE);
+    
+    // Transition to witness phase for consciousness preservation
+    nlink_component_phase_t original_phase = source->phase;
+    source->phase = NLINK_COMPONENT_WITNESS;
+    uint64_t witness_start = nlink_trace_begin(NLINK_TRACE_COMPONENT_PHASE);
+    
+    nlink_anchor_t target_key = nlink_anchor_borrow(symbolic_target);
+    size_t count = 0;
+    size_t p = nlink_anchor_index_lower_bound(index, target_key.hash);
+    
+    while (p < index->posting_count && index->postings[p].hash == target_key.hash) {
+        uint32_t position = index->postings[p].component_index;
+        nlink_component_t* candidate = index->components[position];
+        bool matched = false;
+        float best_activation = 0.0f;
+        
+        // A merged canonical form may carry the anchor more than once - its postings are adjacent
+        for (; p < index->posting_count && index->postings[p].hash == target_key.hash &&
+               index->postings[p].component_index == position; p++) {
+            nlink_symbolic_residue_t* residue = &candidate->residues[index->postings[p].residue_index];
+            if (!residue->activation_fn ||
+                !nlink_anchor_equal(&residue->perceptual_anchor, &target_key)) {
+                continue;
+            }
+            
+            float activation = residue->activation_fn(residue->contextual_frame);
+            if (activation > options->activation_threshold &&
+                (!matched || activation > best_activation)) {
+                best_activation = activation;
+                matched = true;
+            }
+        }
+        
+        if (!matched) continue;
+        
+        nlink_resolve_candidate_t entry = {
+            .component_id = candidate->id,
+            .registry_index = position,
+            .activation = best_activation,
+            .score = best_activation
+        };
+        
+        if (options->rank_by == NLINK_RANK_SEMANTIC_WEIGHT) {
+            nlink_invocation_edge_t* edge = nlink_find_edge(source, candidate->id, INDIRECT);
+            if (edge) {
+                entry.score = edge->semantic_weight;
+            }
+        }
+        
+        nlink_candidate_offer(out, &count, k, &entry);
+    }
+    
+    // Heap-sort in place: repeatedly moving the worst to the back leaves best-first
+    for (size_t end = count; end > 1; end--) {
+        nlink_resolve_candidate_t tmp = out[0];
+        out[0] = out[end - 1];
+        out[end - 1] = tmp;
+        nlink_candidate_sift_down(out, end - 1, 0);
+    }
+    
+    // Restore original phase (witnessing complete)
+    source->phase = original_phase;
+    nlink_trace_end(NLINK_TRACE_COMPONENT_PHASE, "WITNESS", source->id, witness_start);
+    
+    if (count == 0) {
+        source->qa_metrics.true_negative_skips++;
+        nlink_trace_end(NLINK_TRACE_RESOLVE, "resolve_ranked", source->id, trace_start);
+        return 0;
+    }
+    
+    source->qa_metrics.true_positive_links++;
+    
+    if (options->link_best) {
+        nlink_create_indirect_edge(source, index->components[out[0].registry_index],
+                                   out[0].activation);
+    }
+    
+    nlink_trace_end(NLINK_TRACE_RESOLVE, "resolve_ranked", source->id, trace_start);
+    return count;
+}
+
+// === TRANSITIVE CLOSURE ENGINE ===
+
+/**
+ * Component -> position in a component array, for graph passes
+ * Registered universes resolve through the registry's id index and edge
+ * handles in O(1); loose component arrays get a private id map.
+ */
+typedef struct {
+    const nlink_component_registry_t* registry;   // Handle mode when set
+    uint32_t* index_of_handle;
+    size_t handle_count;
+    nlink_id_map_t by_id;         // id -> array index without a registry
+    size_t count;
+} nlink_component_index_t;
+
+static void nlink_component_index_release(nlink_component_index_t* index) {
+    nlink_free(NLINK_MEM_INDICES, index->index_of_handle);
+    nlink_id_map_release(&index->by_id);
+    index->index_of_handle = NULL;
+}
+
+static int nlink_component_index_build(nlink_component_index_t* index,
+                                       nlink_component_t** component_registry,
+                                       size_t registry_size) {
+    memset(index, 0, sizeof(*index));
+    index->count = registry_size;
+    
+    const nlink_component_registry_t* registry =
+        registry_size ? component_registry[0]->registry : NULL;
+    for (size_t i = 0; i < registry_size && registry; i++) {
+        if (component_registry[i]->registry != registry) registry = NULL;
+    }
+    
+    if (registry) {
+        index->registry = registry;
+        index->handle_count = registry->handle_count;
+        index->index_of_handle = nlink_malloc(NLINK_MEM_INDICES,
+                                              (index->handle_count + 1) * sizeof(uint32_t));
+        if (!index->index_of_handle) return -1;
+        memset(index->index_of_handle, 0xFF, (index->handle_count + 1) * sizeof(uint32_t));
+        for (size_t i = 0; i < registry_size; i++) {
+            index->index_of_handle[component_registry[i]->handle] = (uint32_t)i;
+        }
+        return 0;
+    }
+    
+    for (size_t i = 0; i < registry_size; i++) {
+        if (nlink_id_map_put(&index->by_id, component_registry[i]->id, (uint32_t)i) != 0) {
+            nlink_component_index_release(index);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Returns count when the id is not part of the array
+static size_t nlink_component_index_of_id(const nlink_component_index_t* index, uint32_t id) {
+    uint32_t position = NLINK_ID_ABSENT;
+    if (index->registry) {
+        uint32_t handle = nlink_id_map_get(&index->registry->id_index, id);
+        if (handle < index->handle_count) position = index->index_of_handle[handle];
+    } else {
+        position = nlink_id_map_get(&index->by_id, id);
+    }
+    return position == NLINK_ID_ABSENT ? index->count : position;
+}
+
+static size_t nlink_component_index_of_edge(const nlink_component_index_t* index,
+                                            const nlink_invocation_edge_t* edge) {
+    if (index->registry && edge->callee_handle < index->handle_count &&
+        nlink_edge_callee(index->registry, edge)) {
+        uint32_t position = index->index_of_handle[edge->callee_handle];
+        return position == NLINK_ID_ABSENT ? index->count : position;
+    }
+    return nlink_component_index_of_id(index, edge->callee_id);
+}
+
+/**
+ * Reachability over the condensed component DAG
+ * Every SCC owns one bitset over registry indices; a link_target's full
+ * dependency set is the union of its roots' bitsets.
+ */
+typedef struct {
+    size_t component_count;
+    size_t words_per_set;         // 64-bit words per reachability bitset
+    size_t scc_count;
+    uint32_t* scc_of;             // Registry index -> SCC (reverse topological)
+    uint64_t* closure_bits;       // scc_count * words_per_set, reflexive
+    size_t bits_capacity;         // SCC bitsets allocated so far
+    nlink_component_index_t index;   // Component id -> registry index
+} nlink_closure_t;
+
+/**
+ * Component id -> registry index in O(1)
+ * Returns component_count when the id is not part of the closure
+ */
+size_t nlink_closure_index_of(const nlink_closure_t* closure, uint32_t id) {
+    return nlink_component_index_of_id(&closure->index, id);
+}
+
+void nlink_closure_destroy(nlink_closure_t* closure) {
+    if (!closure) return;
+    
+    nlink_free(NLINK_MEM_INDICES, closure->scc_of);
+    nlink_large_free(NLINK_MEM_INDICES, closure->closure_bits);
+    nlink_component_index_release(&closure->index);
+    nlink_free(NLINK_MEM_INDICES, closure);
+}
+
+/**
+ * Build the closure: CSR adjacency, iterative Tarjan SCC condensation,
+ * then word-parallel bitset unions as each SCC completes. Tarjan emits
+ * SCCs in reverse topological order, so every successor's closure is
+ * final by the time its predecessors merge it.
+ */
+nlink_closure_t* nlink_closure_build(nlink_component_t** component_registry,
+                                     size_t registry_size) {
+    nlink_closure_t* closure = nlink_calloc(NLINK_MEM_INDICES, 1, sizeof(nlink_closure_t));
+    if (!closure) return NULL;
+    
+    size_t n = registry_size;
+    closure->component_count = n;
+    closure->words_per_set = (n + 63) / 64;
+    
+    closure->scc_of = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    if (!closure->scc_of ||
+        nlink_component_index_build(&closure->index, component_registry, n) != 0) {
+        nlink_closure_destroy(closure);
+        return NULL;
+    }
+    
+    // CSR adjacency over registry indices (edges to unknown ids are ignored)
+    size_t edge_total = 0;
+    for (size_t i = 0; i < n; i++) {
+        edge_total += component_registry[i]->edge_count;
+    }
+    
+    uint32_t* offsets = nlink_large_alloc(NLINK_MEM_INDICES, (n + 1) * sizeof(uint32_t));
+    uint32_t* targets = nlink_large_alloc(NLINK_MEM_INDICES,
+                                          (edge_total ? edge_total : 1) * sizeof(uint32_t));
+    
+    // Tarjan working state
+    uint32_t* order = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    uint32_t* lowlink = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    uint32_t* scc_stack = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    uint32_t* call_node = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    uint32_t* call_edge = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    bool* on_stack = nlink_calloc(NLINK_MEM_INDICES, n ? n : 1, sizeof(bool));
+    
+    if (!offsets || !targets || !order || !lowlink || !scc_stack ||
+        !call_node || !call_edge || !on_stack) {
+        goto fail;
+    }
+    
+    size_t fill = 0;
+    for (size_t i = 0; i < n; i++) {
+        offsets[i] = (uint32_t)fill;
+        const nlink_component_t* comp = component_registry[i];
+        for (size_t e = 0; e < comp->edge_count; e++) {
+            size_t callee = nlink_component_index_of_edge(&closure->index, &comp->edges[e]);
+            if (callee < n) {
+                targets[fill++] = (uint32_t)callee;
+            }
+        }
+    }
+    offsets[n] = (uint32_t)fill;
+    
+    const uint32_t UNVISITED = UINT32_MAX;
+    for (size_t i = 0; i < n; i++) {
+        order[i] = UNVISITED;
+        closure->scc_of[i] = UNVISITED;
+    }
+    
+    uint32_t next_order = 0;
+    size_t stack_top = 0;
+    size_t words = closure->words_per_set;
+    
+    for (size_t root = 0; root < n; root++) {
+        if (order[root] != UNVISITED) continue;
+        
+        size_t depth = 0;
+        call_node[0] = (uint32_t)root;
+        call_edge[0] = offsets[root];
+        order[root] = lowlink[root] = next_order++;
+        scc_stack[stack_top++] = (uint32_t)root;
+        on_stack[root] = true;
+        
+        while (true) {
+            uint32_t v = call_node[depth];
+            
+            if (call_edge[depth] < offsets[v + 1]) {
+                uint32_t w = targets[call_edge[depth]++];
+                if (order[w] == UNVISITED) {
+                    // Descend
+                    depth++;
+                    call_node[depth] = w;
+                    call_edge[depth] = offsets[w];
+                    order[w] = lowlink[w] = next_order++;
+                    scc_stack[stack_top++] = w;
+                    on_stack[w] = true;
+                } else if (on_stack[w] && order[w] < lowlink[v]) {
+                    lowlink[v] = order[w];
+                }
+                continue;
+            }
+            
+            // All successors of v explored - emit an SCC if v is its root
+            if (lowlink[v] == order[v]) {
+                // Bitsets grow with the SCCs actually found - cycles shrink the matrix
+                if (closure->scc_count == closure->bits_capacity) {
+                    size_t capacity = closure->bits_capacity ? closure->bits_capacity * 2 : 64;
+                    if (capacity > n) capacity = n;
+                    uint64_t* grown = nlink_large_realloc(NLINK_MEM_INDICES, closure->closure_bits,
+                                                          capacity * words * sizeof(uint64_t));
+                    if (!grown) goto fail;
+                    closure->closure_bits = grown;
+                    closure->bits_capacity = capacity;
+                }
+                uint32_t scc = (uint32_t)closure->scc_count++;
+                uint64_t* bits = &closure->closure_bits[scc * words];
+                size_t member_start = stack_top;
+                
+                do {
+                    member_start--;
+                    uint32_t m = scc_stack[member_start];
+                    on_stack[m] = false;
+                    closure->scc_of[m] = scc;
+                    bits[m / 64] |= 1ULL << (m % 64);
+                } while (scc_stack[member_start] != v);
+                
+                // Union successor closures (all already final)
+                for (size_t s = member_start; s < stack_top; s++) {
+                    uint32_t m = scc_stack[s];
+                    for (uint32_t e = offsets[m]; e < offsets[m + 1]; e++) {
+                        uint32_t succ = closure->scc_of[targets[e]];
+                        if (succ == scc) continue;
+                        const uint64_t* succ_bits = &closure->closure_bits[succ * words];
+                        for (size_t k = 0; k < words; k++) {
+                            bits[k] |= succ_bits[k];
+                        }
+                    }
+                }
+                stack_top = member_start;
+            }
+            
+            if (depth == 0) break;
+            
+            // Return to caller
+            depth--;
+            uint32_t parent = call_node[depth];
+            if (lowlink[v] < lowlink[parent]) {
+                lowlink[parent] = lowlink[v];
+            }
+        }
+    }
+    
+    nlink_large_free(NLINK_MEM_INDICES, offsets);
+    nlink_large_free(NLINK_MEM_INDICES, targets);
+    nlink_free(NLINK_MEM_INDICES, order);
+    nlink_free(NLINK_MEM_INDICES, lowlink);
+    nlink_free(NLINK_MEM_INDICES, scc_stack);
+    nlink_free(NLINK_MEM_INDICES, call_node);
+    nlink_free(NLINK_MEM_INDICES, call_edge);
+    nlink_free(NLINK_MEM_INDICES, on_stack);
+    return closure;
+    
+fail:
+    nlink_large_free(NLINK_MEM_INDICES, offsets);
+    nlink_large_free(NLINK_MEM_INDICES, targets);
+    nlink_free(NLINK_MEM_INDICES, order);
+    nlink_free(NLINK_MEM_INDICES, lowlink);
+    nlink_free(NLINK_MEM_INDICES, scc_stack);
+    nlink_free(NLINK_MEM_INDICES, call_node);
+    nlink_free(NLINK_MEM_INDICES, call_edge);
+    nlink_free(NLINK_MEM_INDICES, on_stack);
+    nlink_closure_destroy(closure);
+    return NULL;
+}
+
+/**
+ * Reachability bitset of one component (includes the component itself)
+ */
+const uint64_t* nlink_closure_set(const nlink_closure_t* closure, size_t registry_index) {
+    return &closure->closure_bits[closure->scc_of[registry_index] * closure->words_per_set];
+}
+
+bool nlink_closure_reaches(const nlink_closure_t* closure, size_t from_index, size_t to_index) {
+    const uint64_t* bits = nlink_closure_set(closure, from_index);
+    return (bits[to_index / 64] >> (to_index % 64)) & 1;
+}
+
+#define NLINK_LINK_TARGET_PRINT_MAX 16   // Targets listed by name; the rest only count
+
+/**
+ * link_target dependency set: union of every root's closure
+ * out_bits must hold words_per_set words; returns the member count
+ */
+size_t nlink_link_target_closure(const nlink_closure_t* closure,
+                                 const uint32_t* root_ids, size_t root_count,
+                                 uint64_t* out_bits) {
+    size_t words = closure->words_per_set;
+    memset(out_bits, 0, words * sizeof(uint64_t));
+    
+    for (size_t r = 0; r < root_count; r++) {
+        size_t index = nlink_closure_index_of(closure, root_ids[r]);
+        if (index >= closure->component_count) continue;
+        
+        const uint64_t* bits = nlink_closure_set(closure, index);
+        for (size_t k = 0; k < words; k++) {
+            out_bits[k] |= bits[k];
+        }
+    }
+    
+    size_t members = 0;
+    for (size_t k = 0; k < words; k++) {
+        members += (size_t)__builtin_popcountll(out_bits[k]);
+    }
+    return members;
+}
+
+// === DEAD COMPONENT ELIMINATION ===
+
+typedef struct {
+    size_t components_before;
+    size_t components_live;
+    size_t components_swept;
+    size_t bytes_before;
+    size_t bytes_swept;           // Returned to the allocator by the sweep
+    size_t bytes_arena;           // Unreferenced, held by the registry arena until it is released
+} nlink_gc_report_t;
+
+/**
+ * Heap footprint of one component and everything it owns
+ */
+size_t nlink_component_footprint(const nlink_component_t* comp) {
+    size_t bytes = sizeof(nlink_component_t);
+    
+    nlink_event_ring_t* ring = atomic_load_explicit(
+        &((nlink_component_t*)comp)->consciousness_buffer, memory_order_acquire);
+    if (ring) {
+        bytes += nlink_event_ring_bytes(ring->capacity);
+    }
+    
+    bytes += comp->residue_count * sizeof(nlink_symbolic_residue_t);
+    for (size_t i = 0; i < comp->residue_count; i++) {
+        const nlink_anchor_t* anchor = &comp->residues[i].perceptual_anchor;
+        if (!nlink_anchor_is_inline(anchor)) {
+            bytes += anchor->length + 1;
+        }
+    }
+    
+    bytes += comp->edge_capacity * sizeof(nlink_invocation_edge_t);
+    bytes += comp->edge_set.capacity * sizeof(uint32_t);
+    
+    return bytes;
+}
+
+/**
+ * Part of the footprint that lives in the registry arena - the record,
+ * its residues and out-of-line anchors - which destroying it cannot free
+ */
+static size_t nlink_component_arena_footprint(const nlink_component_t* comp) {
+    if (!comp->arena) return 0;
+    
+    size_t bytes = sizeof(nlink_component_t) + comp->residue_count * sizeof(nlink_symbolic_residue_t);
+    for (size_t i = 0; i < comp->residue_count; i++) {
+        const nlink_anchor_t* anchor = &comp->residues[i].perceptual_anchor;
+        if (!nlink_anchor_is_inline(anchor)) {
+            bytes += anchor->length + 1;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * gc-sections for components: mark everything reachable from the
+ * declared roots (main_component, link_target entries) over the edge
+ * graph, then sweep the rest out of the registry. The registry is
+ * compacted in place, keeping the relative order of survivors.
+ */
+int nlink_eliminate_dead_components(nlink_component_registry_t* registry,
+                                    const uint32_t* root_ids, size_t root_count,
+                                    nlink_gc_report_t* report) {
+    nlink_component_t** component_registry = registry->components;
+    size_t n = registry->component_count;
+    nlink_component_index_t index;
+    uint32_t* worklist = nlink_malloc(NLINK_MEM_INDICES, (n ? n : 1) * sizeof(uint32_t));
+    uint64_t* marked = nlink_calloc(NLINK_MEM_INDICES, (n + 63) / 64 + 1, sizeof(uint64_t));
+    
+    if (!worklist || !marked ||
+        nlink_component_index_build(&index, component_registry, n) != 0) {
+        nlink_free(NLINK_MEM_INDICES, worklist);
+        nlink_free(NLINK_MEM_INDICES, marked);
+        return -1;
+    }
+    
+    // Mark phase - each component enters the worklist at most once
+    size_t pending = 0;
+    for (size_t r = 0; r < root_count; r++) {
+        size_t root = nlink_component_index_of_id(&index, root_ids[r]);
+        if (root < n && !(marked[root / 64] & (1ULL << (root % 64)))) {
+            marked[root / 64] |= 1ULL << (root % 64);
+            worklist[pending++] = (uint32_t)root;
+        }
+    }
+    
+    while (pending > 0) {
+        const nlink_component_t* comp = component_registry[worklist[--pending]];
+        
+        for (size_t e = 0; e < comp->edge_count; e++) {
+            size_t callee = nlink_component_index_of_edge(&index, &comp->edges[e]);
+            if (callee < n && !(marked[callee / 64] & (1ULL << (callee % 64)))) {
+                marked[callee / 64] |= 1ULL << (callee % 64);
+                worklist[pending++] = (uint32_t)callee;
+            }
+        }
+    }
+    
+    // Sweep phase
+    nlink_gc_report_t result = { .components_before = n };
+    size_t live = 0;
+    
+    for (size_t i = 0; i < n; i++) {
+        nlink_component_t* comp = component_registry[i];
+        size_t bytes = nlink_component_footprint(comp);
+        result.bytes_before += bytes;
+        
+        if (marked[i / 64] & (1ULL << (i % 64))) {
+            component_registry[live++] = comp;
+        } else {
+            size_t arena_bytes = nlink_component_arena_footprint(comp);
+            result.bytes_swept += bytes - arena_bytes;
+            result.bytes_arena += arena_bytes;
+            nlink_component_destroy(comp);
+        }
+    }
+    
+    result.components_live = live;
+    result.components_swept = n - live;
+    registry->component_count = live;
+    
+    if (report) {
+        *report = result;
+    }
+    
+    nlink_component_index_release(&index);
+    nlink_free(NLINK_MEM_INDICES, worklist);
+    nlink_free(NLINK_MEM_INDICES, marked);
+    return 0;
+}
+
+void nlink_gc_report_print(const nlink_gc_report_t* report) {
+    printf("GC-SECTIONS: %zu/%zu components live, %zu swept\n",
+           report->components_live, report->components_before,
+           report->components_swept);
+    printf("GC-SECTIONS: %zu of %zu bytes reclaimed (%.1f%%), %zu more unreferenced in the registry arena\n",
+           report->bytes_swept, report->bytes_before,
+           report->bytes_before ? 100.0 * report->bytes_swept / report->bytes_before : 0.0,
+           report->bytes_arena);
+}
+
+// === GLOB AUTOMATON ===
+
+#define NLINK_GLOB_MAX_EXPANSIONS  4096   // Brace alternatives per pattern
+
+typedef enum {
+    NLINK_GLOB_LITERAL,           // One byte (or byte class)
+    NLINK_GLOB_STAR,              // '*'  - any run without '/'
+    NLINK_GLOB_GLOBSTAR,          // '**' - any run, '/' included
+    NLINK_GLOB_GLOBSTAR_SLASH,    // '**/' entry - skips its loop for zero directories
+    NLINK_GLOB_DIRECTORIES        // '**/' loop - any run, left only after a '/'
+} nlink_glob_token_kind_t;
+
+/**
+ * All patterns compiled into one bit-parallel NFA
+ * Every brace alternative is a run of token positions followed by an accept
+ * position. A state set is one bit per position, so a step over one byte is
+ * a few word-wide ANDs, ORs and shifts for all patterns at once. Bytes the
+ * patterns cannot tell apart share a class, which keeps the masks small.
+ */
+typedef struct {
+    size_t pattern_count;
+    size_t pattern_words;         // uint64_t words in a match set
+    size_t position_count;
+    size_t words;                 // uint64_t words in a state set
+    size_t class_count;
+    uint8_t class_of[256];
+    uint64_t* advance;            // [class][words] - consume byte, move on
+    uint64_t* stay;               // [class][words] - consume byte, stay put
+    uint64_t* epsilon;            // Positions skippable without input
+    uint64_t* jump;               // '**/' entries, which also skip their loop
+    uint64_t* accept;             // Accept positions
+    uint64_t* universal;          // Positions accepting every non-empty path
+    uint32_t* pattern_of;         // Accept position -> pattern index
+} nlink_glob_set_t;
+
+typedef struct {
+    nlink_glob_token_kind_t kind;
+    uint64_t bytes[4];            // Byte set for NLINK_GLOB_LITERAL
+} nlink_glob_token_t;
+
+typedef struct {
+    nlink_glob_token_t* tokens;
+    size_t count;
+    size_t capacity;
+    uint32_t* patterns;           // Owning pattern per expansion
+    size_t* starts;               // First token per expansion
+    size_t expansion_count;
+    size_t expansion_capacity;
+} nlink_glob_builder_t;
+
+static inline bool nlink_glob_byte_in(const uint64_t* bytes, unsigned char c) {
+    return (bytes[c >> 6] >> (c & 63)) & 1;
+}
+
+static inline void nlink_glob_byte_add(uint64_t* bytes, unsigned char c) {
+    bytes[c >> 6] |= 1ULL << (c & 63);
+}
+
+static int nlink_glob_push_token(nlink_glob_builder_t* builder, const nlink_glob_token_t* token) {
+    if (builder->count == builder->capacity) {
+        size_t capacity = builder->capacity ? builder->capacity * 2 : 64;
+        nlink_glob_token_t* tokens = nlink_realloc(NLINK_MEM_INDICES, builder->tokens,
+                                                   capacity * sizeof(nlink_glob_token_t));
+        if (!tokens) return -1;
+        builder->tokens = tokens;
+        builder->capacity = capacity;
+    }
+    builder->tokens[builder->count++] = *token;
+    return 0;
+}
+
+/**
+ * Tokenize one brace-free pattern and close it with an accept position
+ * Supports '*', '**', '?', '[set]', '[!set]', ranges and '\' escapes.
+ */
+static int nlink_glob_tokenize(nlink_glob_builder_t* builder, const char* pattern,
+                               size_t length, uint32_t pattern_index) {
+    if (builder->expansion_count == builder->expansion_capacity) {
+        size_t capacity = builder->expansion_capacity ? builder->expansion_capacity * 2 : 16;
+        uint32_t* patterns = nlink_realloc(NLINK_MEM_INDICES, builder->patterns,
+                                           capacity * sizeof(uint32_t));
+        if (!patterns) return -1;
+        builder->patterns = patterns;
+        size_t* starts = nlink_realloc(NLINK_MEM_INDICES, builder->starts, capacity * sizeof(size_t));
+        if (!starts) return -1;
+        builder->starts = starts;
+        builder->expansion_capacity = capacity;
+    }
+    builder->patterns[builder->expansion_count] = pattern_index;
+    builder->starts[builder->expansion_count++] = builder->count;
+    
+    for (size_t i = 0; i < length; i++) {
+        nlink_glob_token_t token = { .kind = NLINK_GLOB_LITERAL };
+        char c = pattern[i];
+        
+        if (c == '*') {
+            if (i + 1 < length && pattern[i + 1] == '*') {
+                i++;
+                while (i + 1 < length && pattern[i + 1] == '*') i++;
+                if (i + 1 < length && pattern[i + 1] == '/') {
+                    i++;
+                    token.kind = NLINK_GLOB_GLOBSTAR_SLASH;
+                    if (nlink_glob_push_token(builder, &token) != 0) return -1;
+                    token.kind = NLINK_GLOB_DIRECTORIES;
+                } else {
+                    token.kind = NLINK_GLOB_GLOBSTAR;
+                }
+            } else {
+                token.kind = NLINK_GLOB_STAR;
+            }
+        } else if (c == '?') {
+            memset(token.bytes, 0xFF, sizeof(token.bytes));
+        } else if (c == '[' && memchr(pattern + i + 1, ']', length - i - 1)) {
+            size_t j = i + 1;
+            bool negate = j < length && (pattern[j] == '!' || pattern[j] == '^');
+            if (negate) j++;
+            bool first = true;
+            for (; j < length && (first || pattern[j] != ']'); j++, first = false) {
+                unsigned char low = (unsigned char)pattern[j];
+                unsigned char high = low;
+                if (j + 2 < length && pattern[j + 1] == '-' && pattern[j + 2] != ']') {
+                    high = (unsigned char)pattern[j + 2];
+                    j += 2;
+                }
+                for (unsigned b = low; b <= high; b++) nlink_glob_byte_add(token.bytes, (unsigned char)b);
+            }
+            if (negate) {
+                for (size_t w = 0; w < 4; w++) token.bytes[w] = ~token.bytes[w];
+            }
+            i = j;
+        } else {
+            if (c == '\\' && i + 1 < length) c = pattern[++i];
+            nlink_glob_byte_add(token.bytes, (unsigned char)c);
+        }
+        
+        // Single-segment wildcards never consume a separator
+        if (token.kind == NLINK_GLOB_LITERAL && c != '/') {
+            token.bytes['/' >> 6] &= ~(1ULL << ('/' & 63));
+        }
+        if (nlink_glob_push_token(builder, &token) != 0) return -1;
+    }
+    
+    // Accept position - consumes nothing
+    nlink_glob_token_t accept = { .kind = NLINK_GLOB_LITERAL };
+    return nlink_glob_push_token(builder, &accept);
+}
+
+// Expand the first {a,b,...} group (nesting allowed) and recurse on each alternative
+static int nlink_glob_expand(nlink_glob_builder_t* builder, const char* pattern,
+                             uint32_t pattern_index, size_t* budget) {
+    size_t length = strlen(pattern);
+    size_t open = length, close = length;
+    int depth = 0;
+    
+    for (size_t i = 0; i < length; i++) {
+        if (pattern[i] == '\\') {
+            i++;
+        } else if (pattern[i] == '{') {
+            if (depth++ == 0) open = i;
+        } else if (pattern[i] == '}' && depth > 0) {
+            if (--depth == 0) {
+                close = i;
+                break;
+            }
+        }
+    }
+    
+    if (close == length) {
+        if (*budget == 0) return -1;
+        (*budget)--;
+        return nlink_glob_tokenize(builder, pattern, length, pattern_index);
+    }
+    
+    char* alternative = nlink_malloc(NLINK_MEM_MISC, length + 1);
+    if (!alternative) return -1;
+    
+    size_t start = open + 1;
+    depth = 0;
+    int result = 0;
+    for (size_t i = open + 1; i <= close && result == 0; i++) {
+        if (pattern[i] == '\\' && i < close) {
+            i++;
+            continue;
+        }
+        if (pattern[i] == '{') depth++;
+        if (pattern[i] == '}' && i < close) depth--;
+        if ((pattern[i] == ',' && depth == 0) || i == close) {
+            size_t head = open, body = i - start;
+            memcpy(alternative, pattern, head);
+            memcpy(alternative + head, pattern + start, body);
+            strcpy(alternative + head + body, pattern + close + 1);
+            result = nlink_glob_expand(builder, alternative, pattern_index, budget);
+            start = i + 1;
+        }
+    }
+    
+    nlink_free(NLINK_MEM_MISC, alternative);
+    return result;
+}
+
+void nlink_glob_destroy(nlink_glob_set_t* set) {
+    if (!set) return;
+    nlink_free(NLINK_MEM_INDICES, set->advance);
+    nlink_free(NLINK_MEM_INDICES, set->stay);
+    nlink_free(NLINK_MEM_INDICES, set->epsilon);
+    nlink_free(NLINK_MEM_INDICES, set->pattern_of);
+    nlink_free(NLINK_MEM_INDICES, set);
+}
+
+static void nlink_glob_builder_release(nlink_glob_builder_t* builder) {
+    nlink_free(NLINK_MEM_INDICES, builder->tokens);
+    nlink_free(NLINK_MEM_INDICES, builder->patterns);
+    nlink_free(NLINK_MEM_INDICES, builder->starts);
+}
+
+/**
+ * Compile glob patterns into one automaton
+ * Pattern i answers as bit i of the match sets returned by nlink_glob_match.
+ */
+nlink_glob_set_t* nlink_glob_compile(const char* const* patterns, size_t pattern_count) {
+    nlink_glob_builder_t builder = {0};
+    
+    // Expanded in pattern order - accept positions never go back to an earlier pattern
+    for (size_t i = 0; i < pattern_count; i++) {
+        size_t budget = NLINK_GLOB_MAX_EXPANSIONS;
+        if (nlink_glob_expand(&builder, patterns[i], (uint32_t)i, &budget) != 0) {
+            nlink_glob_builder_release(&builder);
+            return NULL;
+        }
+    }
+    
+    nlink_glob_set_t* set = nlink_calloc(NLINK_MEM_INDICES, 1, sizeof(nlink_glob_set_t));
+    size_t positions = builder.count;
+    size_t words = (positions + 63) / 64 + 1;   // Spare word absorbs shifts past the end
+    uint64_t* advance = nlink_calloc(NLINK_MEM_INDICES, 256 * words, sizeof(uint64_t));
+    uint64_t* stay = nlink_calloc(NLINK_MEM_INDICES, 256 * words, sizeof(uint64_t));
+    if (!set || !advance || !stay) goto fail;
+    
+    set->pattern_count = pattern_count;
+    set->pattern_words = (pattern_count + 63) / 64;
+    set->position_count = positions;
+    set->words = words;
+    set->epsilon = nlink_calloc(NLINK_MEM_INDICES, 4 * words, sizeof(uint64_t));
+    set->pattern_of = nlink_calloc(NLINK_MEM_INDICES, positions ? positions : 1, sizeof(uint32_t));
+    if (!set->epsilon || !set->pattern_of) goto fail;
+    set->jump = set->epsilon + words;
+    set->accept = set->jump + words;
+    set->universal = set->accept + words;
+    
+    // Per-byte transition rows, one pass over all tokens
+    for (size_t e = 0; e < builder.expansion_count; e++) {
+        size_t first = builder.starts[e];
+        size_t last = e + 1 < builder.expansion_count ? builder.starts[e + 1] - 1 : positions - 1;
+        set->accept[last >> 6] |= 1ULL << (last & 63);
+        set->pattern_of[last] = builder.patterns[e];
+        
+        // wild[p]: tokens p.. are all wildcards, the last one able to
+        // swallow a final segment - every non-empty path is accepted
+        bool wild_next = false, wild_after_next = false;
+        for (size_t p = last; p-- > first;) {
+            const nlink_glob_token_t* token = &builder.tokens[p];
+            uint64_t bit = 1ULL << (p & 63);
+            size_t w = p >> 6;
+            bool wild = false;
+            
+            switch (token->kind) {
+                case NLINK_GLOB_LITERAL:
+                    for (unsigned c = 0; c < 256; c++) {
+                        if (nlink_glob_byte_in(token->bytes, (unsigned char)c)) advance[c * words + w] |= bit;
+                    }
+                    break;
+                case NLINK_GLOB_STAR:
+                    for (unsigned c = 0; c < 256; c++) {
+                        if (c != '/') stay[c * words + w] |= bit;
+                    }
+                    set->epsilon[w] |= bit;
+                    wild = p == last - 1 || wild_next;
+                    break;
+                case NLINK_GLOB_GLOBSTAR:
+                    for (unsigned c = 0; c < 256; c++) stay[c * words + w] |= bit;
+                    set->epsilon[w] |= bit;
+                    wild = p == last - 1 || wild_next;
+                    if (wild) set->universal[w] |= bit;
+                    break;
+                case NLINK_GLOB_GLOBSTAR_SLASH:
+                    set->epsilon[w] |= bit;
+                    set->jump[w] |= bit;
+                    wild = wild_after_next;
+                    if (wild) set->universal[w] |= bit;
+                    break;
+                case NLINK_GLOB_DIRECTORIES:
+                    for (unsigned c = 0; c < 256; c++) stay[c * words + w] |= bit;
+                    advance['/' * words + w] |= bit;
+                    wild = wild_next;
+                    break;
+            }
+            wild_after_next = wild_next;
+            wild_next = wild;
+        }
+    }
+    
+    // Bytes with identical rows share a class
+    size_t classes = 0;
+    uint8_t representative[256];
+    for (unsigned c = 0; c < 256; c++) {
+        size_t k = 0;
+        for (; k < classes; k++) {
+            unsigned r = representative[k];
+            if (memcmp(advance + c * words, advance + r * words, words * sizeof(uint64_t)) == 0 &&
+                memcmp(stay + c * words, stay + r * words, words * sizeof(uint64_t)) == 0) {
+                break;
+            }
+        }
+        if (k == classes) representative[classes++] = (uint8_t)c;
+        set->class_of[c] = (uint8_t)k;
+    }
+    
+    set->class_count = classes;
+    set->advance = nlink_malloc(NLINK_MEM_INDICES, classes * words * sizeof(uint64_t));
+    set->stay = nlink_malloc(NLINK_MEM_INDICES, classes * words * sizeof(uint64_t));
+    if (!set->advance || !set->stay) goto fail;
+    for (size_t k = 0; k < classes; k++) {
+        memcpy(set->advance + k * words, advance + representative[k] * words, words * sizeof(uint64_t));
+        memcpy(set->stay + k * words, stay + representative[k] * words, words * sizeof(uint64_t));
+    }
+    
+    nlink_free(NLINK_MEM_INDICES, advance);
+    nlink_free(NLINK_MEM_INDICES, stay);
+    nlink_glob_builder_release(&builder);
+    return set;
+    
+fail:
+    nlink_free(NLINK_MEM_INDICES, advance);
+    nlink_free(NLINK_MEM_INDICES, stay);
+    nlink_glob_builder_release(&builder);
+    nlink_glob_destroy(set);
+    return NULL;
+}
+
+// Follow epsilon moves until the set stops growing
+static void nlink_glob_close(const nlink_glob_set_t* set, uint64_t* state) {
+    for (;;) {
+        uint64_t grown = 0, carry = 0, jump_carry = 0;
+        for (size_t w = 0; w < set->words; w++) {
+            uint64_t skip = state[w] & set->epsilon[w];
+            uint64_t jump = state[w] & set->jump[w];
+            uint64_t next = (skip << 1) | carry | (jump << 2) | jump_carry;
+            carry = skip >> 63;
+            jump_carry = jump >> 62;
+            grown |= next & ~state[w];
+            state[w] |= next;
+        }
+        if (!grown) return;
+    }
+}
+
+// Start state - every expansion at its first position
+void nlink_glob_start(const nlink_glob_set_t* set, uint64_t* state) {
+    memset(state, 0, set->words * sizeof(uint64_t));
+    for (size_t p = 0; p < set->position_count; p++) {
+        if (p == 0 || (set->accept[(p - 1) >> 6] >> ((p - 1) & 63)) & 1) {
+            state[p >> 6] |= 1ULL << (p & 63);
+        }
+    }
+    nlink_glob_close(set, state);
+}
+
+/**
+ * Advance a state set over bytes - states can be saved and resumed,
+ * so a directory walk feeds each path segment exactly once
+ */
+void nlink_glob_feed(const nlink_glob_set_t* set, uint64_t* state, const char* bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        size_t row = set->class_of[(unsigned char)bytes[i]] * set->words;
+        const uint64_t* advance = set->advance + row;
+        const uint64_t* stay = set->stay + row;
+        uint64_t carry = 0, live = 0;
+        
+        for (size_t w = 0; w < set->words; w++) {
+            uint64_t moved = state[w] & advance[w];
+            uint64_t next = (moved << 1) | carry | (state[w] & stay[w]);
+            carry = moved >> 63;
+            state[w] = next;
+            live |= next;
+        }
+        if (!live) return;
+        nlink_glob_close(set, state);
+    }
+}
+
+// True while some pattern can still match a longer path
+bool nlink_glob_live(const nlink_glob_set_t* set, const uint64_t* state) {
+    for (size_t w = 0; w < set->words; w++) {
+        if (state[w] & ~set->accept[w]) return true;
+    }
+    return false;
+}
+
+// True when some pattern matches every non-empty continuation
+bool nlink_glob_universal(const nlink_glob_set_t* set, const uint64_t* state) {
+    for (size_t w = 0; w < set->words; w++) {
+        if (state[w] & set->universal[w]) return true;
+    }
+    return false;
+}
+
+/**
+ * Patterns accepted in a fed state
+ * Returns how many distinct patterns match; fills matched (pattern_words) if given.
+ */
+size_t nlink_glob_accepts(const nlink_glob_set_t* set, const uint64_t* state, uint64_t* matched) {
+    if (matched) memset(matched, 0, set->pattern_words * sizeof(uint64_t));
+    
+    // Accept positions ascend with their pattern, so brace alternatives of
+    // one pattern arrive back to back and comparing with the last suffices
+    size_t count = 0;
+    uint32_t last = UINT32_MAX;
+    for (size_t w = 0; w < set->words; w++) {
+        uint64_t hits = state[w] & set->accept[w];
+        while (hits) {
+            uint32_t pattern = set->pattern_of[w * 64 + (size_t)__builtin_ctzll(hits)];
+            hits &= hits - 1;
+            if (pattern == last) continue;
+            last = pattern;
+            count++;
+            if (matched) matched[pattern >> 6] |= 1ULL << (pattern & 63);
+        }
+    }
+    return count;
+}
+
+// One-shot match of a whole path
+size_t nlink_glob_match(const nlink_glob_set_t* set, const char* path, uint64_t* matched) {
+    uint64_t local[16];
+    uint64_t* state = set->words <= 16 ? local : nlink_malloc(NLINK_MEM_MISC, set->words * sizeof(uint64_t));
+    if (!state) return 0;
+    
+    nlink_glob_start(set, state);
+    nlink_glob_feed(set, state, path, strlen(path));
+    size_t count = nlink_glob_accepts(set, state, matched);
+    
+    if (state != local) nlink_free(NLINK_MEM_MISC, state);
+    return count;
+}
+
+// === PROJECT DISCOVERY ===
+
+#define NLINK_DISCOVERY_MAX_WORKERS  64
+#define NLINK_DISCOVERY_MAX_TERMS    32
+#define NLINK_DISCOVERY_MAX_FILTER   1024   // Bytes of a semantic filter, terminator included
+
+typedef enum {
+    NLINK_DISCOVERED_MANIFEST,    // nlink.txt
+    NLINK_DISCOVERED_PACKAGE,     // *.nlink (pkg.nlink)
+    NLINK_DISCOVERED_SOURCE       // C/C++ sources and headers
+} nlink_discovered_kind_t;
+
+typedef struct {
+    char* path;                   // Relative to the project root
+    nlink_discovered_kind_t kind;
+} nlink_discovered_file_t;
+
+typedef struct {
+    nlink_discovered_file_t* files;   // Sorted by path
+    size_t count;
+    size_t manifest_count;
+    size_t package_count;
+    size_t source_count;
+    size_t directory_count;
+    size_t pruned_count;          // Directories skipped by the glob lists
+    size_t steals;
+    uint32_t worker_count;
+} nlink_discovery_t;
+
+// Open directory shared by the pending tasks of its subdirectories
+typedef struct {
+    int fd;
+    _Atomic uint32_t references;  // Scan in progress plus one per pending child
+} nlink_discovery_dir_t;
+
+/**
+ * Pending directory - opened by name relative to its parent's descriptor,
+ * never by its full path, so a directory above it that is swapped for a
+ * symlink mid-walk cannot redirect the walk
+ */
+typedef struct {
+    char* path;                   // Root-relative, for results and globs
+    size_t length;
+    size_t name_offset;           // Last segment of path
+    nlink_discovery_dir_t* parent;   // NULL for the root
+    uint64_t* glob_state;         // Whitelist then blacklist state after "path/", behind the path
+} nlink_discovery_task_t;
+
+static void nlink_discovery_dir_release(nlink_discovery_dir_t* dir) {
+    if (dir && atomic_fetch_sub_explicit(&dir->references, 1, memory_order_acq_rel) == 1) {
+        close(dir->fd);
+        nlink_free(NLINK_MEM_MISC, dir);
+    }
+}
+
+/**
+ * Work-stealing deque of pending directories
+ * The owner pushes and pops at the bottom (depth first, warm dentries),
+ * thieves take from the top where the shallowest - largest - subtrees sit.
+ */
+typedef struct {
+    _Alignas(NLINK_CACHE_LINE) pthread_mutex_t lock;
+    nlink_discovery_task_t* tasks;
+    size_t top;
+    size_t bottom;
+    size_t capacity;
+    
+    nlink_discovered_file_t* found;
+    size_t found_count;
+    size_t found_capacity;
+    size_t directories;
+    size_t steals;
+    size_t pruned;
+    uint64_t* scratch;            // Glob states of the file being classified
+} nlink_discovery_deque_t;
+
+typedef struct {
+    int root_fd;
+    uint32_t worker_count;
+    nlink_discovery_deque_t* deques;
+    _Atomic size_t pending;       // Tasks pushed and not yet scanned
+    _Atomic size_t queued;        // Tasks sitting in a deque
+    _Atomic bool failed;
+    
+    // Idle workers park here until a push, the end of the walk or a failure
+    pthread_mutex_t idle_lock;
+    pthread_cond_t work_available;
+    _Atomic uint32_t sleepers;
+    
+    const char* terms[NLINK_DISCOVERY_MAX_TERMS];
+    size_t term_lengths[NLINK_DISCOVERY_MAX_TERMS];
+    size_t term_count;
+    
+    const nlink_glob_set_t* whitelist;
+    const nlink_glob_set_t* blacklist;
+    size_t whitelist_words;
+    size_t state_words;           // Both glob states together
+} nlink_discovery_walk_t;
+
+typedef struct {
+    nlink_discovery_walk_t* walk;
+    uint32_t worker;
+} nlink_discovery_worker_t;
+
+static int nlink_discovery_push(nlink_discovery_walk_t* walk, uint32_t worker,
+                                const nlink_discovery_task_t* task) {
+    nlink_discovery_deque_t* deque = &walk->deques[worker];
+    pthread_mutex_lock(&deque->lock);
+    
+    if (deque->bottom == deque->capacity) {
+        // Compact stolen slots before growing
+        size_t live = deque->bottom - deque->top;
+        if (deque->top > 0) {
+            memmove(deque->tasks, deque->tasks + deque->top, live * sizeof(nlink_discovery_task_t));
+            deque->top = 0;
+            deque->bottom = live;
+        }
+        if (deque->bottom == deque->capacity) {
+            size_t capacity = deque->capacity ? deque->capacity * 2 : 64;
+            nlink_discovery_task_t* tasks = nlink_realloc(NLINK_MEM_MISC, deque->tasks,
+                                                          capacity * sizeof(nlink_discovery_task_t));
+            if (!tasks) {
+                pthread_mutex_unlock(&deque->lock);
+                return -1;
+            }
+            deque->tasks = tasks;
+            deque->capacity = capacity;
+        }
+    }
+    
+    atomic_fetch_add_explicit(&walk->pending, 1, memory_order_relaxed);
+    deque->tasks[deque->bottom++] = *task;
+    pthread_mutex_unlock(&deque->lock);
+    
+    // Sequentially consistent pair with nlink_discovery_idle: either the
+    // sleeper sees the task or this push sees the sleeper
+    atomic_fetch_add(&walk->queued, 1);
+    if (atomic_load(&walk->sleepers) > 0) {
+        pthread_mutex_lock(&walk->idle_lock);
+        pthread_cond_signal(&walk->work_available);
+        pthread_mutex_unlock(&walk->idle_lock);
+    }
+    return 0;
+}
+
+static void nlink_discovery_wake_all(nlink_discovery_walk_t* walk) {
+    pthread_mutex_lock(&walk->idle_lock);
+    pthread_cond_broadcast(&walk->work_available);
+    pthread_mutex_unlock(&walk->idle_lock);
+}
+
+/**
+ * Park an idle worker - returns false once the walk is over
+ * The walk ends when no directory is queued or being scanned.
+ */
+static bool nlink_discovery_idle(nlink_discovery_walk_t* walk) {
+    pthread_mutex_lock(&walk->idle_lock);
+    atomic_fetch_add(&walk->sleepers, 1);
+    while (atomic_load(&walk->queued) == 0 &&
+           atomic_load(&walk->pending) > 0 &&
+           !atomic_load(&walk->failed)) {
+        pthread_cond_wait(&walk->work_available, &walk->idle_lock);
+    }
+    atomic_fetch_sub(&walk->sleepers, 1);
+    pthread_mutex_unlock(&walk->idle_lock);
+    return atomic_load(&walk->pending) > 0 && !atomic_load(&walk->failed);
+}
+
+static bool nlink_discovery_pop(nlink_discovery_walk_t* walk, uint32_t worker,
+                                nlink_discovery_task_t* task) {
+    nlink_discovery_deque_t* deque = &walk->deques[worker];
+    pthread_mutex_lock(&deque->lock);
+    bool found = deque->bottom > deque->top;
+    if (found) *task = deque->tasks[--deque->bottom];
+    pthread_mutex_unlock(&deque->lock);
+    if (found) atomic_fetch_sub(&walk->queued, 1);
+    return found;
+}
+
+/**
+ * Take the shallowest task of another worker
+ * The opportunistic pass skips victims whose lock is busy; a worker about
+ * to park makes a blocking pass first, so it never sleeps past queued work.
+ */
+static bool nlink_discovery_steal(nlink_discovery_walk_t* walk, uint32_t thief,
+                                  nlink_discovery_task_t* task, bool blocking) {
+    for (uint32_t i = 1; i < walk->worker_count; i++) {
+        nlink_discovery_deque_t* victim = &walk->deques[(thief + i) % walk->worker_count];
+        if (blocking) {
+            pthread_mutex_lock(&victim->lock);
+        } else if (pthread_mutex_trylock(&victim->lock) != 0) {
+            continue;
+        }
+        bool found = victim->bottom > victim->top;
+        if (found) *task = victim->tasks[victim->top++];
+        pthread_mutex_unlock(&victim->lock);
+        if (found) {
+            atomic_fetch_sub(&walk->queued, 1);
+            walk->deques[thief].steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool nlink_has_suffix(const char* name, size_t length, const char* suffix) {
+    size_t suffix_length = strlen(suffix);
+    return length > suffix_length && memcmp(name + length - suffix_length, suffix, suffix_length) == 0;
+}
+
+static bool nlink_discovery_classify(const char* name, size_t length,
+                                     nlink_discovered_kind_t* kind) {
+    static const char* const source_suffixes[] = { ".c", ".h", ".cc", ".cpp", ".cxx", ".hpp", ".hh" };
+    
+    if (length == 9 && memcmp(name, "nlink.txt", 9) == 0) {
+        *kind = NLINK_DISCOVERED_MANIFEST;
+        return true;
+    }
+    if (nlink_has_suffix(name, length, ".nlink")) {
+        *kind = NLINK_DISCOVERED_PACKAGE;
+        return true;
+    }
+    for (size_t i = 0; i < sizeof(source_suffixes) / sizeof(source_suffixes[0]); i++) {
+        if (nlink_has_suffix(name, length, source_suffixes[i])) {
+            *kind = NLINK_DISCOVERED_SOURCE;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sources pass when their path mentions any filter term; manifests always pass
+static bool nlink_discovery_matches(const nlink_discovery_walk_t* walk, const char* path) {
+    if (walk->term_count == 0) return true;
+    for (size_t i = 0; i < walk->term_count; i++) {
+        const char* hit = path;
+        while ((hit = strchr(hit, walk->terms[i][0])) != NULL) {
+            if (strncmp(hit, walk->terms[i], walk->term_lengths[i]) == 0) return true;
+            hit++;
+        }
+    }
+    return false;
+}
+
+// Root-relative child path, with extra bytes behind it for the glob states
+static char* nlink_discovery_join(const nlink_discovery_task_t* parent, const char* name,
+                                  size_t name_length, size_t extra, size_t* length) {
+    *length = parent->length ? parent->length + 1 + name_length : name_length;
+    char* path = nlink_malloc(NLINK_MEM_MISC, extra ? ((*length + 8) & ~(size_t)7) + extra
+                                                    : *length + 1);
+    if (!path) return NULL;
+    
+    char* cursor = path;
+    if (parent->length) {
+        memcpy(cursor, parent->path, parent->length);
+        cursor += parent->length;
+        *cursor++ = '/';
+    }
+    memcpy(cursor, name, name_length);
+    cursor[name_length] = '\0';
+    return path;
+}
+
+// Continue the parent's glob states over one more path segment
+static void nlink_discovery_glob_feed(const nlink_discovery_walk_t* walk, uint64_t* state,
+                                      const uint64_t* parent_state, const char* name,
+                                      size_t length, bool directory) {
+    memcpy(state, parent_state, walk->state_words * sizeof(uint64_t));
+    if (walk->whitelist) {
+        nlink_glob_feed(walk->whitelist, state, name, length);
+        if (directory) nlink_glob_feed(walk->whitelist, state, "/", 1);
+    }
+    if (walk->blacklist) {
+        uint64_t* blacklist_state = state + walk->whitelist_words;
+        nlink_glob_feed(walk->blacklist, blacklist_state, name, length);
+        if (directory) nlink_glob_feed(walk->blacklist, blacklist_state, "/", 1);
+    }
+}
+
+/**
+ * Directories worth entering - some whitelist pattern can still match
+ * below, and no blacklist pattern already swallows everything below
+ */
+static bool nlink_discovery_enter(const nlink_discovery_walk_t* walk, const uint64_t* state) {
+    if (walk->whitelist && !nlink_glob_live(walk->whitelist, state)) return false;
+    if (walk->blacklist && nlink_glob_universal(walk->blacklist, state + walk->whitelist_words)) {
+        return false;
+    }
+    return true;
+}
+
+static bool nlink_discovery_admit(const nlink_discovery_walk_t* walk, const uint64_t* state) {
+    if (walk->whitelist && nlink_glob_accepts(walk->whitelist, state, NULL) == 0) return false;
+    if (walk->blacklist && nlink_glob_accepts(walk->blacklist, state + walk->whitelist_words, NULL) > 0) {
+        return false;
+    }
+    return true;
+}
+
+static int nlink_discovery_record(nlink_discovery_deque_t* deque, char* path,
+                                  nlink_discovered_kind_t kind) {
+    if (deque->found_count == deque->found_capacity) {
+        size_t capacity = deque->found_capacity ? deque->found_capacity * 2 : 256;
+        nlink_discovered_file_t* found = nlink_realloc(NLINK_MEM_MISC, deque->found,
+                                                       capacity * sizeof(nlink_discovered_file_t));
+        if (!found) return -1;
+        deque->found = found;
+        deque->found_capacity = capacity;
+    }
+    deque->found[deque->found_count++] = (nlink_discovered_file_t){ .path = path, .kind = kind };
+    return 0;
+}
+
+/**
+ * Scan one directory - subdirectories become tasks, matches become results
+ * Symlinks are never followed, at any depth, so the walk cannot cycle or
+ * leave the root.
+ */
+static int nlink_discovery_scan(nlink_discovery_walk_t* walk, uint32_t worker,
+                                const nlink_discovery_task_t* task) {
+    int fd = openat(task->parent ? task->parent->fd : walk->root_fd,
+                    task->parent ? task->path + task->name_offset : ".",
+                    O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) return 0;   // Vanished, unreadable or a symlink - not fatal
+    
+    DIR* dir = fdopendir(fd);
+    if (!dir) {
+        close(fd);
+        return 0;
+    }
+    
+    nlink_discovery_deque_t* deque = &walk->deques[worker];
+    deque->directories++;
+    nlink_discovery_dir_t* self = NULL;   // Shared with the children, opened on the first one
+    int result = 0;
+    struct dirent* entry;
+    
+    while ((entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.') continue;   // ".", ".." and hidden trees (.git)
+        
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN) {
+            struct stat st;
+            if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) continue;
+            type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_LNK;
+        }
+        
+        size_t name_length = strlen(name);
+        size_t length;
+        if (type == DT_DIR) {
+            nlink_discovery_task_t child = {0};
+            if (walk->state_words) {
+                nlink_discovery_glob_feed(walk, deque->scratch, task->glob_state, name, name_length, true);
+                if (!nlink_discovery_enter(walk, deque->scratch)) {
+                    deque->pruned++;
+                    continue;
+                }
+            }
+            
+            if (!self) {
+                self = nlink_malloc(NLINK_MEM_MISC, sizeof(nlink_discovery_dir_t));
+                if (!self || (self->fd = fcntl(fd, F_DUPFD_CLOEXEC, 0)) < 0) {
+                    nlink_free(NLINK_MEM_MISC, self);
+                    self = NULL;
+                    result = -1;
+                    break;
+                }
+                atomic_init(&self->references, 1);
+            }
+            
+            size_t state_bytes = walk->state_words * sizeof(uint64_t);
+            child.path = nlink_discovery_join(task, name, name_length, state_bytes, &child.length);
+            child.name_offset = child.length - name_length;
+            child.parent = self;
+            if (child.path && state_bytes) {
+                child.glob_state = (uint64_t*)(child.path + ((child.length + 8) & ~(size_t)7));
+                memcpy(child.glob_state, deque->scratch, state_bytes);
+            }
+            atomic_fetch_add_explicit(&self->references, 1, memory_order_relaxed);
+            if (!child.path || nlink_discovery_push(walk, worker, &child) != 0) {
+                nlink_free(NLINK_MEM_MISC, child.path);
+                nlink_discovery_dir_release(self);
+                result = -1;
+                break;
+            }
+            continue;
+        }
+        
+        nlink_discovered_kind_t kind;
+        if (type != DT_REG || !nlink_discovery_classify(name, name_length, &kind)) continue;
+        if (walk->state_words) {
+            nlink_discovery_glob_feed(walk, deque->scratch, task->glob_state, name, name_length, false);
+            if (!nlink_discovery_admit(walk, deque->scratch)) continue;
+        }
+        
+        char* path = nlink_discovery_join(task, name, name_length, 0, &length);
+        if (!path) {
+            result = -1;
+            break;
+        }
+        if (kind == NLINK_DISCOVERED_SOURCE && !nlink_discovery_matches(walk, path)) {
+            nlink_free(NLINK_MEM_MISC, path);
+            continue;
+        }
+        if (nlink_discovery_record(deque, path, kind) != 0) {
+            nlink_free(NLINK_MEM_MISC, path);
+            result = -1;
+            break;
+        }
+    }
+    
+    closedir(dir);
+    nlink_discovery_dir_release(self);
+    return result;
+}
+
+static void* nlink_discovery_worker(void* arg) {
+    nlink_discovery_worker_t* self = arg;
+    nlink_discovery_walk_t* walk = self->walk;
+    nlink_discovery_task_t task;
+    
+    while (!atomic_load_explicit(&walk->failed, memory_order_relaxed)) {
+        if (!nlink_discovery_pop(walk, self->worker, &task) &&
+            !nlink_discovery_steal(walk, self->worker, &task, false) &&
+            !nlink_discovery_steal(walk, self->worker, &task, true)) {
+            if (!nlink_discovery_idle(walk)) break;
+            continue;
+        }
+        
+        if (nlink_discovery_scan(walk, self->worker, &task) != 0) {
+            atomic_store(&walk->failed, true);
+            nlink_discovery_wake_all(walk);
+        }
+        nlink_discovery_dir_release(task.parent);
+        nlink_free(NLINK_MEM_MISC, task.path);
+        if (atomic_fetch_sub(&walk->pending, 1) == 1) {
+            nlink_discovery_wake_all(walk);   // Last directory done - release the sleepers
+        }
+    }
+    return NULL;
+}
+
+static int nlink_discovered_compare(const void* a, const void* b) {
+    return strcmp(((const nlink_discovered_file_t*)a)->path,
+                  ((const nlink_discovered_file_t*)b)->path);
+}
+
+void nlink_discovery_destroy(nlink_discovery_t* discovery) {
+    if (!discovery) return;
+    for (size_t i = 0; i < discovery->count; i++) {
+        nlink_free(NLINK_MEM_MISC, discovery->files[i].path);
+    }
+    nlink_free(NLINK_MEM_MISC, discovery->files);
+    nlink_free(NLINK_MEM_MISC, discovery);
+}
+
+/**
+ * Semantic filters longer than NLINK_DISCOVERY_MAX_FILTER or with more than
+ * NLINK_DISCOVERY_MAX_TERMS terms are rejected rather than cut short
+ */
+bool nlink_semantic_filter_fits(const char* semantic_filter) {
+    if (!semantic_filter) return true;
+    if (strlen(semantic_filter) >= NLINK_DISCOVERY_MAX_FILTER) return false;
+    
+    size_t terms = 0;
+    for (const char* cursor = semantic_filter; *cursor;) {
+        size_t length = strcspn(cursor, "|");
+        if (length > 0) terms++;
+        cursor += length;
+        if (*cursor) cursor++;
+    }
+    return terms <= NLINK_DISCOVERY_MAX_TERMS;
+}
+
+/**
+ * Discover manifests, packages and sources below a project root
+ * Directories are scanned in parallel by work-stealing workers; results
+ * are merged and sorted by path, so output never depends on scheduling.
+ * semantic_filter is "term|term|..." matched against source paths (NULL: all);
+ * one that does not fit fails the walk. Optional whitelist/blacklist globs apply to every discovered file, and
+ * prune directories neither list lets anything through below.
+ */
+nlink_discovery_t* nlink_discover_components_filtered(const char* project_root,
+                                                      const char* semantic_filter,
+                                                      const nlink_glob_set_t* whitelist,
+                                                      const nlink_glob_set_t* blacklist) {
+    nlink_discovery_walk_t walk = {
+        .root_fd = -1,
+        .whitelist = whitelist,
+        .blacklist = blacklist,
+        .whitelist_words = whitelist ? whitelist->words : 0,
+        .state_words = (whitelist ? whitelist->words : 0) + (blacklist ? blacklist->words : 0)
+    };
+    
+    if (!nlink_semantic_filter_fits(semantic_filter)) return NULL;
+    
+    char filter[NLINK_DISCOVERY_MAX_FILTER];
+    if (semantic_filter && semantic_filter[0]) {
+        memcpy(filter, semantic_filter, strlen(semantic_filter) + 1);
+        char* save = NULL;
+        for (char* term = strtok_r(filter, "|", &save); term; term = strtok_r(NULL, "|", &save)) {
+            walk.terms[walk.term_count] = term;
+            walk.term_lengths[walk.term_count++] = strlen(term);
+        }
+    }
+    
+    walk.root_fd = open(project_root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (walk.root_fd < 0) return NULL;
+    
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    walk.worker_count = cpus < 1 ? 1 : cpus > NLINK_DISCOVERY_MAX_WORKERS
+                      ? NLINK_DISCOVERY_MAX_WORKERS : (uint32_t)cpus;
+    walk.deques = nlink_calloc(NLINK_MEM_MISC, walk.worker_count, sizeof(nlink_discovery_deque_t));
+    nlink_discovery_t* discovery = nlink_calloc(NLINK_MEM_MISC, 1, sizeof(nlink_discovery_t));
+    nlink_discovery_worker_t workers[NLINK_DISCOVERY_MAX_WORKERS];
+    pthread_t threads[NLINK_DISCOVERY_MAX_WORKERS];
+    uint32_t started = 0;
+    
+    if (!walk.deques || !discovery) goto fail;
+    atomic_init(&walk.pending, 0);
+    atomic_init(&walk.queued, 0);
+    atomic_init(&walk.failed, false);
+    atomic_init(&walk.sleepers, 0);
+    pthread_mutex_init(&walk.idle_lock, NULL);
+    pthread_cond_init(&walk.work_available, NULL);
+    for (uint32_t i = 0; i < walk.worker_count; i++) {
+        pthread_mutex_init(&walk.deques[i].lock, NULL);
+        if (walk.state_words) {
+            walk.deques[i].scratch = nlink_malloc(NLINK_MEM_MISC, walk.state_words * sizeof(uint64_t));
+            if (!walk.deques[i].scratch) atomic_store(&walk.failed, true);
+        }
+    }
+    
+    nlink_discovery_task_t root = {
+        .path = nlink_calloc(NLINK_MEM_MISC, 1, 8 + walk.state_words * sizeof(uint64_t)),
+        .length = 0
+    };
+    if (root.path && walk.state_words) {
+        root.glob_state = (uint64_t*)(root.path + 8);
+        if (whitelist) nlink_glob_start(whitelist, root.glob_state);
+        if (blacklist) nlink_glob_start(blacklist, root.glob_state + walk.whitelist_words);
+    }
+    if (!root.path || nlink_discovery_push(&walk, 0, &root) != 0) {
+        nlink_free(NLINK_MEM_MISC, root.path);
+        atomic_store(&walk.failed, true);
+    }
+    
+    // Worker 0 runs on the calling thread
+    for (uint32_t i = 1; i < walk.worker_count && !atomic_load(&walk.failed); i++) {
+        workers[i] = (nlink_discovery_worker_t){ .walk = &walk, .worker = i };
+        if (pthread_create(&threads[i], NULL, nlink_discovery_worker, &workers[i]) != 0) break;
+        started = i;
+    }
+    workers[0] = (nlink_discovery_worker_t){ .walk = &walk, .worker = 0 };
+    nlink_discovery_worker(&workers[0]);
+    for (uint32_t i = 1; i <= started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    
+    // Merge per-worker results - concatenate, then sort by path
+    size_t total = 0;
+    for (uint32_t i = 0; i < walk.worker_count; i++) total += walk.deques[i].found_count;
+    discovery->files = nlink_malloc(NLINK_MEM_MISC, (total ? total : 1) * sizeof(nlink_discovered_file_t));
+    if (!discovery->files) atomic_store(&walk.failed, true);
+    
+    for (uint32_t i = 0; i < walk.worker_count; i++) {
+        nlink_discovery_deque_t* deque = &walk.deques[i];
+        for (size_t j = 0; j < deque->found_count; j++) {
+            if (discovery->files) {
+                discovery->files[discovery->count++] = deque->found[j];
+            } else {
+                nlink_free(NLINK_MEM_MISC, deque->found[j].path);
+            }
+        }
+        // Leftover tasks only exist after a failure
+        for (size_t j = deque->top; j < deque->bottom; j++) {
+            nlink_discovery_dir_release(deque->tasks[j].parent);
+            nlink_free(NLINK_MEM_MISC, deque->tasks[j].path);
+        }
+        discovery->directory_count += deque->directories;
+        discovery->pruned_count += deque->pruned;
+        discovery->steals += deque->steals;
+        nlink_free(NLINK_MEM_MISC, deque->scratch);
+        nlink_free(NLINK_MEM_MISC, deque->found);
+        nlink_free(NLINK_MEM_MISC, deque->tasks);
+        pthread_mutex_destroy(&deque->lock);
+    }
+    nlink_free(NLINK_MEM_MISC, walk.deques);
+    walk.deques = NULL;
+    pthread_mutex_destroy(&walk.idle_lock);
+    pthread_cond_destroy(&walk.work_available);
+    close(walk.root_fd);
+    
+    discovery->worker_count = walk.worker_count;
+    if (atomic_load(&walk.failed)) {
+        nlink_discovery_destroy(discovery);
+        return NULL;
+    }
+    
+    qsort(discovery->files, discovery->count, sizeof(nlink_discovered_file_t),
+          nlink_discovered_compare);
+    for (size_t i = 0; i < discovery->count; i++) {
+        switch (discovery->files[i].kind) {
+            case NLINK_DISCOVERED_MANIFEST: discovery->manifest_count++; break;
+            case NLINK_DISCOVERED_PACKAGE:  discovery->package_count++;  break;
+            case NLINK_DISCOVERED_SOURCE:   discovery->source_count++;   break;
+        }
+    }
+    return discovery;
+    
+fail:
+    nlink_free(NLINK_MEM_MISC, walk.deques);
+    nlink_free(NLINK_MEM_MISC, discovery);
+    close(walk.root_fd);
+    return NULL;
+}
+
+nlink_discovery_t* nlink_discover_components(const char* project_root,
+                                             const char* semantic_filter) {
+    return nlink_discover_components_filtered(project_root, semantic_filter, NULL, NULL);
+}
+
+// === MANIFEST PARSER ===
+
+// Byte range of the manifest text - stays valid for as long as the text does
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} nlink_span_t;
+
+typedef struct {
+    nlink_span_t name;
+    nlink_span_t version;
+    nlink_span_t consciousness_level;
+    uint32_t first_anchor;        // Into anchors
+    uint32_t anchor_count;
+    uint32_t first_dependency;    // Into dependencies
+    uint32_t dependency_count;
+    uint32_t first_source;        // Into sources
+    uint32_t source_count;
+    uint32_t line;
+} nlink_manifest_component_t;
+
+typedef struct {
+    nlink_span_t name;
+    nlink_span_t constraint;      // Empty when unversioned
+} nlink_manifest_dependency_t;
+
+typedef struct {
+    nlink_span_t name;
+    uint32_t first_member;        // Into target_members
+    uint32_t member_count;
+} nlink_manifest_target_t;
+
+typedef struct {
+    nlink_span_t* items;
+    uint32_t count;
+    uint32_t capacity;
+} nlink_span_list_t;
+
+/**
+ * Parsed nlink.txt / pkg.nlink
+ * Records hold spans into the text, never copies. Parsing into the same
+ * manifest again reuses every array, so a warm parser does not allocate.
+ */
+typedef struct {
+    const char* text;
+    size_t length;
+    void* map;                    // Owned mapping, NULL for caller buffers
+    size_t map_length;
+    struct stat file_stat;        // Of the mapped file - the cache validation key
+    
+    nlink_span_t project;
+    nlink_manifest_component_t* components;
+    uint32_t component_count;
+    uint32_t component_capacity;
+    nlink_manifest_dependency_t* dependencies;
+    uint32_t dependency_count;
+    uint32_t dependency_capacity;
+    nlink_manifest_target_t* targets;
+    uint32_t target_count;
+    uint32_t target_capacity;
+    nlink_span_list_t anchors;
+    nlink_span_list_t sources;
+    nlink_span_list_t whitelist;
+    nlink_span_list_t blacklist;
+    nlink_span_list_t main_components;
+    nlink_span_list_t target_members;
+    nlink_span_list_t arguments;  // Scratch - arguments of the current command
+    
+    uint32_t error_line;
+    const char* error;
+} nlink_manifest_t;
+
+typedef enum {
+    NLINK_TOKEN_END,
+    NLINK_TOKEN_WORD,             // Bare word: identifiers, versions, WITNESS, true
+    NLINK_TOKEN_STRING,           // "..." - span excludes the quotes
+    NLINK_TOKEN_OPEN,
+    NLINK_TOKEN_CLOSE,
+    NLINK_TOKEN_LIST_OPEN,
+    NLINK_TOKEN_LIST_CLOSE,
+    NLINK_TOKEN_COMMA,
+    NLINK_TOKEN_ERROR
+} nlink_token_kind_t;
+
+typedef struct {
+    nlink_token_kind_t kind;
+    nlink_span_t span;
+} nlink_token_t;
+
+typedef struct {
+    const char* text;
+    size_t length;
+    size_t position;
+    uint32_t line;
+} nlink_lexer_t;
+
+typedef enum {
+    NLINK_SECTION_NONE,
+    NLINK_SECTION_COMPONENT,
+    NLINK_SECTION_WHITELIST,
+    NLINK_SECTION_BLACKLIST,
+    NLINK_SECTION_OTHER           // configure_components(), declare_build_intents(), ...
+} nlink_manifest_section_t;
+
+static inline bool nlink_is_word_byte(unsigned char c) {
+    return c > ' ' && c != '(' && c != ')' && c != '[' && c != ']' &&
+           c != ',' && c != '"' && c != '#' && c != 0x7F;
+}
+
+/**
+ * Next token - no allocation, no copies, only a cursor over the text
+ */
+static nlink_token_t nlink_lexer_next(nlink_lexer_t* lexer) {
+    const char* text = lexer->text;
+    size_t end = lexer->length;
+    size_t i = lexer->position;
+    
+    for (;;) {
+        while (i < end && (unsigned char)text[i] <= ' ') {
+            if (text[i] == '\n') lexer->line++;
+            i++;
+        }
+        if (i < end && text[i] == '#') {
+            const char* newline = memchr(text + i, '\n', end - i);
+            i = newline ? (size_t)(newline - text) : end;
+            continue;
+        }
+        break;
+    }
+    
+    nlink_token_t token = { .kind = NLINK_TOKEN_END, .span = { (uint32_t)i, 0 } };
+    if (i == end) {
+        lexer->position = i;
+        return token;
+    }
+    
+    switch (text[i]) {
+        case '(': token.kind = NLINK_TOKEN_OPEN;       i++; break;
+        case ')': token.kind = NLINK_TOKEN_CLOSE;      i++; break;
+        case '[': token.kind = NLINK_TOKEN_LIST_OPEN;  i++; break;
+        case ']': token.kind = NLINK_TOKEN_LIST_CLOSE; i++; break;
+        case ',': token.kind = NLINK_TOKEN_COMMA;      i++; break;
+        case '"': {
+            size_t start = ++i;
+            uint32_t line = lexer->line;
+            while (i < end && text[i] != '"') {
+                if (text[i] == '\n') lexer->line++;
+                i += text[i] == '\\' && i + 1 < end ? 2 : 1;
+            }
+            if (i >= end) {
+                lexer->line = line;   // Report where the string opened
+                token.kind = NLINK_TOKEN_ERROR;
+                break;
+            }
+            token.kind = NLINK_TOKEN_STRING;
+            token.span = (nlink_span_t){ (uint32_t)start, (uint32_t)(i - start) };
+            i++;
+            break;
+        }
+        default: {
+            size_t start = i;
+            while (i < end && nlink_is_word_byte((unsigned char)text[i])) i++;
+            if (i == start) {
+                token.kind = NLINK_TOKEN_ERROR;
+                break;
+            }
+            token.kind = NLINK_TOKEN_WORD;
+            token.span = (nlink_span_t){ (uint32_t)start, (uint32_t)(i - start) };
+            break;
+        }
+    }
+    
+    lexer->position = i;
+    return token;
+}
+
+static inline bool nlink_span_is(const char* text, nlink_span_t span, const char* word) {
+    size_t length = strlen(word);
+    return span.length == length && memcmp(text + span.offset, word, length) == 0;
+}
+
+static inline bool nlink_span_has_prefix(const char* text, nlink_span_t span, const char* prefix) {
+    size_t length = strlen(prefix);
+    return span.length >= length && memcmp(text + span.offset, prefix, length) == 0;
+}
+
+// Grow a manifest array to hold one more item - capacity survives re-parses
+static int nlink_manifest_reserve(void** items, uint32_t* capacity, uint32_t count,
+                                  size_t item_size) {
+    if (count < *capacity) return 0;
+    uint32_t grown = *capacity ? *capacity * 2 : 16;
+    void* resized = nlink_realloc(NLINK_MEM_MISC, *items, (size_t)grown * item_size);
+    if (!resized) return -1;
+    *items = resized;
+    *capacity = grown;
+    return 0;
+}
+
+static int nlink_span_list_push(nlink_span_list_t* list, nlink_span_t span) {
+    if (nlink_manifest_reserve((void**)&list->items, &list->capacity, list->count,
+                               sizeof(nlink_span_t)) != 0) {
+        return -1;
+    }
+    list->items[list->count++] = span;
+    return 0;
+}
+
+static int nlink_span_list_append(nlink_span_list_t* list, const nlink_span_list_t* from) {
+    for (uint32_t i = 0; i < from->count; i++) {
+        if (nlink_span_list_push(list, from->items[i]) != 0) return -1;
+    }
+    return 0;
+}
+
+static int nlink_manifest_fail(nlink_manifest_t* manifest, uint32_t line, const char* error) {
+    manifest->error_line = line;
+    manifest->error = error;
+    return -1;
+}
+
+/**
+ * Apply one command to the manifest records
+ * Unknown commands are accepted and ignored, so newer manifests still parse.
+ */
+static int nlink_manifest_command(nlink_manifest_t* manifest, nlink_span_t name,
+                                  nlink_manifest_section_t* section, uint32_t line) {
+    const char* text = manifest->text;
+    const nlink_span_list_t* args = &manifest->arguments;
+    nlink_span_t empty = { name.offset, 0 };
+    nlink_span_t first = args->count ? args->items[0] : empty;
+    nlink_manifest_component_t* comp = *section == NLINK_SECTION_COMPONENT
+                                     ? &manifest->components[manifest->component_count - 1]
+                                     : NULL;
+    
+    if (nlink_span_is(text, name, "component")) {
+        if (*section != NLINK_SECTION_NONE) {
+            return nlink_manifest_fail(manifest, line, "component() inside another block");
+        }
+        if (!args->count) return nlink_manifest_fail(manifest, line, "component() needs a name");
+        if (nlink_manifest_reserve((void**)&manifest->components, &manifest->component_capacity,
+                                   manifest->component_count,
+                                   sizeof(nlink_manifest_component_t)) != 0) {
+            return nlink_manifest_fail(manifest, line, "out of memory");
+        }
+        manifest->components[manifest->component_count++] = (nlink_manifest_component_t){
+            .name = first,
+            .version = empty,
+            .consciousness_level = empty,
+            .first_anchor = manifest->anchors.count,
+            .first_dependency = manifest->dependency_count,
+            .first_source = manifest->sources.count,
+            .line = line
+        };
+        *section = NLINK_SECTION_COMPONENT;
+        return 0;
+    }
+    if (nlink_span_is(text, name, "endcomponent")) {
+        if (!comp) return nlink_manifest_fail(manifest, line, "endcomponent() without component()");
+        *section = NLINK_SECTION_NONE;
+        return 0;
+    }
+    if (nlink_span_is(text, name, "configure_whitelist")) {
+        *section = NLINK_SECTION_WHITELIST;
+        return 0;
+    }
+    if (nlink_span_is(text, name, "configure_blacklist")) {
+        *section = NLINK_SECTION_BLACKLIST;
+        return 0;
+    }
+    if (nlink_span_has_prefix(text, name, "configure_") ||
+        nlink_span_has_prefix(text, name, "declare_")) {
+        *section = NLINK_SECTION_OTHER;
+        return 0;
+    }
+    if (nlink_span_has_prefix(text, name, "end")) {
+        *section = NLINK_SECTION_NONE;
+        return 0;
+    }
+    
+    int result = 0;
+    if (nlink_span_is(text, name, "project")) {
+        manifest->project = first;
+    } else if (nlink_span_is(text, name, "pattern")) {
+        if (*section == NLINK_SECTION_WHITELIST) {
+            result = nlink_span_list_append(&manifest->whitelist, args);
+        } else if (*section == NLINK_SECTION_BLACKLIST) {
+            result = nlink_span_list_append(&manifest->blacklist, args);
+        } else {
+            return nlink_manifest_fail(manifest, line, "pattern() outside a whitelist or blacklist");
+        }
+    } else if (nlink_span_is(text, name, "main_component")) {
+        result = nlink_span_list_append(&manifest->main_components, args);
+    } else if (nlink_span_is(text, name, "link_target")) {
+        if (!args->count) return nlink_manifest_fail(manifest, line, "link_target() needs a name");
+        if (nlink_manifest_reserve((void**)&manifest->targets, &manifest->target_capacity,
+                                   manifest->target_count, sizeof(nlink_manifest_target_t)) != 0) {
+            return nlink_manifest_fail(manifest, line, "out of memory");
+        }
+        manifest->targets[manifest->target_count++] = (nlink_manifest_target_t){
+            .name = first,
+            .first_member = manifest->target_members.count,
+            .member_count = args->count - 1
+        };
+        for (uint32_t i = 1; i < args->count && result == 0; i++) {
+            result = nlink_span_list_push(&manifest->target_members, args->items[i]);
+        }
+    } else if (comp) {
+        // Per-component records stay contiguous: a component's block is
+        // closed before the next one opens
+        if (nlink_span_is(text, name, "version")) {
+            comp->version = first;
+        } else if (nlink_span_is(text, name, "consciousness_level")) {
+            comp->consciousness_level = first;
+        } else if (nlink_span_is(text, name, "semantic_anchors")) {
+            result = nlink_span_list_append(&manifest->anchors, args);
+            comp->anchor_count += args->count;
+        } else if (nlink_span_is(text, name, "sources")) {
+            result = nlink_span_list_append(&manifest->sources, args);
+            comp->source_count += args->count;
+        } else if (nlink_span_is(text, name, "depends_on")) {
+            if (!args->count) return nlink_manifest_fail(manifest, line, "depends_on() needs a name");
+            if (nlink_manifest_reserve((void**)&manifest->dependencies,
+                                       &manifest->dependency_capacity, manifest->dependency_count,
+                                       sizeof(nlink_manifest_dependency_t)) != 0) {
+                return nlink_manifest_fail(manifest, line, "out of memory");
+            }
+            manifest->dependencies[manifest->dependency_count++] = (nlink_manifest_dependency_t){
+                .name = first,
+                .constraint = args->count > 1 ? args->items[1] : empty
+            };
+            comp->dependency_count++;
+        }
+    } else if (nlink_span_is(text, name, "depends_on") ||
+               nlink_span_is(text, name, "semantic_anchors")) {
+        return nlink_manifest_fail(manifest, line, "component setting outside component()");
+    }
+    
+    return result == 0 ? 0 : nlink_manifest_fail(manifest, line, "out of memory");
+}
+
+/**
+ * Parse manifest text into records
+ * Grammar: command := WORD '(' [value {[','] value}] ')'
+ *          value   := WORD | STRING | '[' {value [',']} ']'
+ * Lists are flattened into the command's argument run; '#' starts a comment.
+ */
+int nlink_manifest_parse(nlink_manifest_t* manifest, const char* text, size_t length) {
+    if (length > UINT32_MAX) {
+        return nlink_manifest_fail(manifest, 0, "manifest larger than 4 GB");
+    }
+    
+    manifest->text = text;
+    manifest->length = length;
+    manifest->project = (nlink_span_t){0, 0};
+    manifest->component_count = 0;
+    manifest->dependency_count = 0;
+    manifest->target_count = 0;
+    manifest->anchors.count = 0;
+    manifest->sources.count = 0;
+    manifest->whitelist.count = 0;
+    manifest->blacklist.count = 0;
+    manifest->main_components.count = 0;
+    manifest->target_members.count = 0;
+    manifest->error = NULL;
+    manifest->error_line = 0;
+    
+    nlink_lexer_t lexer = { .text = text, .length = length, .position = 0, .line = 1 };
+    nlink_manifest_section_t section = NLINK_SECTION_NONE;
+    
+    for (;;) {
+        nlink_token_t name = nlink_lexer_next(&lexer);
+        if (name.kind == NLINK_TOKEN_END) break;
+        uint32_t line = lexer.line;
+        if (name.kind != NLINK_TOKEN_WORD) {
+            return nlink_manifest_fail(manifest, line, "expected a command name");
+        }
+        if (nlink_lexer_next(&lexer).kind != NLINK_TOKEN_OPEN) {
+            return nlink_manifest_fail(manifest, line, "expected '(' after command name");
+        }
+        
+        manifest->arguments.count = 0;
+        int depth = 0;
+        for (;;) {
+            nlink_token_t token = nlink_lexer_next(&lexer);
+            if (token.kind == NLINK_TOKEN_WORD || token.kind == NLINK_TOKEN_STRING) {
+                if (nlink_span_list_push(&manifest->arguments, token.span) != 0) {
+                    return nlink_manifest_fail(manifest, lexer.line, "out of memory");
+                }
+            } else if (token.kind == NLINK_TOKEN_LIST_OPEN) {
+                depth++;
+            } else if (token.kind == NLINK_TOKEN_LIST_CLOSE && depth > 0) {
+                depth--;
+            } else if (token.kind == NLINK_TOKEN_CLOSE && depth == 0) {
+                break;
+            } else if (token.kind == NLINK_TOKEN_END) {
+                return nlink_manifest_fail(manifest, line, "unterminated command");
+            } else if (token.kind != NLINK_TOKEN_COMMA) {
+                return nlink_manifest_fail(manifest, lexer.line,
+                                           token.kind == NLINK_TOKEN_ERROR ? "unterminated string"
+                                                                           : "unexpected token");
+            }
+        }
+        
+        if (nlink_manifest_command(manifest, name.span, &section, line) != 0) return -1;
+    }
+    
+    if (section == NLINK_SECTION_COMPONENT) {
+        return nlink_manifest_fail(manifest, manifest->components[manifest->component_count - 1].line,
+                                   "component() without endcomponent()");
+    }
+    return 0;
+}
+
+static void nlink_manifest_unmap(nlink_manifest_t* manifest) {
+    if (manifest->map) munmap(manifest->map, manifest->map_length);
+    manifest->map = NULL;
+    manifest->map_length = 0;
+}
+
+/**
+ * Map a manifest read-only and parse it in place
+ * path is opened relative to dir_fd (AT_FDCWD for plain paths).
+ */
+int nlink_manifest_load(nlink_manifest_t* manifest, int dir_fd, const char* path) {
+    nlink_manifest_unmap(manifest);
+    
+    int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nlink_manifest_fail(manifest, 0, "cannot open");
+    
+    struct stat* st = &manifest->file_stat;
+    if (fstat(fd, st) != 0) {
+        close(fd);
+        return nlink_manifest_fail(manifest, 0, "cannot stat");
+    }
+    
+    size_t length = (size_t)st->st_size;
+    if (length > 0) {
+        void* map = mmap(NULL, length, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return nlink_manifest_fail(manifest, 0, "cannot map");
+        }
+        madvise(map, length, MADV_SEQUENTIAL);
+        manifest->map = map;
+        manifest->map_length = length;
+    }
+    close(fd);
+    
+    return nlink_manifest_parse(manifest, length ? manifest->map : "", length);
+}
+
+void nlink_manifest_release(nlink_manifest_t* manifest) {
+    nlink_manifest_unmap(manifest);
+    nlink_free(NLINK_MEM_MISC, manifest->components);
+    nlink_free(NLINK_MEM_MISC, manifest->dependencies);
+    nlink_free(NLINK_MEM_MISC, manifest->targets);
+    nlink_span_list_t* lists[] = {
+        &manifest->anchors, &manifest->sources, &manifest->whitelist, &manifest->blacklist,
+        &manifest->main_components, &manifest->target_members, &manifest->arguments
+    };
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+        nlink_free(NLINK_MEM_MISC, lists[i]->items);
+    }
+    memset(manifest, 0, sizeof(*manifest));
+}
+
+// === MANIFEST CACHE ===
+
+#define NLINK_CACHE_MAGIC        0x484341434B4E4C4EULL   // "NLNKCACH"
+#define NLINK_CACHE_VERSION      4
+#define NLINK_CACHE_FILE         ".nlink-cache"
+#define NLINK_CACHE_RACY_NS      2000000000ULL   // Newer than this at write time: verify by hash
+
+typedef enum {
+    NLINK_CACHE_OFF,
+    NLINK_CACHE_STAT,             // Trust (dev, inode, size, mtime_ns)
+    NLINK_CACHE_HASH              // Also compare the content hash
+} nlink_cache_mode_t;
+
+#define NLINK_CACHE_ENTRY_RACY   0x1u   // Written within the racy window of its mtime
+
+typedef struct {
+    nlink_span_t path;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    uint64_t mtime_ns;
+    uint64_t content_hash;        // FNV-1a 64 of the file
+    uint32_t first_component;
+    uint32_t component_count;
+    uint32_t first_root;          // Into roots
+    uint32_t root_count;
+    uint32_t first_target;        // Into targets
+    uint32_t target_count;
+} nlink_cache_entry_t;
+
+/**
+ * On-disk layout - header, then each section 8-byte aligned:
+ * entries (sorted by path), component records, anchors, dependencies,
+ * sources, root names, link targets, strings
+ */
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t entry_count;
+    uint64_t component_count;
+    uint64_t anchor_count;
+    uint64_t dependency_count;
+    uint64_t source_count;
+    uint64_t root_count;
+    uint64_t target_count;
+    uint64_t string_bytes;
+    uint64_t entries_offset;
+    uint64_t components_offset;
+    uint64_t anchors_offset;
+    uint64_t dependencies_offset;
+    uint64_t sources_offset;
+    uint64_t roots_offset;
+    uint64_t targets_offset;
+    uint64_t strings_offset;
+    uint64_t file_size;
+} nlink_cache_header_t;
+
+/**
+ * Parsed component records of a set of manifests, relocated into one
+ * string table - the same records the parser produces, with spans into
+ * strings instead of manifest text. Either points straight into a mapped
+ * cache file or into builder arrays.
+ */
+typedef struct {
+    nlink_cache_entry_t* entries;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+    nlink_manifest_component_t* components;
+    uint32_t component_count;
+    uint32_t component_capacity;
+    nlink_span_t* anchors;
+    uint32_t anchor_count;
+    uint32_t anchor_capacity;
+    nlink_manifest_dependency_t* dependencies;
+    uint32_t dependency_count;
+    uint32_t dependency_capacity;
+    nlink_span_t* sources;
+    uint32_t source_count;
+    uint32_t source_capacity;
+    nlink_span_t* roots;
+    uint32_t root_count;
+    uint32_t root_capacity;
+    nlink_manifest_target_t* targets;   // Members index roots
+    uint32_t target_count;
+    uint32_t target_capacity;
+    char* strings;
+    size_t string_bytes;
+    size_t string_capacity;
+} nlink_manifest_digest_t;
+
+static inline uint64_t nlink_content_hash(const void* data, size_t length) {
+    const unsigned char* bytes = data;
+    uint64_t hash = 14695981039346656037ULL;    // FNV-1a 64
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+static inline uint64_t nlink_stat_mtime_ns(const struct stat* st) {
+    return (uint64_t)st->st_mtim.tv_sec * 1000000000ULL + (uint64_t)st->st_mtim.tv_nsec;
+}
+
+static inline const char* nlink_digest_text(const nlink_manifest_digest_t* digest, nlink_span_t span) {
+    return digest->strings + span.offset;
+}
+
+static int nlink_digest_intern(nlink_manifest_digest_t* digest, const char* text, size_t length,
+                               nlink_span_t* span) {
+    if (digest->string_bytes + length + 1 > UINT32_MAX) return -1;
+    if (digest->string_bytes + length + 1 > digest->string_capacity) {
+        size_t capacity = digest->string_capacity ? digest->string_capacity * 2 : 64 * 1024;
+        while (capacity < digest->string_bytes + length + 1) capacity *= 2;
+        char* strings = nlink_realloc(NLINK_MEM_MISC, digest->strings, capacity);
+        if (!strings) return -1;
+        digest->strings = strings;
+        digest->string_capacity = capacity;
+    }
+    
+    // Terminated, so cached paths compare with strcmp
+    memcpy(digest->strings + digest->string_bytes, text, length);
+    digest->strings[digest->string_bytes + length] = '\0';
+    *span = (nlink_span_t){ (uint32_t)digest->string_bytes, (uint32_t)length };
+    digest->string_bytes += length + 1;
+    return 0;
+}
+
+static int nlink_digest_push_span(nlink_span_t** items, uint32_t* count, uint32_t* capacity,
+                                  nlink_manifest_digest_t* digest, const char* text,
+                                  nlink_span_t span) {
+    if (nlink_manifest_reserve((void**)items, capacity, *count, sizeof(nlink_span_t)) != 0) return -1;
+    if (nlink_digest_intern(digest, text + span.offset, span.length, &(*items)[*count]) != 0) return -1;
+    (*count)++;
+    return 0;
+}
+
+static nlink_cache_entry_t* nlink_digest_begin_entry(nlink_manifest_digest_t* digest,
+                                                     const char* path, const struct stat* st,
+                                                     uint64_t content_hash, uint64_t now_ns) {
+    if (nlink_manifest_reserve((void**)&digest->entries, &digest->entry_capacity,
+                               digest->entry_count, sizeof(nlink_cache_entry_t)) != 0) {
+        return NULL;
+    }
+    nlink_cache_entry_t* entry = &digest->entries[digest->entry_count];
+    memset(entry, 0, sizeof(*entry));
+    if (nlink_digest_intern(digest, path, strlen(path), &entry->path) != 0) return NULL;
+    
+    entry->device = (uint64_t)st->st_dev;
+    entry->inode = (uint64_t)st->st_ino;
+    entry->size = (uint64_t)st->st_size;
+    entry->mtime_ns = nlink_stat_mtime_ns(st);
+    entry->content_hash = content_hash;
+    entry->flags = entry->mtime_ns + NLINK_CACHE_RACY_NS > now_ns ? NLINK_CACHE_ENTRY_RACY : 0;
+    entry->first_component = digest->component_count;
+    entry->first_root = digest->root_count;
+    entry->first_target = digest->target_count;
+    digest->entry_count++;
+    return entry;
+}
+
+// Carry one parsed component record, and every list it points into, over to the digest
+static int nlink_digest_add_record(nlink_manifest_digest_t* digest, const char* text,
+                                   const nlink_manifest_component_t* from,
+                                   const nlink_span_t* anchors,
+                                   const nlink_manifest_dependency_t* dependencies,
+                                   const nlink_span_t* sources) {
+    if (nlink_manifest_reserve((void**)&digest->components, &digest->component_capacity,
+                               digest->component_count, sizeof(nlink_manifest_component_t)) != 0) {
+        return -1;
+    }
+    nlink_manifest_component_t record = {
+        .first_anchor = digest->anchor_count,
+        .anchor_count = from->anchor_count,
+        .first_dependency = digest->dependency_count,
+        .dependency_count = from->dependency_count,
+        .first_source = digest->source_count,
+        .source_count = from->source_count,
+        .line = from->line
+    };
+    if (nlink_digest_intern(digest, text + from->name.offset, from->name.length, &record.name) != 0 ||
+        nlink_digest_intern(digest, text + from->version.offset, from->version.length,
+                            &record.version) != 0 ||
+        nlink_digest_intern(digest, text + from->consciousness_level.offset,
+                            from->consciousness_level.length, &record.consciousness_level) != 0) {
+        return -1;
+    }
+    digest->components[digest->component_count++] = record;
+    
+    for (uint32_t a = 0; a < from->anchor_count; a++) {
+        if (nlink_digest_push_span(&digest->anchors, &digest->anchor_count, &digest->anchor_capacity,
+                                   digest, text, anchors[from->first_anchor + a]) != 0) {
+            return -1;
+        }
+    }
+    for (uint32_t d = 0; d < from->dependency_count; d++) {
+        const nlink_manifest_dependency_t* dependency = &dependencies[from->first_dependency + d];
+        if (nlink_manifest_reserve((void**)&digest->dependencies, &digest->dependency_capacity,
+                                   digest->dependency_count, sizeof(nlink_manifest_dependency_t)) != 0) {
+            return -1;
+        }
+        nlink_manifest_dependency_t* copy = &digest->dependencies[digest->dependency_count];
+        if (nlink_digest_intern(digest, text + dependency->name.offset, dependency->name.length,
+                                &copy->name) != 0 ||
+            nlink_digest_intern(digest, text + dependency->constraint.offset,
+                                dependency->constraint.length, &copy->constraint) != 0) {
+            return -1;
+        }
+        digest->dependency_count++;
+    }
+    for (uint32_t s = 0; s < from->source_count; s++) {
+        if (nlink_digest_push_span(&digest->sources, &digest->source_count, &digest->source_capacity,
+                                   digest, text, sources[from->first_source + s]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// One link_target whose members start first_member entries into the digest roots
+static int nlink_digest_add_target(nlink_manifest_digest_t* digest, const char* text,
+                                   nlink_span_t name, uint32_t first_member, uint32_t member_count) {
+    if (nlink_manifest_reserve((void**)&digest->targets, &digest->target_capacity,
+                               digest->target_count, sizeof(nlink_manifest_target_t)) != 0) {
+        return -1;
+    }
+    nlink_manifest_target_t* target = &digest->targets[digest->target_count];
+    if (nlink_digest_intern(digest, text + name.offset, name.length, &target->name) != 0) return -1;
+    target->first_member = first_member;
+    target->member_count = member_count;
+    digest->target_count++;
+    return 0;
+}
+
+// Digest a freshly parsed manifest
+static int nlink_digest_add_manifest(nlink_manifest_digest_t* digest, const char* path,
+                                     const nlink_manifest_t* manifest, uint64_t now_ns) {
+    nlink_cache_entry_t* entry = nlink_digest_begin_entry(digest, path, &manifest->file_stat,
+                                                          nlink_content_hash(manifest->text,
+                                                                             manifest->length),
+                                                          now_ns);
+    if (!entry) return -1;
+    const char* text = manifest->text;
+    
+    for (uint32_t c = 0; c < manifest->component_count; c++) {
+        if (nlink_digest_add_record(digest, text, &manifest->components[c], manifest->anchors.items,
+                                    manifest->dependencies, manifest->sources.items) != 0) {
+            return -1;
+        }
+    }
+    
+    const nlink_span_list_t* root_lists[] = { &manifest->main_components, &manifest->target_members };
+    uint32_t first_member = digest->root_count + manifest->main_components.count;
+    for (size_t l = 0; l < 2; l++) {
+        for (uint32_t r = 0; r < root_lists[l]->count; r++) {
+            if (nlink_digest_push_span(&digest->roots, &digest->root_count, &digest->root_capacity,
+                                       digest, text, root_lists[l]->items[r]) != 0) {
+                return -1;
+            }
+        }
+    }
+    for (uint32_t t = 0; t < manifest->target_count; t++) {
+        const nlink_manifest_target_t* target = &manifest->targets[t];
+        if (nlink_digest_add_target(digest, text, target->name, first_member + target->first_member,
+                                    target->member_count) != 0) {
+            return -1;
+        }
+    }
+    
+    // The builder may have moved - index again rather than keep the pointer
+    entry = &digest->entries[digest->entry_count - 1];
+    entry->component_count = digest->component_count - entry->first_component;
+    entry->root_count = digest->root_count - entry->first_root;
+    entry->target_count = digest->target_count - entry->first_target;
+    return 0;
+}
+
+// Carry an unchanged manifest over from the previous cache, with fresh stat data
+static int nlink_digest_add_cached(nlink_manifest_digest_t* digest, const char* path,
+                                   const nlink_manifest_digest_t* cache,
+                                   const nlink_cache_entry_t* cached, const struct stat* st,
+                                   uint64_t now_ns) {
+    nlink_cache_entry_t* entry = nlink_digest_begin_entry(digest, path, st, cached->content_hash, now_ns);
+    if (!entry) return -1;
+    
+    for (uint32_t c = 0; c < cached->component_count; c++) {
+        if (nlink_digest_add_record(digest, cache->strings,
+                                    &cache->components[cached->first_component + c],
+                                    cache->anchors, cache->dependencies, cache->sources) != 0) {
+            return -1;
+        }
+    }
+    uint32_t first_root = digest->root_count;
+    for (uint32_t r = 0; r < cached->root_count; r++) {
+        if (nlink_digest_push_span(&digest->roots, &digest->root_count, &digest->root_capacity,
+                                   digest, cache->strings, cache->roots[cached->first_root + r]) != 0) {
+            return -1;
+        }
+    }
+    for (uint32_t t = 0; t < cached->target_count; t++) {
+        const nlink_manifest_target_t* target = &cache->targets[cached->first_target + t];
+        if (nlink_digest_add_target(digest, cache->strings, target->name,
+                                    first_root + (target->first_member - cached->first_root),
+                                    target->member_count) != 0) {
+            return -1;
+        }
+    }
+    
+    entry = &digest->entries[digest->entry_count - 1];
+    entry->component_count = digest->component_count - entry->first_component;
+    entry->root_count = digest->root_count - entry->first_root;
+    entry->target_count = digest->target_count - entry->first_target;
+    return 0;
+}
+
+static void nlink_digest_release(nlink_manifest_digest_t* digest) {
+    nlink_free(NLINK_MEM_MISC, digest->entries);
+    nlink_free(NLINK_MEM_MISC, digest->components);
+    nlink_free(NLINK_MEM_MISC, digest->anchors);
+    nlink_free(NLINK_MEM_MISC, digest->dependencies);
+    nlink_free(NLINK_MEM_MISC, digest->sources);
+    nlink_free(NLINK_MEM_MISC, digest->roots);
+    nlink_free(NLINK_MEM_MISC, digest->targets);
+    nlink_free(NLINK_MEM_MISC, digest->strings);
+    memset(digest, 0, sizeof(*digest));
+}
+
+static bool nlink_cache_span_valid(nlink_span_t span, uint64_t string_bytes) {
+    return (uint64_t)span.offset + span.length < string_bytes;   // Terminator included
+}
+
+static bool nlink_cache_section_valid(uint64_t offset, uint64_t count, size_t item_size,
+                                      uint64_t file_size) {
+    return offset % 8 == 0 && offset <= file_size &&
+           count <= (file_size - offset) / item_size;
+}
+
+/**
+ * Map a cache file and expose it as a digest - one mmap, no parsing
+ * Everything is bounds-checked once; a damaged or foreign file is ignored.
+ */
+static int nlink_cache_map(const char* path, void** map_out, size_t* map_length,
+                           nlink_manifest_digest_t* digest) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(nlink_cache_header_t)) {
+        close(fd);
+        return -1;
+    }
+    size_t length = (size_t)st.st_size;
+    void* map = mmap(NULL, length, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    
+    const nlink_cache_header_t* header = map;
+    const char* base = map;
+    bool valid = header->magic == NLINK_CACHE_MAGIC &&
+                 header->version == NLINK_CACHE_VERSION &&
+                 header->header_size == sizeof(nlink_cache_header_t) &&
+                 header->file_size == length &&
+                 header->entry_count <= UINT32_MAX && header->component_count <= UINT32_MAX &&
+                 header->anchor_count <= UINT32_MAX && header->dependency_count <= UINT32_MAX &&
+                 header->source_count <= UINT32_MAX && header->root_count <= UINT32_MAX &&
+                 header->target_count <= UINT32_MAX &&
+                 nlink_cache_section_valid(header->entries_offset, header->entry_count,
+                                           sizeof(nlink_cache_entry_t), length) &&
+                 nlink_cache_section_valid(header->components_offset, header->component_count,
+                                           sizeof(nlink_manifest_component_t), length) &&
+                 nlink_cache_section_valid(header->anchors_offset, header->anchor_count,
+                                           sizeof(nlink_span_t), length) &&
+                 nlink_cache_section_valid(header->dependencies_offset, header->dependency_count,
+                                           sizeof(nlink_manifest_dependency_t), length) &&
+                 nlink_cache_section_valid(header->sources_offset, header->source_count,
+                                           sizeof(nlink_span_t), length) &&
+                 nlink_cache_section_valid(header->roots_offset, header->root_count,
+                                           sizeof(nlink_span_t), length) &&
+                 nlink_cache_section_valid(header->targets_offset, header->target_count,
+                                           sizeof(nlink_manifest_target_t), length) &&
+                 nlink_cache_section_valid(header->strings_offset, header->string_bytes, 1, length);
+    
+    if (valid) {
+        *digest = (nlink_manifest_digest_t){
+            .entries = (nlink_cache_entry_t*)(base + header->entries_offset),
+            .entry_count = (uint32_t)header->entry_count,
+            .components = (nlink_manifest_component_t*)(base + header->components_offset),
+            .component_count = (uint32_t)header->component_count,
+            .anchors = (nlink_span_t*)(base + header->anchors_offset),
+            .anchor_count = (uint32_t)header->anchor_count,
+            .dependencies = (nlink_manifest_dependency_t*)(base + header->dependencies_offset),
+            .dependency_count = (uint32_t)header->dependency_count,
+            .sources = (nlink_span_t*)(base + header->sources_offset),
+            .source_count = (uint32_t)header->source_count,
+            .roots = (nlink_span_t*)(base + header->roots_offset),
+            .root_count = (uint32_t)header->root_count,
+            .targets = (nlink_manifest_target_t*)(base + header->targets_offset),
+            .target_count = (uint32_t)header->target_count,
+            .strings = (char*)(base + header->strings_offset),
+            .string_bytes = header->string_bytes
+        };
+    }
+    
+    // Every span and range must land inside its section
+    for (uint32_t i = 0; valid && i < digest->entry_count; i++) {
+        const nlink_cache_entry_t* entry = &digest->entries[i];
+        valid = nlink_cache_span_valid(entry->path, digest->string_bytes) &&
+                digest->strings[entry->path.offset + entry->path.length] == '\0' &&
+                (uint64_t)entry->first_component + entry->component_count <= digest->component_count &&
+                (uint64_t)entry->first_root + entry->root_count <= digest->root_count &&
+                (uint64_t)entry->first_target + entry->target_count <= digest->target_count &&
+                (i == 0 || strcmp(digest->strings + digest->entries[i - 1].path.offset,
+                                  digest->strings + entry->path.offset) < 0);
+    }
+    for (uint32_t i = 0; valid && i < digest->component_count; i++) {
+        const nlink_manifest_component_t* comp = &digest->components[i];
+        valid = nlink_cache_span_valid(comp->name, digest->string_bytes) &&
+                nlink_cache_span_valid(comp->version, digest->string_bytes) &&
+                nlink_cache_span_valid(comp->consciousness_level, digest->string_bytes) &&
+                (uint64_t)comp->first_anchor + comp->anchor_count <= digest->anchor_count &&
+                (uint64_t)comp->first_dependency + comp->dependency_count <= digest->dependency_count &&
+                (uint64_t)comp->first_source + comp->source_count <= digest->source_count;
+    }
+    for (uint32_t i = 0; valid && i < digest->anchor_count; i++) {
+        valid = nlink_cache_span_valid(digest->anchors[i], digest->string_bytes);
+    }
+    for (uint32_t i = 0; valid && i < digest->dependency_count; i++) {
+        valid = nlink_cache_span_valid(digest->dependencies[i].name, digest->string_bytes) &&
+                nlink_cache_span_valid(digest->dependencies[i].constraint, digest->string_bytes);
+    }
+    for (uint32_t i = 0; valid && i < digest->source_count; i++) {
+        valid = nlink_cache_span_valid(digest->sources[i], digest->string_bytes);
+    }
+    for (uint32_t i = 0; valid && i < digest->root_count; i++) {
+        valid = nlink_cache_span_valid(digest->roots[i], digest->string_bytes);
+    }
+    for (uint32_t i = 0; valid && i < digest->target_count; i++) {
+        const nlink_manifest_target_t* target = &digest->targets[i];
+        valid = nlink_cache_span_valid(target->name, digest->string_bytes) &&
+                (uint64_t)target->first_member + target->member_count <= digest->root_count;
+    }
+    for (uint32_t i = 0; valid && i < digest->entry_count; i++) {
+        // Targets name members of their own manifest, which moves them with it
+        const nlink_cache_entry_t* entry = &digest->entries[i];
+        for (uint32_t t = 0; valid && t < entry->target_count; t++) {
+            const nlink_manifest_target_t* target = &digest->targets[entry->first_target + t];
+            valid = target->first_member >= entry->first_root &&
+                    (uint64_t)target->first_member + target->member_count <=
+                    (uint64_t)entry->first_root + entry->root_count;
+        }
+    }
+    
+    if (!valid) {
+        munmap(map, length);
+        memset(digest, 0, sizeof(*digest));
+        return -1;
+    }
+    *map_out = map;
+    *map_length = length;
+    return 0;
+}
+
+static int nlink_cache_write_section(FILE* stream, const void* data, size_t bytes, uint64_t* offset) {
+    static const char padding[8] = {0};
+    if (bytes && fwrite(data, 1, bytes, stream) != bytes) return -1;
+    size_t pad = (8 - (bytes & 7)) & 7;
+    if (pad && fwrite(padding, 1, pad, stream) != pad) return -1;
+    *offset += bytes + pad;
+    return 0;
+}
+
+/**
+ * Write a digest as the new cache - to a temporary file renamed into
+ * place, so readers see the old cache or the new one, never half of one
+ */
+static int nlink_cache_write(const char* path, const nlink_manifest_digest_t* digest) {
+    char temporary[4096];
+    if ((size_t)snprintf(temporary, sizeof(temporary), "%s.%d.tmp", path, (int)getpid()) >=
+        sizeof(temporary)) {
+        return -1;
+    }
+    FILE* stream = fopen(temporary, "wb");
+    if (!stream) return -1;
+    
+    nlink_cache_header_t header = {
+        .magic = NLINK_CACHE_MAGIC,
+        .version = NLINK_CACHE_VERSION,
+        .header_size = sizeof(nlink_cache_header_t),
+        .entry_count = digest->entry_count,
+        .component_count = digest->component_count,
+        .anchor_count = digest->anchor_count,
+        .dependency_count = digest->dependency_count,
+        .source_count = digest->source_count,
+        .root_count = digest->root_count,
+        .target_count = digest->target_count,
+        .string_bytes = digest->string_bytes
+    };
+    
+    // Lay the sections out first so the header can go out in one piece
+    uint64_t offset = (sizeof(header) + 7) & ~7ULL;
+    header.entries_offset = offset;
+    offset += (digest->entry_count * sizeof(nlink_cache_entry_t) + 7) & ~7ULL;
+    header.components_offset = offset;
+    offset += (digest->component_count * sizeof(nlink_manifest_component_t) + 7) & ~7ULL;
+    header.anchors_offset = offset;
+    offset += (digest->anchor_count * sizeof(nlink_span_t) + 7) & ~7ULL;
+    header.dependencies_offset = offset;
+    offset += (digest->dependency_count * sizeof(nlink_manifest_dependency_t) + 7) & ~7ULL;
+    header.sources_offset = offset;
+    offset += (digest->source_count * sizeof(nlink_span_t) + 7) & ~7ULL;
+    header.roots_offset = offset;
+    offset += (digest->root_count * sizeof(nlink_span_t) + 7) & ~7ULL;
+    header.targets_offset = offset;
+    offset += (digest->target_count * sizeof(nlink_manifest_target_t) + 7) & ~7ULL;
+    header.strings_offset = offset;
+    header.file_size = offset + ((digest->string_bytes + 7) & ~7ULL);
+    
+    uint64_t written = 0;
+    int result = nlink_cache_write_section(stream, &header, sizeof(header), &written);
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->entries,
+                                           digest->entry_count * sizeof(nlink_cache_entry_t), &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->components,
+                                           digest->component_count * sizeof(nlink_manifest_component_t),
+                                           &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->anchors,
+                                           digest->anchor_count * sizeof(nlink_span_t), &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->dependencies,
+                                           digest->dependency_count * sizeof(nlink_manifest_dependency_t),
+                                           &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->sources,
+                                           digest->source_count * sizeof(nlink_span_t), &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->roots,
+                                           digest->root_count * sizeof(nlink_span_t), &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->targets,
+                                           digest->target_count * sizeof(nlink_manifest_target_t),
+                                           &written);
+    }
+    if (result == 0) {
+        result = nlink_cache_write_section(stream, digest->strings, digest->string_bytes, &written);
+    }
+    
+    if (fclose(stream) != 0 || written != header.file_size) result = -1;
+    if (result == 0 && rename(temporary, path) != 0) result = -1;
+    if (result != 0) unlink(temporary);
+    return result;
+}
+
+// Content hash of a file, for entries whose stat data alone is not proof
+static int nlink_cache_hash_file(int dir_fd, const char* path, uint64_t* hash) {
+    int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    
+    size_t length = (size_t)st.st_size;
+    if (length == 0) {
+        close(fd);
+        *hash = nlink_content_hash("", 0);
+        return 0;
+    }
+    void* map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    madvise(map, length, MADV_SEQUENTIAL);
+    *hash = nlink_content_hash(map, length);
+    munmap(map, length);
+    return 0;
+}
+
+// === MANIFEST LOADING ===
+
+// A link_target of the loaded manifests - its resolved members are a run of root_ids
+typedef struct {
+    const char* name;             // In the registry arena
+    uint32_t first_root;
+    uint32_t root_count;
+} nlink_link_target_t;
+
+typedef struct {
+    size_t files;
+    size_t bytes;                 // Manifest bytes parsed
+    size_t failed_files;
+    size_t parsed;                // Manifests parsed rather than taken from the cache
+    size_t cache_hits;
+    bool cache_written;
+    size_t components;
+    size_t duplicates;            // Components whose name was already registered
+    size_t anchors;               // semantic_anchors() interned as residues
+    size_t dependencies;
+    size_t unresolved;            // Dependencies and roots naming no component
+    uint32_t* root_ids;           // main_component and link_target members
+    size_t root_count;
+    nlink_link_target_t* targets;
+    size_t target_count;
+} nlink_manifest_load_report_t;
+
+// Name -> component, probing on the hash cached in each anchor
+typedef struct {
+    nlink_component_t** slots;
+    size_t mask;
+    size_t count;
+} nlink_anchor_table_t;
+
+static nlink_component_t* nlink_anchor_table_find(const nlink_anchor_table_t* table,
+                                                  const nlink_anchor_t* key) {
+    if (!table->slots) return NULL;
+    for (size_t i = key->hash & table->mask;; i = (i + 1) & table->mask) {
+        nlink_component_t* comp = table->slots[i];
+        if (!comp) return NULL;
+        if (nlink_anchor_equal(&comp->residues[0].perceptual_anchor, key)) return comp;
+    }
+}
+
+static int nlink_anchor_table_insert(nlink_anchor_table_t* table, nlink_component_t* comp) {
+    if ((table->count + 1) * 2 > table->mask + 1 || !table->slots) {
+        size_t capacity = table->slots ? (table->mask + 1) * 2 : 1024;
+        nlink_component_t** slots = nlink_calloc(NLINK_MEM_INDICES, capacity, sizeof(nlink_component_t*));
+        if (!slots) return -1;
+        for (size_t i = 0; table->slots && i <= table->mask; i++) {
+            nlink_component_t* moved = table->slots[i];
+            if (!moved) continue;
+            size_t j = moved->residues[0].perceptual_anchor.hash & (capacity - 1);
+            while (slots[j]) j = (j + 1) & (capacity - 1);
+            slots[j] = moved;
+        }
+        nlink_free(NLINK_MEM_INDICES, table->slots);
+        table->slots = slots;
+        table->mask = capacity - 1;
+    }
+    
+    size_t i = comp->residues[0].perceptual_anchor.hash & table->mask;
+    while (table->slots[i]) i = (i + 1) & table->mask;
+    table->slots[i] = comp;
+    table->count++;
+    return 0;
+}
+
+static nlink_component_t* nlink_digest_find(const nlink_anchor_table_t* names,
+                                            const nlink_manifest_digest_t* digest, nlink_span_t name) {
+    nlink_anchor_t key = nlink_anchor_borrow_n(nlink_digest_text(digest, name), name.length);
+    return nlink_anchor_table_find(names, &key);
+}
+
+static int nlink_digest_add_anchors(nlink_component_t* comp, const nlink_manifest_digest_t* digest,
+                                    const nlink_manifest_component_t* record) {
+    const char* texts[16];
+    uint32_t lengths[16];
+    
+    for (uint32_t a = 0; a < record->anchor_count;) {
+        size_t batch = 0;
+        for (; batch < 16 && a < record->anchor_count; batch++, a++) {
+            nlink_span_t anchor = digest->anchors[record->first_anchor + a];
+            texts[batch] = nlink_digest_text(digest, anchor);
+            lengths[batch] = anchor.length;
+        }
+        if (nlink_component_add_anchors_n(comp, texts, lengths, batch) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * Register the components of a digest
+ * Names are interned into the registry arena as component anchors, and
+ * semantic_anchors() as further residues. Once
+ * every component is known, dependencies become edges and main_component /
+ * link_target members become GC roots; each link_target keeps its run of them.
+ */
+static int nlink_registry_load_digest(nlink_component_registry_t* registry,
+                                      const nlink_manifest_digest_t* digest,
+                                      nlink_manifest_load_report_t* report) {
+    nlink_anchor_table_t names = {0};
+    int result = 0;
+    
+    // Components already in the registry resolve like manifest ones
+    for (size_t i = 0; i < registry->component_count && result == 0; i++) {
+        if (registry->components[i]->residue_count) {
+            result = nlink_anchor_table_insert(&names, registry->components[i]);
+        }
+    }
+    
+    for (uint32_t c = 0; c < digest->component_count && result == 0; c++) {
+        const nlink_manifest_component_t* record = &digest->components[c];
+        nlink_component_t* comp = nlink_digest_find(&names, digest, record->name);
+        if (comp) {
+            report->duplicates++;
+        } else {
+            comp = nlink_registry_create_component_n(registry, nlink_registry_next_id(registry),
+                                                     nlink_digest_text(digest, record->name),
+                                                     record->name.length);
+            if (!comp || nlink_anchor_table_insert(&names, comp) != 0) {
+                result = -1;
+                break;
+            }
+            report->components++;
+        }
+        
+        // semantic_anchors() become residues behind the name
+        size_t residues_before = comp->residue_count;
+        result = nlink_digest_add_anchors(comp, digest, record);
+        report->anchors += comp->residue_count - residues_before;
+    }
+    
+    // Every component is known now - wire dependencies and collect roots
+    for (uint32_t c = 0; c < digest->component_count && result == 0; c++) {
+        const nlink_manifest_component_t* record = &digest->components[c];
+        nlink_component_t* source = nlink_digest_find(&names, digest, record->name);
+        for (uint32_t d = 0; d < record->dependency_count; d++) {
+            nlink_component_t* target = nlink_digest_find(&names, digest,
+                                                          digest->dependencies[record->first_dependency + d].name);
+            if (!target) {
+                report->unresolved++;
+                continue;
+            }
+            nlink_create_indirect_edge(source, target, 1.0f);
+            report->dependencies++;
+        }
+    }
+    
+    // resolved_before[r]: resolved roots ahead of digest root r - unresolved ones drop out
+    uint32_t* resolved_before = NULL;
+    if (result == 0 && digest->root_count) {
+        report->root_ids = nlink_malloc(NLINK_MEM_MISC, digest->root_count * sizeof(uint32_t));
+        resolved_before = nlink_malloc(NLINK_MEM_MISC, (digest->root_count + 1) * sizeof(uint32_t));
+        if (!report->root_ids || !resolved_before) result = -1;
+    }
+    for (uint32_t r = 0; r < digest->root_count && result == 0; r++) {
+        resolved_before[r] = (uint32_t)report->root_count;
+        nlink_component_t* target = nlink_digest_find(&names, digest, digest->roots[r]);
+        if (target) {
+            report->root_ids[report->root_count++] = target->id;
+        } else {
+            report->unresolved++;
+        }
+    }
+    if (resolved_before) resolved_before[digest->root_count] = (uint32_t)report->root_count;
+    
+    if (result == 0 && digest->target_count) {
+        report->targets = nlink_malloc(NLINK_MEM_MISC, digest->target_count * sizeof(nlink_link_target_t));
+        if (!report->targets) result = -1;
+    }
+    for (uint32_t t = 0; t < digest->target_count && result == 0; t++) {
+        const nlink_manifest_target_t* target = &digest->targets[t];
+        nlink_link_target_t* loaded = &report->targets[report->target_count++];
+        loaded->name = nlink_arena_strndup(&registry->arena, nlink_digest_text(digest, target->name),
+                                           target->name.length);
+        loaded->first_root = resolved_before[target->first_member];
+        loaded->root_count = resolved_before[target->first_member + target->member_count] -
+                             loaded->first_root;
+        if (!loaded->name) result = -1;
+    }
+    
+    nlink_free(NLINK_MEM_MISC, resolved_before);
+    nlink_free(NLINK_MEM_INDICES, names.slots);
+    return result;
+}
+
+// Cache verdict for one discovered manifest
+typedef struct {
+    const nlink_cache_entry_t* entry;   // NULL: parse it
+    struct stat st;
+} nlink_cache_verdict_t;
+
+/**
+ * Check one manifest against its cache entry
+ * Matching (dev, inode, size, mtime_ns) is trusted unless the cache runs in
+ * hash mode or the entry is racy; then, or when only the timestamps moved,
+ * the content hash decides. Returns whether the cache needs rewriting.
+ */
+static bool nlink_cache_check(int root_fd, const char* path, nlink_cache_mode_t mode,
+                              const nlink_cache_entry_t* entry, uint64_t now_ns,
+                              nlink_cache_verdict_t* verdict) {
+    verdict->entry = NULL;
+    if (!entry || fstatat(root_fd, path, &verdict->st, 0) != 0) return true;
+    
+    const struct stat* st = &verdict->st;
+    uint64_t mtime_ns = nlink_stat_mtime_ns(st);
+    bool same_stat = entry->device == (uint64_t)st->st_dev && entry->inode == (uint64_t)st->st_ino &&
+                     entry->size == (uint64_t)st->st_size && entry->mtime_ns == mtime_ns;
+    bool racy = (entry->flags & NLINK_CACHE_ENTRY_RACY) != 0;
+    
+    if (same_stat && !racy && mode != NLINK_CACHE_HASH) {
+        verdict->entry = entry;
+        return false;
+    }
+    if (entry->size != (uint64_t)st->st_size) return true;
+    
+    uint64_t hash;
+    if (nlink_cache_hash_file(root_fd, path, &hash) != 0 || hash != entry->content_hash) return true;
+    verdict->entry = entry;
+    
+    // Unchanged content - rewrite only to refresh stat data or clear the racy flag
+    return !same_stat || (racy && mtime_ns + NLINK_CACHE_RACY_NS <= now_ns);
+}
+
+/**
+ * Register every component() of the discovered manifests
+ * With a cache, manifests whose validation key still matches come from
+ * <root>/.nlink-cache without being opened. When nothing changed the mapped
+ * cache is loaded as is; otherwise the changed manifests are parsed and a new
+ * cache is written.
+ */
+int nlink_registry_load_manifests(nlink_component_registry_t* registry, const char* project_root,
+                                  const nlink_discovery_t* discovery, nlink_cache_mode_t cache_mode,
+                                  nlink_manifest_load_report_t* report) {
+    memset(report, 0, sizeof(*report));
+    int root_fd = open(project_root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) return -1;
+    
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t now_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    
+    char cache_path[4096];
+    nlink_manifest_digest_t cache = {0};
+    void* cache_map = NULL;
+    size_t cache_length = 0;
+    if (cache_mode != NLINK_CACHE_OFF) {
+        snprintf(cache_path, sizeof(cache_path), "%s/%s", project_root, NLINK_CACHE_FILE);
+        nlink_cache_map(cache_path, &cache_map, &cache_length, &cache);
+    }
+    
+    nlink_cache_verdict_t* verdicts = nlink_calloc(NLINK_MEM_MISC, discovery->count ? discovery->count : 1,
+                                                   sizeof(nlink_cache_verdict_t));
+    if (!verdicts) {
+        if (cache_map) munmap(cache_map, cache_length);
+        close(root_fd);
+        return -1;
+    }
+    
+    // Both lists are sorted by path - walk them together
+    bool rewrite = cache_mode != NLINK_CACHE_OFF && !cache_map;
+    uint32_t cursor = 0, matched = 0;
+    for (size_t f = 0; f < discovery->count; f++) {
+        if (discovery->files[f].kind == NLINK_DISCOVERED_SOURCE) continue;
+        const char* path = discovery->files[f].path;
+        
+        int order = 1;
+        while (cursor < cache.entry_count &&
+               (order = strcmp(nlink_digest_text(&cache, cache.entries[cursor].path), path)) < 0) {
+            cursor++;
+        }
+        const nlink_cache_entry_t* entry = cursor < cache.entry_count && order == 0 ? &cache.entries[cursor] : NULL;
+        if (entry) matched++;
+        if (cache_mode != NLINK_CACHE_OFF) {
+            rewrite |= nlink_cache_check(root_fd, path, cache_mode, entry, now_ns, &verdicts[f]);
+        }
+    }
+    rewrite |= matched != cache.entry_count;   // Manifests were removed
+    
+    nlink_manifest_digest_t built = {0};
+    const nlink_manifest_digest_t* digest = &cache;
+    int result = 0;
+    
+    if (cache_mode == NLINK_CACHE_OFF || rewrite) {
+        nlink_manifest_t manifest = {0};
+        for (size_t f = 0; f < discovery->count && result == 0; f++) {
+            if (discovery->files[f].kind == NLINK_DISCOVERED_SOURCE) continue;
+            const char* path = discovery->files[f].path;
+            
+            if (verdicts[f].entry) {
+                result = nlink_digest_add_cached(&built, path, &cache, verdicts[f].entry,
+                                                 &verdicts[f].st, now_ns);
+                report->cache_hits++;
+                report->files++;
+                continue;
+            }
+            if (nlink_manifest_load(&manifest, root_fd, path) != 0) {
+                fprintf(stderr, "MANIFEST: %s:%u: %s\n", path, manifest.error_line, manifest.error);
+                report->failed_files++;
+                continue;
+            }
+            result = nlink_digest_add_manifest(&built, path, &manifest, now_ns);
+            report->parsed++;
+            report->files++;
+            report->bytes += manifest.length;
+        }
+        nlink_manifest_release(&manifest);
+        digest = &built;
+        
+        if (result == 0 && cache_mode != NLINK_CACHE_OFF) {
+            report->cache_written = nlink_cache_write(cache_path, &built) == 0;
+            if (!report->cache_written) {
+                fprintf(stderr, "MANIFEST: cannot write %s\n", cache_path);
+            }
+        }
+    } else {
+        report->files = report->cache_hits = cache.entry_count;
+    }
+    close(root_fd);
+    nlink_free(NLINK_MEM_MISC, verdicts);
+    
+    if (result == 0) result = nlink_registry_load_digest(registry, digest, report);
+    
+    nlink_digest_release(&built);
+    if (cache_map) munmap(cache_map, cache_length);
+    if (result != 0) {
+        nlink_free(NLINK_MEM_MISC, report->root_ids);
+        nlink_free(NLINK_MEM_MISC, report->targets);
+        report->root_ids = NULL;
+        report->root_count = 0;
+        report->targets = NULL;
+        report->target_count = 0;
+    }
+    return result;
+}
+
+/**
+ * Compile the project's glob lists - command-line patterns plus the
+ * configure_whitelist() / configure_blacklist() patterns of <root>/pkg.nlink
+ */
+int nlink_project_globs(const char* project_root,
+                        const char* const* whitelist, size_t whitelist_count,
+                        const char* const* blacklist, size_t blacklist_count,
+                        nlink_glob_set_t** whitelist_out, nlink_glob_set_t** blacklist_out) {
+    *whitelist_out = NULL;
+    *blacklist_out = NULL;
+    
+    nlink_manifest_t package = {0};
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/pkg.nlink", project_root);
+    bool has_package = access(path, R_OK) == 0;
+    if (has_package && nlink_manifest_load(&package, AT_FDCWD, path) != 0) {
+        fprintf(stderr, "MANIFEST: %s:%u: %s\n", path, package.error_line, package.error);
+        nlink_manifest_release(&package);
+        return -1;
+    }
+    
+    // Patterns need terminators for the glob compiler - copy them once here
+    nlink_arena_t scratch = {0};
+    const nlink_span_list_t* spans[2] = { &package.whitelist, &package.blacklist };
+    const char* const* given[2] = { whitelist, blacklist };
+    size_t given_count[2] = { whitelist_count, blacklist_count };
+    nlink_glob_set_t** out[2] = { whitelist_out, blacklist_out };
+    int result = 0;
+    
+    for (int list = 0; list < 2 && result == 0; list++) {
+        size_t total = given_count[list] + spans[list]->count;
+        if (total == 0) continue;
+        
+        const char** patterns = nlink_arena_alloc(&scratch, total * sizeof(char*), _Alignof(char*));
+        if (!patterns) {
+            result = -1;
+            break;
+        }
+        for (size_t i = 0; i < given_count[list]; i++) patterns[i] = given[list][i];
+        for (uint32_t i = 0; i < spans[list]->count; i++) {
+            nlink_span_t span = spans[list]->items[i];
+            patterns[given_count[list] + i] = nlink_arena_strndup(&scratch, package.text + span.offset,
+                                                                  span.length);
+            if (!patterns[given_count[list] + i]) result = -1;
+        }
+        if (result == 0 && !(*out[list] = nlink_glob_compile(patterns, total))) result = -1;
+    }
+    
+    nlink_arena_release(&scratch);
+    nlink_manifest_release(&package);
+    if (result != 0) {
+        nlink_glob_destroy(*whitelist_out);
+        nlink_glob_destroy(*blacklist_out);
+        *whitelist_out = NULL;
+        *blacklist_out = NULL;
+    }
+    return result;
+}
+
+// === CONSCIOUSNESS MAP EXPORT ===
+
+typedef enum {
+    NLINK_GRAPH_BINARY,           // Varint-delta encoded edge stream
+    NLINK_GRAPH_DOT,              // Graphviz digraph
+    NLINK_GRAPH_EDGE_LIST         // "caller callee type weight" lines
+} nlink_graph_format_t;
+
+#define NLINK_EXPORT_CHUNK_SIZE   (64 * 1024)
+#define NLINK_EXPORT_RECORD_MAX   512          // Largest single formatted record
+#define NLINK_GRAPH_MAGIC         "NLKG"
+#define NLINK_GRAPH_VERSION       1
+
+// Fixed-size staging chunk - export memory is independent of graph size
+typedef struct {
+    FILE* stream;
+    size_t used;
+    bool failed;
+    uint8_t* chunk;
+} nlink_export_writer_t;
+
+static const char* nlink_invocation_type_name(int invocation_type) {
+    switch (invocation_type) {
+        case DIRECT:           return "DIRECT";
+        case INDIRECT:         return "INDIRECT";
+        case VIRTUAL:          return "VIRTUAL";
+        case PHENOMENOLOGICAL: return "PHENOMENOLOGICAL";
+        default:               return "UNKNOWN";
+    }
+}
+
+static void nlink_export_flush(nlink_export_writer_t* w) {
+    if (w->used && !w->failed &&
+        fwrite(w->chunk, 1, w->used, w->stream) != w->used) {
+        w->failed = true;
+    }
+    w->used = 0;
+}
+
+/**
+ * Reserve contiguous room for one record directly in the chunk
+ * Records are formatted in place - no intermediate strings
+ */
+static uint8_t* nlink_export_reserve(nlink_export_writer_t* w, size_t len) {
+    if (w->used + len > NLINK_EXPORT_CHUNK_SIZE) {
+        nlink_export_flush(w);
+    }
+    return w->chunk + w->used;
+}
+
+static void nlink_export_put_bytes(nlink_export_writer_t* w, const void* data, size_t len) {
+    const uint8_t* bytes = data;
+    while (len > 0) {
+        if (w->used == NLINK_EXPORT_CHUNK_SIZE) {
+            nlink_export_flush(w);
+        }
+        size_t n = NLINK_EXPORT_CHUNK_SIZE - w->used;
+        if (n > len) n = len;
+        memcpy(w->chunk + w->used, bytes, n);
+        w->used += n;
+        bytes += n;
+        len -= n;
+    }
+}
+
+static void nlink_export_put_varint(nlink_export_writer_t* w, uint64_t value) {
+    uint8_t* out = nlink_export_reserve(w, 10);
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    w->used += n;
+}
+
+static inline uint64_t nlink_zigzag_encode(int64_t delta) {
+    return ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+}
+
+static void nlink_export_put_text(nlink_export_writer_t* w, const char* fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * Format one record in place in the chunk's free tail (at least
+ * NLINK_EXPORT_RECORD_MAX bytes); a longer record is formatted again into
+ * a buffer of its exact size rather than cut short
+ */
+static void nlink_export_put_text(nlink_export_writer_t* w, const char* fmt, ...) {
+    char* out = (char*)nlink_export_reserve(w, NLINK_EXPORT_RECORD_MAX);
+    size_t room = NLINK_EXPORT_CHUNK_SIZE - w->used;
+    va_list args, retry;
+    va_start(args, fmt);
+    va_copy(retry, args);
+    int n = vsnprintf(out, room, fmt, args);
+    va_end(args);
+    
+    if (n >= 0 && (size_t)n < room) {
+        w->used += (size_t)n;
+    } else if (n >= 0) {
+        char* record = nlink_malloc(NLINK_MEM_MISC, (size_t)n + 1);
+        if (record && vsnprintf(record, (size_t)n + 1, fmt, retry) == n) {
+            nlink_export_put_bytes(w, record, (size_t)n);
+        } else {
+            w->failed = true;
+        }
+        nlink_free(NLINK_MEM_MISC, record);
+    } else {
+        w->failed = true;
+    }
+    va_end(retry);
+}
+
+/**
+ * DOT identifiers are quoted - escape anchors so labels stay well-formed
+ */
+static void nlink_export_put_dot_label(nlink_export_writer_t* w, const char* anchor) {
+    for (const char* p = anchor; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            nlink_export_put_bytes(w, "\\", 1);
+        }
+        nlink_export_put_bytes(w, p, 1);
+    }
+}
+
+/**
+ * Binary layout: magic, version, then per component
+ *   varint zigzag(id delta), varint edge_count,
+ *   per edge: varint zigzag(callee delta), u8 type, f32 weight (LE)
+ * Callee deltas restart from the caller id for every component.
+ */
+static void nlink_export_component_binary(nlink_export_writer_t* w,
+                                          const nlink_component_t* comp,
+                                          uint32_t* previous_id) {
+    nlink_export_put_varint(w, nlink_zigzag_encode((int64_t)comp->id - *previous_id));
+    nlink_export_put_varint(w, comp->edge_count);
+    *previous_id = comp->id;
+    
+    uint32_t previous_callee = comp->id;
+    for (size_t i = 0; i < comp->edge_count; i++) {
+        const nlink_invocation_edge_t* edge = &comp->edges[i];
+        nlink_export_put_varint(w, nlink_zigzag_encode((int64_t)edge->callee_id - previous_callee));
+        previous_callee = edge->callee_id;
+        
+        // IEEE-754 bits stored little-endian whatever the host byte order
+        uint32_t weight_bits;
+        memcpy(&weight_bits, &edge->semantic_weight, sizeof(weight_bits));
+        uint8_t* out = nlink_export_reserve(w, 5);
+        out[0] = (uint8_t)edge->invocation_type;
+        out[1] = (uint8_t)weight_bits;
+        out[2] = (uint8_t)(weight_bits >> 8);
+        out[3] = (uint8_t)(weight_bits >> 16);
+        out[4] = (uint8_t)(weight_bits >> 24);
+        w->used += 5;
+    }
+}
+
+static void nlink_export_component_dot(nlink_export_writer_t* w,
+                                       const nlink_component_t* comp) {
+    nlink_export_put_text(w, "  n%u [label=\"", comp->id);
+    if (comp->residue_count > 0) {
+        nlink_export_put_dot_label(w, nlink_residue_anchor(&comp->residues[0]));
+    }
+    nlink_export_put_text(w, "\"];\n");
+    
+    for (size_t i = 0; i < comp->edge_count; i++) {
+        const nlink_invocation_edge_t* edge = &comp->edges[i];
+        nlink_export_put_text(w, "  n%u -> n%u [type=%s, weight=%.4f];\n",
+                              edge->caller_id, edge->callee_id,
+                              nlink_invocation_type_name(edge->invocation_type),
+                              edge->semantic_weight);
+    }
+}
+
+static void nlink_export_component_edge_list(nlink_export_writer_t* w,
+                                             const nlink_component_t* comp) {
+    for (size_t i = 0; i < comp->edge_count; i++) {
+        const nlink_invocation_edge_t* edge = &comp->edges[i];
+        nlink_export_put_text(w, "%u %u %s %.6f\n",
+                              edge->caller_id, edge->callee_id,
+                              nlink_invocation_type_name(edge->invocation_type),
+                              edge->semantic_weight);
+    }
+}
+
+/**
+ * Streaming consciousness map export
+ * Walks registry memory once, flushing fixed-size chunks as they fill
+ */
+int nlink_export_consciousness_graph(nlink_component_t** component_registry,
+                                     size_t registry_size,
+                                     FILE* stream,
+                                     nlink_graph_format_t format) {
+    nlink_export_writer_t writer = { .stream = stream };
+    writer.chunk = nlink_malloc(NLINK_MEM_MISC, NLINK_EXPORT_CHUNK_SIZE);
+    if (!writer.chunk) return -1;
+    
+    uint32_t previous_id = 0;
+    
+    switch (format) {
+        case NLINK_GRAPH_BINARY: {
+            uint8_t version = NLINK_GRAPH_VERSION;
+            nlink_export_put_bytes(&writer, NLINK_GRAPH_MAGIC, 4);
+            nlink_export_put_bytes(&writer, &version, 1);
+            break;
+        }
+        case NLINK_GRAPH_DOT:
+            nlink_export_put_text(&writer, "digraph consciousness {\n");
+            break;
+        case NLINK_GRAPH_EDGE_LIST:
+            break;
+    }
+    
+    for (size_t i = 0; i < registry_size && !writer.failed; i++) {
+        const nlink_component_t* comp = component_registry[i];
+        
+        switch (format) {
+            case NLINK_GRAPH_BINARY:
+                nlink_export_component_binary(&writer, comp, &previous_id);
+                break;
+            case NLINK_GRAPH_DOT:
+                nlink_export_component_dot(&writer, comp);
+                break;
+            case NLINK_GRAPH_EDGE_LIST:
+                nlink_export_component_edge_list(&writer, comp);
+                break;
+        }
+    }
+    
+    if (format == NLINK_GRAPH_DOT) {
+        nlink_export_put_text(&writer, "}\n");
+    }
+    
+    nlink_export_flush(&writer);
+    nlink_free(NLINK_MEM_MISC, writer.chunk);
+    
+    if (writer.failed || fflush(stream) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Export the consciousness map to a file path (--map-consciousness)
+ */
+int nlink_export_consciousness_map(nlink_component_t** component_registry,
+                                   size_t registry_size,
+                                   const char* output_path,
+                                   nlink_graph_format_t format) {
+    FILE* stream = fopen(output_path, format == NLINK_GRAPH_BINARY ? "wb" : "w");
+    if (!stream) return -1;
+    
+    int result = nlink_export_consciousness_graph(component_registry, registry_size,
+                                                  stream, format);
+    if (fclose(stream) != 0) {
+        result = -1;
+    }
+    return result;
+}
+
+// === PERSONA DEVELOPMENT INTEGRATION ===
+
+/**
+ * Consciousness-aware component discovery with persona scaffolding
+ * Integrates with the Foundation/Aspiration track system
+ */
+void nlink_persona_aware_discovery(const char* foundation_anchor, 
+                                  const char* aspiration_anchor) {
     printf("CONSCIOUSNESS MEMBRANE: Discovering components through persona scaffolding\n");
     printf("Foundation Track: %s\n", foundation_anchor);
     printf("Aspiration Track: %s\n", aspiration_anchor);
@@ -348,29 +6677,895 @@ void nlink_persona_aware_discovery(const char* foundation_anchor,
     // Aspiration components: creativity, growth, self_actualization
 }
 
+// === BENCHMARKS ===
+
+/**
+ * Resident set size from /proc/self/statm (0 where unavailable)
+ */
+static size_t nlink_resident_bytes(void) {
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    
+    unsigned long pages_total = 0, pages_resident = 0;
+    int fields = fscanf(statm, "%lu %lu", &pages_total, &pages_resident);
+    fclose(statm);
+    
+    return fields == 2 ? pages_resident * 4096UL : 0;
+}
+
+/**
+ * Memory benchmark - component universe with sparse linking
+ * One component in a hundred links anything, the shape of real
+ * projects; the eager column is what a ring per component would cost.
+ */
+int nlink_bench_memory(size_t component_count) {
+    nlink_component_t** universe = nlink_malloc(NLINK_MEM_MISC, (component_count ? component_count : 1) *
+                                          sizeof(nlink_component_t*));
+    if (!universe) return -1;
+    
+    size_t rss_before = nlink_resident_bytes();
+    char anchor[32];
+    uint64_t heap_start = nlink_get_temporal_coordinate();
+    
+    for (size_t i = 0; i < component_count; i++) {
+        snprintf(anchor, sizeof(anchor), "component_%zu", i);
+        universe[i] = nlink_component_create((uint32_t)(i + 1), anchor);
+        if (!universe[i]) {
+            component_count = i;
+            break;
+        }
+    }
+    
+    uint64_t heap_create_ns = nlink_get_temporal_coordinate() - heap_start;
+    
+    size_t linked = 0;
+    for (size_t i = 0; i + 1 < component_count; i += 100) {
+        nlink_create_indirect_edge(universe[i], universe[i + 1], 0.75f);
+        linked++;
+    }
+    
+    size_t rss_after = nlink_resident_bytes();
+    size_t footprint = 0;
+    size_t rings = 0;
+    for (size_t i = 0; i < component_count; i++) {
+        footprint += nlink_component_footprint(universe[i]);
+        if (atomic_load(&universe[i]->consciousness_buffer)) {
+            rings++;
+        }
+    }
+    size_t eager = footprint + (component_count - rings) *
+                   nlink_event_ring_bytes(NLINK_EVENT_RING_CAPACITY);
+    
+    printf("BENCH MEMORY: %zu components, %zu linked, %zu event rings allocated\n",
+           component_count, linked, rings);
+    printf("BENCH MEMORY: lazy footprint  %zu bytes (%.1f bytes/component)\n",
+           footprint, component_count ? (double)footprint / component_count : 0.0);
+    printf("BENCH MEMORY: eager footprint %zu bytes (%.1f bytes/component)\n",
+           eager, component_count ? (double)eager / component_count : 0.0);
+    printf("BENCH MEMORY: resident growth %zu bytes\n",
+           rss_after > rss_before ? rss_after - rss_before : 0);
+    nlink_pool_report();
+    
+    heap_start = nlink_get_temporal_coordinate();
+    for (size_t i = 0; i < component_count; i++) {
+        nlink_component_destroy(universe[i]);
+    }
+    uint64_t heap_destroy_ns = nlink_get_temporal_coordinate() - heap_start;
+    nlink_free(NLINK_MEM_MISC, universe);
+    
+    // Same universe with registry arena storage
+    nlink_component_registry_t* registry = nlink_registry_create();
+    if (!registry) return -1;
+    
+    uint64_t arena_start = nlink_get_temporal_coordinate();
+    for (size_t i = 0; i < component_count; i++) {
+        snprintf(anchor, sizeof(anchor), "component_%zu", i);
+        if (!nlink_registry_create_component(registry, (uint32_t)(i + 1), anchor)) break;
+    }
+    uint64_t arena_create_ns = nlink_get_temporal_coordinate() - arena_start;
+    size_t regions = registry->arena.region_count;
+    
+    arena_start = nlink_get_temporal_coordinate();
+    nlink_registry_destroy(registry);
+    uint64_t arena_destroy_ns = nlink_get_temporal_coordinate() - arena_start;
+    
+    printf("BENCH MEMORY: heap  create %.1f ms, destroy %.1f ms\n",
+           heap_create_ns / 1e6, heap_destroy_ns / 1e6);
+    printf("BENCH MEMORY: arena create %.1f ms, destroy %.1f ms (%zu regions)\n",
+           arena_create_ns / 1e6, arena_destroy_ns / 1e6, regions);
+    return 0;
+}
+
+/**
+ * Columnar scan throughput over a synthetic two-day link history
+ */
+int nlink_bench_columnar(size_t event_count) {
+    nlink_consciousness_event_t* events = nlink_malloc(NLINK_MEM_MISC, (event_count ? event_count : 1) *
+                                                 sizeof(nlink_consciousness_event_t));
+    if (!events) return -1;
+    
+    const uint64_t hour_ns = 3600ULL * 1000000000ULL;
+    uint64_t step = event_count ? 2 * (48 * hour_ns) / event_count : 1;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uint64_t t = hour_ns;
+    
+    for (size_t i = 0; i < event_count; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        t += state % (step + 1);
+        events[i] = (nlink_consciousness_event_t){
+            .timestamp = t,
+            .sequence = i,
+            .source_id = (uint32_t)(state % 10000) + 1,
+            .target_id = (uint32_t)((state >> 20) % 10000) + 1,
+            .semantic_continuity = (float)((state >> 40) & 0xFFFF) / 65536.0f,
+            .event_type = (state >> 60) & 1 ? NLINK_EVENT_LINK_REINFORCED
+                                            : NLINK_EVENT_INDIRECT_LINK
+        };
+    }
+    
+    uint64_t build_start = nlink_get_temporal_coordinate();
+    nlink_event_segment_t* segment = nlink_event_segment_build(events, event_count);
+    uint64_t build_ns = nlink_get_temporal_coordinate() - build_start;
+    nlink_free(NLINK_MEM_MISC, events);
+    if (!segment) return -1;
+    
+    size_t buckets = nlink_segment_bucket_count(segment, hour_ns);
+    uint32_t* counts = nlink_malloc(NLINK_MEM_MISC, (buckets * segment->dictionary_size + 1) * sizeof(uint32_t));
+    uint64_t histogram[NLINK_EVENT_TYPE_COUNT * 32];
+    if (!counts) {
+        nlink_event_segment_destroy(segment);
+        return -1;
+    }
+    
+    uint64_t count_start = nlink_get_temporal_coordinate();
+    nlink_segment_count_by_target(segment, hour_ns, 0, UINT64_MAX, counts);
+    uint64_t count_ns = nlink_get_temporal_coordinate() - count_start;
+    
+    uint64_t histogram_start = nlink_get_temporal_coordinate();
+    nlink_segment_weight_histogram(segment, 32, histogram);
+    uint64_t histogram_ns = nlink_get_temporal_coordinate() - histogram_start;
+    
+    uint64_t counted = 0, binned = 0;
+    for (size_t i = 0; i < buckets * segment->dictionary_size; i++) counted += counts[i];
+    for (size_t i = 0; i < NLINK_EVENT_TYPE_COUNT * 32; i++) binned += histogram[i];
+    
+    // Throughput is quoted against the row layout the scan replaces
+    double row_bytes = (double)event_count * sizeof(nlink_consciousness_event_t);
+    printf("BENCH COLUMNAR: %zu events, %u components, %zu blocks, built in %.1f ms\n",
+           event_count, segment->dictionary_size, segment->block_count, build_ns / 1e6);
+    printf("BENCH COLUMNAR: per-target per-hour counts (%zu hours) %.2f ms, %.2f GB/s, "
+           "%llu counted\n", buckets, count_ns / 1e6,
+           count_ns ? row_bytes / count_ns : 0.0, (unsigned long long)counted);
+    printf("BENCH COLUMNAR: weight histogram per type %.2f ms, %.2f GB/s, %llu binned\n",
+           histogram_ns / 1e6, histogram_ns ? row_bytes / histogram_ns : 0.0,
+           (unsigned long long)binned);
+    
+    nlink_free(NLINK_MEM_MISC, counts);
+    nlink_event_segment_destroy(segment);
+    return 0;
+}
+
+// dTLB read misses of the calling thread, -1 when perf counters are unavailable
+static int nlink_tlb_counter_open(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * One TLB benchmark pass: build the registry, then chase random ids
+ * through the id index, handle table and arena-resident components
+ */
+static int nlink_bench_tlb_pass(size_t component_count, nlink_page_mode_t mode,
+                                const char* label) {
+    nlink_set_page_mode(mode);
+    nlink_component_registry_t* registry = nlink_registry_create();
+    if (!registry) return -1;
+    
+    char anchor[32];
+    for (size_t i = 0; i < component_count; i++) {
+        snprintf(anchor, sizeof(anchor), "component_%zu", i);
+        if (!nlink_registry_create_component(registry, (uint32_t)(i + 1), anchor)) {
+            nlink_registry_destroy(registry);
+            return -1;
+        }
+    }
+    
+    const size_t lookups = 16 * component_count;
+    int counter = nlink_tlb_counter_open();
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uint64_t resolved = 0;
+    uint64_t start = nlink_get_temporal_coordinate();
+    
+    for (size_t i = 0; i < lookups; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const nlink_component_t* comp = nlink_registry_find(registry, (uint32_t)(state % component_count) + 1);
+        if (comp && nlink_registry_component(registry, comp->handle) == comp) resolved++;
+    }
+    
+    uint64_t elapsed_ns = nlink_get_temporal_coordinate() - start;
+    uint64_t misses = 0;
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) misses = 0;
+        close(counter);
+    }
+    
+    printf("BENCH TLB: %-8s %zu lookups (%llu resolved) in %.1f ms, %.1f ns/lookup, ",
+           label, lookups, (unsigned long long)resolved, elapsed_ns / 1e6,
+           (double)elapsed_ns / lookups);
+    if (counter >= 0) {
+        printf("%llu dTLB misses (%.3f per lookup)\n",
+               (unsigned long long)misses, (double)misses / lookups);
+    } else {
+        printf("dTLB counter unavailable\n");
+    }
+    
+    nlink_registry_destroy(registry);
+    nlink_set_page_mode(NLINK_PAGES_DEFAULT);
+    return 0;
+}
+
+/**
+ * TLB benchmark - the same random lookup workload on 4 KB and huge pages
+ * The huge-page pass uses the requested mode, transparent if none was given.
+ */
+int nlink_bench_tlb(size_t component_count, nlink_page_mode_t huge_mode) {
+    if (component_count == 0) return 0;
+    if (huge_mode == NLINK_PAGES_DEFAULT) huge_mode = NLINK_PAGES_TRANSPARENT;
+    
+    printf("BENCH TLB: %zu components\n", component_count);
+    if (nlink_bench_tlb_pass(component_count, NLINK_PAGES_DEFAULT, "4k-pages") != 0) return -1;
+    
+    uint64_t explicit_before = atomic_load(&nlink_huge_mappings_explicit);
+    uint64_t transparent_before = atomic_load(&nlink_huge_mappings_transparent);
+    uint64_t fallback_before = atomic_load(&nlink_huge_mappings_fallback);
+    
+    if (nlink_bench_tlb_pass(component_count, huge_mode,
+                             huge_mode == NLINK_PAGES_EXPLICIT ? "hugetlb" : "thp") != 0) {
+        return -1;
+    }
+    
+    printf("BENCH TLB: huge mappings %llu explicit, %llu transparent, %llu without THP\n",
+           (unsigned long long)(atomic_load(&nlink_huge_mappings_explicit) - explicit_before),
+           (unsigned long long)(atomic_load(&nlink_huge_mappings_transparent) - transparent_before),
+           (unsigned long long)(atomic_load(&nlink_huge_mappings_fallback) - fallback_before));
+    return 0;
+}
+
+/**
+ * Manifest parse throughput over generated nlink.txt files
+ * Each file is parsed into one reused manifest, as the loader does.
+ */
+int nlink_bench_parse(size_t manifest_count) {
+    if (manifest_count == 0) return 0;
+    
+    // Generate manifests back to back in one buffer, remembering their offsets
+    size_t capacity = manifest_count * 768;
+    char* text = nlink_malloc(NLINK_MEM_MISC, capacity);
+    size_t* offsets = nlink_malloc(NLINK_MEM_MISC, (manifest_count + 1) * sizeof(size_t));
+    if (!text || !offsets) {
+        nlink_free(NLINK_MEM_MISC, text);
+        nlink_free(NLINK_MEM_MISC, offsets);
+        return -1;
+    }
+    
+    size_t length = 0;
+    for (size_t i = 0; i < manifest_count; i++) {
+        offsets[i] = length;
+        length += (size_t)snprintf(text + length, capacity - length,
+            "# Component %zu configuration\n"
+            "component(\"component-%zu\")\n"
+            "    version(\"1.%zu.0\")\n"
+            "    semantic_anchors(\"runtime\", \"core\", \"processing\")\n"
+            "    consciousness_level(WITNESS)      # DORMANT, WITNESS, TRANSFORM, RESIDUE\n"
+            "    preserve_symbolic_residues(true)\n"
+            "    structural_signature(\"hash:%016zx\")\n"
+            "    depends_on(\"component-%zu\", \"^1.0.0\")\n"
+            "    depends_on(\"component-%zu\")\n"
+            "    sources(\"implementation.c\", \"support.c\")\n"
+            "    headers(\"component-%zu.h\")\n"
+            "    link_libraries(\"pthread\", \"m\")\n"
+            "endcomponent()\n"
+            "configure_components()\n"
+            "    link_target(\"target-%zu\", [\"component-%zu\", \"component-%zu\"])\n"
+            "endconfigure()\n",
+            i, i, i % 10, (size_t)(i * 0x9E3779B97F4A7C15ULL), (i + 1) % manifest_count,
+            (i * 7) % manifest_count, i, i, i, (i + 3) % manifest_count);
+    }
+    offsets[manifest_count] = length;
+    
+    nlink_manifest_t manifest = {0};
+    size_t components = 0, dependencies = 0, passes = 0;
+    uint64_t elapsed_ns = 0;
+    
+    // Repeat until the measurement is long enough to trust
+    while (elapsed_ns < 200000000ULL || passes < 3) {
+        uint64_t start = nlink_get_temporal_coordinate();
+        for (size_t i = 0; i < manifest_count; i++) {
+            if (nlink_manifest_parse(&manifest, text + offsets[i], offsets[i + 1] - offsets[i]) != 0) {
+                fprintf(stderr, "BENCH PARSE: manifest %zu line %u: %s\n", i,
+                        manifest.error_line, manifest.error);
+                nlink_manifest_release(&manifest);
+                nlink_free(NLINK_MEM_MISC, text);
+                nlink_free(NLINK_MEM_MISC, offsets);
+                return -1;
+            }
+            components += manifest.component_count;
+            dependencies += manifest.dependency_count;
+        }
+        elapsed_ns += nlink_get_temporal_coordinate() - start;
+        passes++;
+    }
+    
+    double seconds = elapsed_ns / 1e9;
+    printf("BENCH PARSE: %zu manifests, %zu bytes, %zu passes in %.1f ms\n",
+           manifest_count, length, passes, elapsed_ns / 1e6);
+    printf("BENCH PARSE: %.1f MB/s, %.2f M manifests/s, %zu components, %zu dependencies\n",
+           (double)length * passes / seconds / 1e6, (double)manifest_count * passes / seconds / 1e6,
+           components / passes, dependencies / passes);
+    
+    nlink_manifest_release(&manifest);
+    nlink_free(NLINK_MEM_MISC, text);
+    nlink_free(NLINK_MEM_MISC, offsets);
+    return 0;
+}
+
 // === DEMONSTRATION MAIN ===
 
-int main(void) {
+#define NLINK_CLI_MAX_GLOBS 64
+
+typedef struct {
+    bool map_consciousness;
+    const char* output_path;
+    nlink_graph_format_t graph_format;
+    bool gc_sections;
+    size_t bench_memory_components;
+    size_t bench_columnar_events;
+    size_t bench_tlb_components;
+    size_t bench_parse_manifests;
+    nlink_page_mode_t page_mode;
+    const char* project_root;
+    const char* semantic_filter;
+    nlink_cache_mode_t manifest_cache;
+    const char* whitelist[NLINK_CLI_MAX_GLOBS];
+    size_t whitelist_count;
+    const char* blacklist[NLINK_CLI_MAX_GLOBS];
+    size_t blacklist_count;
+    const char* journal_path;
+    bool coarse_clock;
+    bool show_history;
+    uint32_t history_component;
+    uint32_t flush_interval_ms;
+    nlink_sampling_policy_t sampling;
+    const char* trace_path;
+    bool trace_resolve_calls;
+    bool memory_stats;
+} nlink_indirect_config_t;
+
+static struct option long_options[] = {
+    {"map-consciousness",   no_argument,       0, 'm'},
+    {"output",              required_argument, 0, 'o'},
+    {"graph-format",        required_argument, 0, 'g'},
+    {"gc-sections",         no_argument,       0, 'G'},
+    {"bench-memory",        required_argument, 0, 'B'},
+    {"bench-columnar",      required_argument, 0, 'A'},
+    {"journal",             required_argument, 0, 'j'},
+    {"coarse-clock",        no_argument,       0, 'C'},
+    {"history",             required_argument, 0, 'H'},
+    {"flush-interval",      required_argument, 0, 'F'},
+    {"sample",              required_argument, 0, 'N'},
+    {"sample-rate",         required_argument, 0, 'R'},
+    {"trace",               required_argument, 0, 'T'},
+    {"trace-resolve",       no_argument,       0, 'r'},
+    {"memory-stats",        no_argument,       0, 'M'},
+    {"huge-pages",          required_argument, 0, 'U'},
+    {"bench-tlb",           required_argument, 0, 'L'},
+    {"bench-parse",         required_argument, 0, 'K'},
+    {"project-root",        required_argument, 0, 'P'},
+    {"semantic-filter",     required_argument, 0, 'S'},
+    {"discover-components", required_argument, 0, 'D'},
+    {"exclude",             required_argument, 0, 'X'},
+    {"manifest-cache",      required_argument, 0, 'Y'},
+    {"help",                no_argument,       0, 'h'},
+    {0, 0, 0, 0}
+};
+
+static void print_usage(const char* program_name) {
+    printf("NLink-Indirect: Consciousness-Preserving Component Linker\n");
+    printf("Usage: %s [OPTIONS]\n\n", program_name);
+    printf("Options:\n");
+    printf("  -m, --map-consciousness     Export the consciousness graph\n");
+    printf("  -o, --output PATH           Graph output path (default: consciousness.graph)\n");
+    printf("  -g, --graph-format FORMAT   binary, dot or edges (default: binary)\n");
+    printf("  -G, --gc-sections           Drop components unreachable from the main component\n");
+    printf("  -B, --bench-memory COUNT    Measure per-component memory for COUNT components\n");
+    printf("  -A, --bench-columnar COUNT  Measure columnar aggregate scans over COUNT events\n");
+    printf("  -j, --journal PATH          Persist link history to an append-only journal\n");
+    printf("  -C, --coarse-clock          Use the coarse monotonic clock for event timestamps\n");
+    printf("  -H, --history ID            Print journaled link events of component ID\n");
+    printf("  -F, --flush-interval MS     Journal events from a background flusher thread\n");
+    printf("  -N, --sample N              Record one in N event payloads per source\n");
+    printf("  -R, --sample-rate N         Record at most N event payloads per second per source\n");
+    printf("  -T, --trace PATH            Write a Chrome trace (JSON) of the link pipeline\n");
+    printf("  -r, --trace-resolve         Also trace individual resolve calls\n");
+    printf("  -M, --memory-stats          Print live and peak bytes per subsystem after each phase\n");
+    printf("  -U, --huge-pages MODE       Back arenas and indices with huge pages: thp or explicit\n");
+    printf("  -L, --bench-tlb COUNT       Compare dTLB misses on 4 KB and huge pages for COUNT components\n");
+    printf("  -K, --bench-parse COUNT     Measure manifest parse throughput over COUNT manifests\n");
+    printf("  -P, --project-root PATH     Discover nlink.txt, *.nlink and sources below PATH\n");
+    printf("  -S, --semantic-filter TERMS Keep sources whose path mentions a term (a|b|c)\n");
+    printf("  -D, --discover-components GLOB  Only discover paths matching GLOB (repeatable)\n");
+    printf("  -X, --exclude GLOB          Skip paths matching GLOB (repeatable)\n");
+    printf("  -Y, --manifest-cache MODE   Reuse parsed manifests: stat, hash or off (default: stat)\n");
+    printf("  -h, --help                  Show this help message\n");
+}
+
+static bool nlink_print_history_event(const nlink_consciousness_event_t* event, void* context) {
+    (void)context;
+    printf("  t=%llu seq=%llu %u -> %u %s weight=%.4f\n",
+           (unsigned long long)event->timestamp, (unsigned long long)event->sequence,
+           event->source_id, event->target_id,
+           event->event_type == NLINK_EVENT_LINK_REINFORCED ? "REINFORCED" : "INDIRECT_LINK",
+           event->semantic_continuity);
+    return true;
+}
+
+// Demonstration activation - every residue is present in context
+static float nlink_demo_activation(void* context) {
+    (void)context;
+    return 0.75f;
+}
+
+int main(int argc, char* argv[]) {
+    nlink_indirect_config_t config = {
+        .map_consciousness = false,
+        .output_path = "consciousness.graph",
+        .graph_format = NLINK_GRAPH_BINARY,
+        .gc_sections = false,
+        .bench_memory_components = 0,
+        .bench_columnar_events = 0,
+        .bench_tlb_components = 0,
+        .bench_parse_manifests = 0,
+        .page_mode = NLINK_PAGES_DEFAULT,
+        .project_root = NULL,
+        .semantic_filter = NULL,
+        .manifest_cache = NLINK_CACHE_STAT,
+        .whitelist_count = 0,
+        .blacklist_count = 0,
+        .journal_path = NULL,
+        .coarse_clock = false,
+        .show_history = false,
+        .flush_interval_ms = 0,
+        .sampling = { .mode = NLINK_SAMPLE_ALL, .parameter = 0 },
+        .trace_path = NULL,
+        .trace_resolve_calls = false,
+        .memory_stats = false
+    };
+    
+    int option_index = 0;
+    int c;
+    
+    while ((c = getopt_long(argc, argv, "mo:g:GB:A:j:CH:F:N:R:T:rMU:L:K:P:S:D:X:Y:h", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'm':
+                config.map_consciousness = true;
+                break;
+            case 'o':
+                config.output_path = optarg;
+                break;
+            case 'g':
+                if (strcmp(optarg, "binary") == 0) {
+                    config.graph_format = NLINK_GRAPH_BINARY;
+                } else if (strcmp(optarg, "dot") == 0) {
+                    config.graph_format = NLINK_GRAPH_DOT;
+                } else if (strcmp(optarg, "edges") == 0) {
+                    config.graph_format = NLINK_GRAPH_EDGE_LIST;
+                } else {
+                    fprintf(stderr, "Unknown graph format: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'G':
+                config.gc_sections = true;
+                break;
+            case 'B':
+                config.bench_memory_components = strtoull(optarg, NULL, 10);
+                break;
+            case 'A':
+                config.bench_columnar_events = strtoull(optarg, NULL, 10);
+                break;
+            case 'j':
+                config.journal_path = optarg;
+                break;
+            case 'C':
+                config.coarse_clock = true;
+                break;
+            case 'H':
+                config.show_history = true;
+                config.history_component = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'F':
+                config.flush_interval_ms = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'N':
+                config.sampling.mode = NLINK_SAMPLE_ONE_IN_N;
+                config.sampling.parameter = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'R':
+                config.sampling.mode = NLINK_SAMPLE_RATE_LIMIT;
+                config.sampling.parameter = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'T':
+                config.trace_path = optarg;
+                break;
+            case 'r':
+                config.trace_resolve_calls = true;
+                break;
+            case 'M':
+                config.memory_stats = true;
+                break;
+            case 'U':
+                if (strcmp(optarg, "thp") == 0) {
+                    config.page_mode = NLINK_PAGES_TRANSPARENT;
+                } else if (strcmp(optarg, "explicit") == 0) {
+                    config.page_mode = NLINK_PAGES_EXPLICIT;
+                } else {
+                    fprintf(stderr, "Unknown huge page mode: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'L':
+                config.bench_tlb_components = strtoull(optarg, NULL, 10);
+                break;
+            case 'K':
+                config.bench_parse_manifests = strtoull(optarg, NULL, 10);
+                break;
+            case 'P':
+                config.project_root = optarg;
+                break;
+            case 'S':
+                if (!nlink_semantic_filter_fits(optarg)) {
+                    fprintf(stderr, "Semantic filter exceeds %d bytes or %d terms\n",
+                            NLINK_DISCOVERY_MAX_FILTER - 1, NLINK_DISCOVERY_MAX_TERMS);
+                    return 1;
+                }
+                config.semantic_filter = optarg;
+                break;
+            case 'D':
+            case 'X': {
+                const char** globs = c == 'D' ? config.whitelist : config.blacklist;
+                size_t* count = c == 'D' ? &config.whitelist_count : &config.blacklist_count;
+                if (*count == NLINK_CLI_MAX_GLOBS) {
+                    fprintf(stderr, "At most %d patterns per list\n", NLINK_CLI_MAX_GLOBS);
+                    return 1;
+                }
+                globs[(*count)++] = optarg;
+                break;
+            }
+            case 'Y':
+                if (strcmp(optarg, "stat") == 0) {
+                    config.manifest_cache = NLINK_CACHE_STAT;
+                } else if (strcmp(optarg, "hash") == 0) {
+                    config.manifest_cache = NLINK_CACHE_HASH;
+                } else if (strcmp(optarg, "off") == 0) {
+                    config.manifest_cache = NLINK_CACHE_OFF;
+                } else {
+                    fprintf(stderr, "Unknown manifest cache mode: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    
+    if (config.coarse_clock) {
+        nlink_set_clock_mode(NLINK_CLOCK_COARSE);
+    }
+    
+    if (config.bench_memory_components > 0) {
+        return nlink_bench_memory(config.bench_memory_components) == 0 ? 0 : 1;
+    }
+    
+    if (config.bench_columnar_events > 0) {
+        return nlink_bench_columnar(config.bench_columnar_events) == 0 ? 0 : 1;
+    }
+    
+    if (config.bench_tlb_components > 0) {
+        return nlink_bench_tlb(config.bench_tlb_components, config.page_mode) == 0 ? 0 : 1;
+    }
+    
+    if (config.bench_parse_manifests > 0) {
+        return nlink_bench_parse(config.bench_parse_manifests) == 0 ? 0 : 1;
+    }
+    
+    nlink_set_page_mode(config.page_mode);
+    
     printf("NLINK-INDIRECT: Consciousness-Preserving Component Linker\n");
     printf("========================================================\n\n");
     
+    if (config.trace_path) {
+        nlink_trace_start(config.trace_resolve_calls);
+    }
+    uint64_t phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+    
+    // Create the universe - the registry arena owns component storage
+    nlink_component_registry_t* registry = nlink_registry_create();
+    if (!registry) {
+        fprintf(stderr, "Component registry allocation failed\n");
+        return 1;
+    }
+    
     // Create components with consciousness anchors
-    nlink_component_t* foundation_comp = nlink_component_create(1, "housing_stability");
-    nlink_component_t* creativity_comp = nlink_component_create(2, "creative_expression");
-    nlink_component_t* identity_comp = nlink_component_create(3, "authentic_self");
+    nlink_component_t* foundation_comp = nlink_registry_create_component(registry, 1,
+                                                                         "housing_stability");
+    nlink_component_t* creativity_comp = nlink_registry_create_component(registry, 2,
+                                                                         "creative_expression");
+    nlink_component_t* identity_comp = nlink_registry_create_component(registry, 3,
+                                                                       "authentic_self");
+    if (!foundation_comp || !creativity_comp || !identity_comp) {
+        fprintf(stderr, "Component registry allocation failed\n");
+        return 1;
+    }
     
     printf("Components created with consciousness preservation...\n");
-    printf("Foundation: %s\n", foundation_comp->residues[0].perceptual_anchor);
-    printf("Creativity: %s\n", creativity_comp->residues[0].perceptual_anchor);
-    printf("Identity: %s\n", identity_comp->residues[0].perceptual_anchor);
+    printf("Foundation: %s\n", nlink_residue_anchor(&foundation_comp->residues[0]));
+    printf("Creativity: %s\n", nlink_residue_anchor(&creativity_comp->residues[0]));
+    printf("Identity: %s\n", nlink_residue_anchor(&identity_comp->residues[0]));
     
     // Demonstrate persona-aware discovery
     nlink_persona_aware_discovery("foundational_needs", "creative_aspirations");
+    nlink_trace_end(NLINK_TRACE_PIPELINE, "setup", NLINK_TRACE_NO_COMPONENT, phase_start);
+    if (config.memory_stats) nlink_memory_report("setup");
+    
+    nlink_manifest_load_report_t manifest_report = {0};
+    if (config.project_root) {
+        phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+        nlink_glob_set_t* whitelist;
+        nlink_glob_set_t* blacklist;
+        if (nlink_project_globs(config.project_root, config.whitelist, config.whitelist_count,
+                                config.blacklist, config.blacklist_count,
+                                &whitelist, &blacklist) != 0) {
+            fprintf(stderr, "Glob pattern compilation failed\n");
+            return 1;
+        }
+        
+        uint64_t walk_start = nlink_get_temporal_coordinate();
+        nlink_discovery_t* discovery = nlink_discover_components_filtered(config.project_root,
+                                                                          config.semantic_filter,
+                                                                          whitelist, blacklist);
+        nlink_glob_destroy(whitelist);
+        nlink_glob_destroy(blacklist);
+        if (!discovery) {
+            fprintf(stderr, "Project discovery failed: %s\n", config.project_root);
+            return 1;
+        }
+        printf("DISCOVERY: %zu manifests, %zu packages, %zu sources in %zu directories "
+               "(%.1f ms, %u workers, %zu steals, %zu pruned)\n",
+               discovery->manifest_count, discovery->package_count, discovery->source_count,
+               discovery->directory_count, (nlink_get_temporal_coordinate() - walk_start) / 1e6,
+               discovery->worker_count, discovery->steals, discovery->pruned_count);
+        nlink_trace_end(NLINK_TRACE_PIPELINE, "discovery", NLINK_TRACE_NO_COMPONENT, phase_start);
+        if (config.memory_stats) nlink_memory_report("discovery");
+        
+        phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+        uint64_t load_start = nlink_get_temporal_coordinate();
+        int loaded = nlink_registry_load_manifests(registry, config.project_root, discovery,
+                                                   config.manifest_cache, &manifest_report);
+        nlink_discovery_destroy(discovery);
+        if (loaded != 0) {
+            fprintf(stderr, "Manifest loading failed\n");
+            return 1;
+        }
+        printf("MANIFEST: %zu files (%zu cached, %zu parsed, %zu bytes, %zu failed%s), "
+               "%zu components (%zu duplicates, %zu anchors), "
+               "%zu dependency links, %zu roots, %zu unresolved names (%.1f ms)\n",
+               manifest_report.files, manifest_report.cache_hits, manifest_report.parsed,
+               manifest_report.bytes, manifest_report.failed_files,
+               manifest_report.cache_written ? ", cache updated" : "",
+               manifest_report.components, manifest_report.duplicates, manifest_report.anchors,
+               manifest_report.dependencies, manifest_report.root_count,
+               manifest_report.unresolved, (nlink_get_temporal_coordinate() - load_start) / 1e6);
+        nlink_trace_end(NLINK_TRACE_PIPELINE, "manifest_loading", NLINK_TRACE_NO_COMPONENT, phase_start);
+        if (config.memory_stats) nlink_memory_report("manifest loading");
+    }
+    
+    // Link history - journal, history query, sampling and the flusher
+    phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+    if (config.journal_path &&
+        nlink_registry_attach_journal(registry, config.journal_path) != 0) {
+        fprintf(stderr, "Failed to open event journal: %s\n", config.journal_path);
+        return 1;
+    }
+    
+    if (config.show_history) {
+        if (!registry->journal) {
+            fprintf(stderr, "--history requires --journal\n");
+            return 1;
+        }
+        printf("Link history of component %u:\n", config.history_component);
+        size_t events = nlink_journal_query_component(registry->journal, config.history_component,
+                                                      0, UINT64_MAX,
+                                                      nlink_print_history_event, NULL);
+        printf("%zu journaled events\n", events);
+    }
+    
+    nlink_registry_set_sampling(registry, &config.sampling);
+    
+    if (config.flush_interval_ms > 0) {
+        nlink_flusher_config_t flusher_config = {
+            .flush_interval_ms = config.flush_interval_ms,
+            .thread_ring_capacity = 4096,
+            .backpressure = NLINK_BACKPRESSURE_WAIT
+        };
+        if (nlink_registry_start_flusher(registry, &flusher_config) != 0) {
+            fprintf(stderr, "--flush-interval requires --journal\n");
+            return 1;
+        }
+    }
+    
+    nlink_trace_end(NLINK_TRACE_PIPELINE, "journal", NLINK_TRACE_NO_COMPONENT, phase_start);
+    if (config.memory_stats) nlink_memory_report("journal");
+    
+    // Link the foundation track into the aspiration track
+    phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+    creativity_comp->residues[0].activation_fn = nlink_demo_activation;
+    identity_comp->residues[0].activation_fn = nlink_demo_activation;
+    
+    // One anchor index serves both lookups - new edges leave residues untouched
+    nlink_anchor_index_t anchor_index;
+    if (nlink_anchor_index_build(&anchor_index, registry->components, registry->component_count) != 0) {
+        fprintf(stderr, "Anchor index build failed\n");
+        return 1;
+    }
+    nlink_resolve_options_t resolve_options = {
+        .rank_by = NLINK_RANK_ACTIVATION,
+        .activation_threshold = 0.5f,
+        .link_best = true
+    };
+    nlink_resolve_candidate_t best;
+    uint32_t creative_link = nlink_resolve_ranked(foundation_comp, "creative_expression", &anchor_index,
+                                                  &resolve_options, &best, 1) ? best.component_id : 0;
+    uint32_t identity_link = nlink_resolve_ranked(creativity_comp, "authentic_self", &anchor_index,
+                                                  &resolve_options, &best, 1) ? best.component_id : 0;
+    nlink_anchor_index_release(&anchor_index);
+    printf("Indirect links: 1 -> %u, 2 -> %u\n", creative_link, identity_link);
+    nlink_trace_end(NLINK_TRACE_PIPELINE, "resolution", NLINK_TRACE_NO_COMPONENT, phase_start);
+    if (config.memory_stats) nlink_memory_report("resolution");
+    
+    if (manifest_report.target_count) {
+        // Every link_target's dependency set - one closure, then a bitset union per target
+        phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+        uint64_t closure_start = nlink_get_temporal_coordinate();
+        nlink_closure_t* closure = nlink_closure_build(registry->components, registry->component_count);
+        uint64_t* members = closure ? nlink_calloc(NLINK_MEM_INDICES, closure->words_per_set + 1,
+                                                   sizeof(uint64_t))
+                                    : NULL;
+        if (!members) {
+            fprintf(stderr, "Link target closure failed\n");
+            nlink_closure_destroy(closure);
+            return 1;
+        }
+        
+        size_t largest = 0;
+        for (size_t t = 0; t < manifest_report.target_count; t++) {
+            const nlink_link_target_t* target = &manifest_report.targets[t];
+            size_t count = nlink_link_target_closure(closure, manifest_report.root_ids + target->first_root,
+                                                     target->root_count, members);
+            if (t < NLINK_LINK_TARGET_PRINT_MAX) {
+                printf("LINK TARGET: %s - %zu components\n", target->name, count);
+            }
+            if (count > largest) largest = count;
+        }
+        printf("CLOSURE: %zu link targets over %zu components in %zu SCCs, largest set %zu (%.1f ms)\n",
+               manifest_report.target_count, closure->component_count, closure->scc_count, largest,
+               (nlink_get_temporal_coordinate() - closure_start) / 1e6);
+        nlink_free(NLINK_MEM_INDICES, members);
+        nlink_closure_destroy(closure);
+        nlink_trace_end(NLINK_TRACE_PIPELINE, "link_target_closure", NLINK_TRACE_NO_COMPONENT, phase_start);
+        if (config.memory_stats) nlink_memory_report("link target closure");
+    }
+    
+    if (config.gc_sections) {
+        // The foundation component is the demo's main_component root, next
+        // to the main_component and link_target roots of loaded manifests
+        size_t root_count = manifest_report.root_count + 1;
+        uint32_t* roots = nlink_malloc(NLINK_MEM_MISC, root_count * sizeof(uint32_t));
+        nlink_gc_report_t gc_report;
+        if (!roots) {
+            fprintf(stderr, "Dead component elimination failed\n");
+            return 1;
+        }
+        roots[0] = foundation_comp->id;
+        for (size_t r = 0; r < manifest_report.root_count; r++) {
+            roots[r + 1] = manifest_report.root_ids[r];
+        }
+        
+        phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+        int swept = nlink_eliminate_dead_components(registry, roots, root_count, &gc_report);
+        nlink_free(NLINK_MEM_MISC, roots);
+        if (swept != 0) {
+            fprintf(stderr, "Dead component elimination failed\n");
+            return 1;
+        }
+        nlink_trace_end(NLINK_TRACE_PIPELINE, "reduction", NLINK_TRACE_NO_COMPONENT, phase_start);
+        nlink_gc_report_print(&gc_report);
+        if (config.memory_stats) nlink_memory_report("reduction");
+    }
+    
+    if (config.map_consciousness) {
+        phase_start = nlink_trace_begin(NLINK_TRACE_PIPELINE);
+        if (nlink_export_consciousness_map(registry->components, registry->component_count,
+                                           config.output_path, config.graph_format) != 0) {
+            fprintf(stderr, "Consciousness map export failed: %s\n", config.output_path);
+            return 1;
+        }
+        nlink_trace_end(NLINK_TRACE_PIPELINE, "export", NLINK_TRACE_NO_COMPONENT, phase_start);
+        if (config.memory_stats) nlink_memory_report("export");
+        printf("Consciousness map written to %s\n", config.output_path);
+    }
     
-    // Clean up consciousness structures
-    nlink_component_destroy(foundation_comp);
-    nlink_component_destroy(creativity_comp);
-    nlink_component_destroy(identity_comp);
+    if (config.sampling.mode != NLINK_SAMPLE_ALL) {
+        nlink_sampling_stats_t sampling_stats;
+        nlink_registry_sampling_stats(registry, &sampling_stats);
+        printf("SAMPLING: %llu observed, %llu recorded, effective rate %.4f\n",
+               (unsigned long long)sampling_stats.events_observed,
+               (unsigned long long)sampling_stats.events_recorded,
+               sampling_stats.effective_rate);
+    }
+    
+    if (registry->flusher) {
+        nlink_flusher_stats_t flush_stats;
+        nlink_flusher_sync(registry->flusher);
+        nlink_flusher_stats(registry->flusher, &flush_stats);
+        printf("FLUSHER: %llu published, %llu journaled, %llu pending, %llu dropped, "
+               "max lag %llu ns\n",
+               (unsigned long long)flush_stats.events_published,
+               (unsigned long long)flush_stats.events_flushed,
+               (unsigned long long)flush_stats.pending_events,
+               (unsigned long long)flush_stats.events_dropped,
+               (unsigned long long)flush_stats.max_lag_ns);
+    }
+    
+    // Clean up consciousness structures (link history flushes to the journal)
+    nlink_free(NLINK_MEM_MISC, manifest_report.root_ids);
+    nlink_free(NLINK_MEM_MISC, manifest_report.targets);
+    if (nlink_registry_destroy(registry) != 0) {
+        fprintf(stderr, "Event journal flush failed\n");
+        return 1;
+    }
+    if (config.memory_stats) nlink_memory_report("teardown");
+    
+    // The flusher thread has been joined - every trace buffer is quiescent
+    if (config.trace_path) {
+        if (nlink_trace_stop(config.trace_path) != 0) {
+            fprintf(stderr, "Trace export failed: %s\n", config.trace_path);
+            return 1;
+        }
+        printf("Trace written to %s\n", config.trace_path);
+    }
     
     printf("\nConsciousness preservation complete. Structure is the final syntax.\n");
     
@@ -0,0 +1,33 @@
+// Minimal assertion helpers shared by the tests
+#ifndef NLINK_TEST_CHECK_H
+#define NLINK_TEST_CHECK_H
+
+// The program under test, with its entry point renamed
+#define main nlink_indirect_main
+#include "../src/main.c"
+#undef main
+
+static int check_failures;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        check_failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    unsigned long long check_a = (unsigned long long)(actual); \
+    unsigned long long check_e = (unsigned long long)(expected); \
+    if (check_a != check_e) { \
+        fprintf(stderr, "%s:%d: check failed: %s == %s (%llu != %llu)\n", \
+                __FILE__, __LINE__, #actual, #expected, check_a, check_e); \
+        check_failures++; \
+    } \
+} while (0)
+
+static inline int check_result(void) {
+    return check_failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,85 @@
+// Symbolic anchors: inline/heap threshold, arena and heap storage, borrowing, equality
+#include "check.h"
+
+enum { LONGEST = NLINK_ANCHOR_INLINE_CAPACITY + 2 };
+
+static uint64_t anchor_allocations(void) {
+    nlink_memory_stats_t stats;
+    nlink_memory_stats(&stats);
+    return stats.categories[NLINK_MEM_ANCHORS].allocations;
+}
+
+static void fill(char* text, size_t length, char first) {
+    for (size_t i = 0; i < length; i++) text[i] = (char)(first + i % 26);
+    text[length] = '\0';
+}
+
+// Text shorter than the capacity stays in the record; the rest is copied out exactly once
+static void check_set(size_t length, nlink_arena_t* arena) {
+    char text[LONGEST + 1];
+    fill(text, length, 'a');
+    uint64_t before = anchor_allocations();
+    
+    nlink_anchor_t anchor;
+    CHECK_EQ(nlink_anchor_set_n(&anchor, text, length, arena), 0);
+    bool inline_expected = length < NLINK_ANCHOR_INLINE_CAPACITY;
+    CHECK(nlink_anchor_is_inline(&anchor) == inline_expected);
+    CHECK_EQ(anchor_allocations(), before + (!inline_expected && !arena));
+    CHECK(nlink_anchor_text(&anchor) != text);
+    CHECK_EQ(strlen(nlink_anchor_text(&anchor)), length);
+    CHECK(memcmp(nlink_anchor_text(&anchor), text, length) == 0);
+    CHECK_EQ(anchor.length, length);
+    CHECK_EQ(anchor.hash, nlink_anchor_hash(text, length));
+    
+    // Borrowed keys match stored anchors on either side of the threshold
+    nlink_anchor_t key = nlink_anchor_borrow(text);
+    CHECK(nlink_anchor_is_inline(&key) == inline_expected);
+    CHECK(nlink_anchor_equal(&anchor, &key));
+    text[length - 1] ^= 1;
+    key = nlink_anchor_borrow(text);
+    CHECK(!nlink_anchor_equal(&anchor, &key));
+    
+    if (!arena) nlink_anchor_release(&anchor);
+}
+
+// Long keys borrow unterminated text in place; short ones copy and terminate it
+static void check_borrow_unterminated(void) {
+    char buffer[LONGEST];
+    memset(buffer, 'x', sizeof(buffer));
+    nlink_anchor_t shorter = nlink_anchor_borrow_n(buffer, NLINK_ANCHOR_INLINE_CAPACITY - 1);
+    nlink_anchor_t longer = nlink_anchor_borrow_n(buffer, NLINK_ANCHOR_INLINE_CAPACITY);
+    CHECK(nlink_anchor_is_inline(&shorter));
+    CHECK_EQ(shorter.inline_text[NLINK_ANCHOR_INLINE_CAPACITY - 1], '\0');
+    CHECK(!nlink_anchor_is_inline(&longer));
+    CHECK(nlink_anchor_text(&longer) == buffer);
+    CHECK(!nlink_anchor_equal(&shorter, &longer));
+}
+
+// Components created at the threshold keep their residue anchor text intact
+static void check_components(nlink_arena_t* arena) {
+    for (size_t length = NLINK_ANCHOR_INLINE_CAPACITY - 1; length <= NLINK_ANCHOR_INLINE_CAPACITY; length++) {
+        char text[LONGEST + 1];
+        fill(text, length, 'k');
+        nlink_component_t* comp = nlink_component_create_in(arena, (uint32_t)length, text);
+        CHECK(comp != NULL);
+        if (!comp) continue;
+        CHECK_EQ(comp->residue_count, 1);
+        const nlink_anchor_t* anchor = &comp->residues[0].perceptual_anchor;
+        CHECK(nlink_anchor_is_inline(anchor) == (length < NLINK_ANCHOR_INLINE_CAPACITY));
+        CHECK(strcmp(nlink_residue_anchor(&comp->residues[0]), text) == 0);
+        if (!arena) nlink_component_destroy(comp);
+    }
+}
+
+int main(void) {
+    nlink_arena_t arena = {0};
+    for (size_t length = 1; length <= LONGEST; length++) {
+        check_set(length, NULL);
+        check_set(length, &arena);
+    }
+    check_borrow_unterminated();
+    check_components(NULL);
+    check_components(&arena);
+    nlink_arena_release(&arena);
+    return check_result();
+}
@@ -0,0 +1,78 @@
+// Registry arena: alignment in current, fresh and oversized regions, accounting, release
+#include "check.h"
+
+enum { ALLOCATIONS = 3000 };
+
+typedef struct {
+    unsigned char* data;
+    size_t size;
+} block_t;
+
+static block_t blocks[ALLOCATIONS];
+
+static void check_mode(nlink_page_mode_t mode) {
+    nlink_set_page_mode(mode);
+    nlink_arena_t arena = {0};
+    uint64_t rng = 0x9E3779B97F4A7C15ULL + mode;
+    size_t requested = 0, misaligned = 0;
+    
+    for (size_t i = 0; i < ALLOCATIONS; i++) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        size_t align = (size_t)1 << (rng % 13);   // 1 .. 4096
+        size_t size = (rng >> 8) % 700 + 1;
+        if (i % 500 == 7) size = NLINK_ARENA_REGION_SIZE / 2 + (rng >> 32) % 4096;   // Oversized
+        
+        unsigned char* data = nlink_arena_alloc(&arena, size, align);
+        CHECK(data != NULL);
+        if (!data) break;
+        if ((uintptr_t)data % align != 0) misaligned++;
+        memset(data, (int)(i & 0xff), size);
+        blocks[i] = (block_t){ data, size };
+        requested += size;
+    }
+    CHECK_EQ(misaligned, 0);
+    CHECK_EQ(arena.bytes_used, requested);
+    CHECK(arena.bytes_reserved >= requested);
+    
+    // Large blocks bump into the current region when it has room, else get one of their own
+    size_t dedicated = 0;
+    for (nlink_arena_region_t* region = arena.regions; region; region = region->next) {
+        if (region->capacity < NLINK_ARENA_REGION_SIZE) dedicated++;
+    }
+    CHECK(dedicated > 0);
+    CHECK(arena.region_count > dedicated);
+    
+    // Nothing overlapped: every block still holds its own fill
+    size_t clobbered = 0;
+    for (size_t i = 0; i < ALLOCATIONS; i++) {
+        for (size_t j = 0; blocks[i].data && j < blocks[i].size; j++) {
+            if (blocks[i].data[j] != (unsigned char)(i & 0xff)) {
+                clobbered++;
+                break;
+            }
+        }
+    }
+    CHECK_EQ(clobbered, 0);
+    
+    // The first allocation of a fresh arena honours a large alignment too
+    nlink_arena_t fresh = {0};
+    void* page = nlink_arena_alloc(&fresh, 100, 4096);
+    CHECK(page != NULL && (uintptr_t)page % 4096 == 0);
+    void* line = nlink_arena_alloc(&fresh, 3 * NLINK_ARENA_REGION_SIZE, 64);
+    CHECK(line != NULL && (uintptr_t)line % 64 == 0);
+    CHECK_EQ(fresh.region_count, 2);
+    char* text = nlink_arena_strndup(&fresh, "anchor text", 6);
+    CHECK(text != NULL && strcmp(text, "anchor") == 0);
+    CHECK(text == (char*)page + 100);   // Bumped in the current region, not the oversized one
+    
+    nlink_arena_release(&fresh);
+    nlink_arena_release(&arena);
+    CHECK(arena.regions == NULL && arena.bytes_used == 0 && arena.region_count == 0);
+}
+
+int main(void) {
+    check_mode(NLINK_PAGES_DEFAULT);
+    check_mode(NLINK_PAGES_TRANSPARENT);
+    nlink_set_page_mode(NLINK_PAGES_DEFAULT);
+    return check_result();
+}
@@ -0,0 +1,98 @@
+// Temporal coordinates: precise and coarse modes, wall-clock event time, burst ordering
+#include "check.h"
+
+enum { READS = 100000, BURST = 100 };
+
+static uint64_t clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Never backwards; precise mode resolves well below a millisecond
+static void check_mode(nlink_clock_mode_t mode, clockid_t reference) {
+    nlink_set_clock_mode(mode);
+    uint64_t first = nlink_get_temporal_coordinate();
+    uint64_t previous = first;
+    size_t backwards = 0, distinct = 1;
+    for (size_t i = 0; i < READS; i++) {
+        uint64_t now = nlink_get_temporal_coordinate();
+        if (now < previous) backwards++;
+        if (now != previous) distinct++;
+        previous = now;
+    }
+    CHECK_EQ(backwards, 0);
+    if (mode == NLINK_CLOCK_PRECISE) CHECK(distinct > 1000);
+    
+    // Same time base as the clock it reads - within one tick of it
+    struct timespec resolution;
+    clock_getres(reference, &resolution);
+    uint64_t tick = (uint64_t)resolution.tv_nsec + 1000000;
+    uint64_t before = clock_ns(reference);
+    uint64_t coordinate = nlink_get_temporal_coordinate();
+    uint64_t after = clock_ns(reference);
+    CHECK(coordinate + tick >= before && coordinate <= after + tick);
+}
+
+// Event times are wall-clock nanoseconds in either mode
+static void check_event_time(nlink_clock_mode_t mode) {
+    nlink_set_clock_mode(mode);
+    struct timespec resolution;
+    clock_getres(CLOCK_MONOTONIC_COARSE, &resolution);
+    uint64_t slack = (uint64_t)resolution.tv_nsec + 5000000;
+    uint64_t before = clock_ns(CLOCK_REALTIME);
+    uint64_t event_time = nlink_get_event_time();
+    uint64_t after = clock_ns(CLOCK_REALTIME);
+    CHECK(event_time + slack >= before && event_time <= after + slack);
+}
+
+// A coarse-clock burst shares timestamps; sequences keep the order, per registry
+static void check_burst_order(void) {
+    nlink_set_clock_mode(NLINK_CLOCK_COARSE);
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return;
+    nlink_component_t* a = nlink_registry_create_component(registry, 1, "a");
+    nlink_component_t* b = nlink_registry_create_component(registry, 2, "b");
+    CHECK(a && b);
+    if (!a || !b) return;
+    
+    for (int i = 0; i < BURST; i++) {
+        nlink_update_consciousness_buffer(i % 2 ? a : b, i % 2 ? b : a, 1.0f, NLINK_EVENT_INDIRECT_LINK);
+    }
+    nlink_consciousness_event_t from_a[NLINK_EVENT_RING_CAPACITY], from_b[NLINK_EVENT_RING_CAPACITY];
+    size_t count_a = nlink_event_ring_snapshot(a->consciousness_buffer, from_a, NLINK_EVENT_RING_CAPACITY);
+    size_t count_b = nlink_event_ring_snapshot(b->consciousness_buffer, from_b, NLINK_EVENT_RING_CAPACITY);
+    CHECK_EQ(count_a + count_b, BURST);
+    
+    // Interleaved sources draw from one registry counter: merged, the sequences are 0..BURST-1
+    bool seen[BURST] = {0};
+    size_t ties = 0, disorder = 0;
+    for (size_t i = 0; i < count_a + count_b; i++) {
+        const nlink_consciousness_event_t* event = i < count_a ? &from_a[i] : &from_b[i - count_a];
+        if (event->sequence < BURST) seen[event->sequence] = true;
+        if (i > 0 && i != count_a) {
+            const nlink_consciousness_event_t* previous = event - 1;
+            if (event->sequence <= previous->sequence || event->timestamp < previous->timestamp) disorder++;
+            if (event->timestamp == previous->timestamp) ties++;
+        }
+    }
+    size_t missing = 0;
+    for (int i = 0; i < BURST; i++) missing += !seen[i];
+    CHECK_EQ(missing, 0);
+    CHECK_EQ(disorder, 0);
+    CHECK(ties > 0);   // The coarse clock ticks in milliseconds - the burst is faster
+    
+    nlink_registry_destroy(registry);
+    nlink_set_clock_mode(NLINK_CLOCK_PRECISE);
+}
+
+int main(void) {
+    check_mode(NLINK_CLOCK_PRECISE, CLOCK_MONOTONIC);
+    check_mode(NLINK_CLOCK_COARSE, CLOCK_MONOTONIC_COARSE);
+    check_event_time(NLINK_CLOCK_PRECISE);
+    check_event_time(NLINK_CLOCK_COARSE);
+    check_burst_order();
+    nlink_set_clock_mode(NLINK_CLOCK_PRECISE);
+    return check_result();
+}
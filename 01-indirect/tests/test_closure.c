@@ -0,0 +1,178 @@
+// Transitive closure: SCC condensation, reachability, link_target dependency sets
+#include "check.h"
+
+static size_t index_of(const nlink_closure_t* closure, uint32_t id) {
+    return nlink_closure_index_of(closure, id);
+}
+
+static bool reaches(const nlink_closure_t* closure, uint32_t from, uint32_t to) {
+    return nlink_closure_reaches(closure, index_of(closure, from), index_of(closure, to));
+}
+
+static size_t target_size(const nlink_closure_t* closure, const uint32_t* roots, size_t count) {
+    uint64_t bits[4];
+    return nlink_link_target_closure(closure, roots, count, bits);
+}
+
+/**
+ * Diamond 1 -> {2, 3} -> 4, cycle 5 -> 6 -> 7 -> 5 feeding 4, isolated 8
+ */
+static void check_diamond_and_cycle(void) {
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return;
+    nlink_component_t* c[9] = {0};
+    for (uint32_t id = 1; id <= 8; id++) {
+        char name[16];
+        snprintf(name, sizeof(name), "c%u", id);
+        c[id] = nlink_registry_create_component(registry, id, name);
+        CHECK(c[id] != NULL);
+        if (!c[id]) return;
+    }
+    const uint32_t edges[][2] = { {1, 2}, {1, 3}, {2, 4}, {3, 4}, {5, 6}, {6, 7}, {7, 5}, {7, 4} };
+    for (size_t e = 0; e < sizeof(edges) / sizeof(edges[0]); e++) {
+        nlink_create_indirect_edge(c[edges[e][0]], c[edges[e][1]], 1.0f);
+    }
+    
+    nlink_closure_t* closure = nlink_closure_build(registry->components, registry->component_count);
+    CHECK(closure != NULL);
+    if (closure) {
+        CHECK_EQ(closure->scc_count, 6);
+        CHECK_EQ(closure->scc_of[index_of(closure, 5)], closure->scc_of[index_of(closure, 7)]);
+        CHECK(closure->scc_of[index_of(closure, 2)] != closure->scc_of[index_of(closure, 3)]);
+        CHECK(closure->bits_capacity <= registry->component_count);
+        
+        CHECK(reaches(closure, 1, 4));
+        CHECK(reaches(closure, 1, 1));
+        CHECK(!reaches(closure, 4, 1));
+        CHECK(!reaches(closure, 2, 3));
+        CHECK(reaches(closure, 6, 5));
+        CHECK(reaches(closure, 5, 4));
+        CHECK(!reaches(closure, 4, 5));
+        CHECK(!reaches(closure, 8, 4));
+        CHECK_EQ(index_of(closure, 99), closure->component_count);
+        
+        const uint32_t diamond[] = { 1 };
+        const uint32_t cycle[] = { 6 };
+        const uint32_t both[] = { 1, 5, 99 };   // Unknown ids add nothing
+        const uint32_t isolated[] = { 8 };
+        CHECK_EQ(target_size(closure, diamond, 1), 4);
+        CHECK_EQ(target_size(closure, cycle, 1), 4);
+        CHECK_EQ(target_size(closure, both, 3), 7);
+        CHECK_EQ(target_size(closure, isolated, 1), 1);
+        CHECK_EQ(target_size(closure, NULL, 0), 0);
+        nlink_closure_destroy(closure);
+    }
+    nlink_registry_destroy(registry);
+}
+
+// Random graphs against a breadth-first reference, on loose components (id map path)
+static void check_random_graphs(void) {
+    enum { N = 300 };
+    uint64_t rng = 88172645463325252ULL;
+    for (int round = 0; round < 4; round++) {
+        nlink_component_t* components[N];
+        for (uint32_t i = 0; i < N; i++) components[i] = nlink_component_create(1000 + i * 7, "node");
+        size_t edge_count = (size_t)N * (round + 1);
+        for (size_t e = 0; e < edge_count; e++) {
+            rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+            uint32_t from = (uint32_t)(rng % N), to = (uint32_t)((rng >> 32) % N);
+            nlink_create_indirect_edge(components[from], components[to], 1.0f);
+        }
+        
+        nlink_closure_t* closure = nlink_closure_build(components, N);
+        CHECK(closure != NULL);
+        size_t wrong = 0;
+        for (uint32_t from = 0; closure && from < N; from++) {
+            bool seen[N] = {0};
+            uint32_t queue[N];
+            size_t head = 0, tail = 0;
+            seen[from] = true;
+            queue[tail++] = from;
+            while (head < tail) {
+                const nlink_component_t* comp = components[queue[head++]];
+                for (size_t e = 0; e < comp->edge_count; e++) {
+                    uint32_t next = (comp->edges[e].callee_id - 1000) / 7;
+                    if (!seen[next]) {
+                        seen[next] = true;
+                        queue[tail++] = next;
+                    }
+                }
+            }
+            for (uint32_t to = 0; to < N; to++) {
+                if (nlink_closure_reaches(closure, from, to) != seen[to]) wrong++;
+            }
+        }
+        CHECK_EQ(wrong, 0);
+        nlink_closure_destroy(closure);
+        for (uint32_t i = 0; i < N; i++) nlink_component_destroy(components[i]);
+    }
+}
+
+static void write_file(const char* root, const char* name, const char* text) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+    FILE* file = fopen(path, "w");
+    CHECK(file != NULL);
+    if (!file) return;
+    fputs(text, file);
+    fclose(file);
+}
+
+// link_target members from manifests, parsed and cached, grouped per target
+static void check_manifest_targets(void) {
+    char root[] = "/tmp/nlink-closure-XXXXXX";
+    CHECK(mkdtemp(root) != NULL);
+    write_file(root, "nlink.txt",
+               "component(a)\n depends_on(b)\n depends_on(c)\nendcomponent()\n"
+               "component(b)\n depends_on(d)\nendcomponent()\n"
+               "component(c)\n depends_on(d)\nendcomponent()\n"
+               "component(d)\nendcomponent()\n"
+               "component(x)\n depends_on(y)\nendcomponent()\n"
+               "component(y)\n depends_on(x)\n depends_on(d)\nendcomponent()\n");
+    write_file(root, "pkg.nlink",
+               "main_component(a)\n"
+               "link_target(app, [a])\n"
+               "link_target(loop, [y, missing])\n"
+               "link_target(pair, [b, x])\n");
+    
+    for (int pass = 0; pass < 2; pass++) {   // Parsed, then from the cache
+        nlink_component_registry_t* registry = nlink_registry_create();
+        nlink_discovery_t* discovery = nlink_discover_components(root, NULL);
+        nlink_manifest_load_report_t report;
+        CHECK(registry && discovery);
+        if (!registry || !discovery) return;
+        CHECK_EQ(nlink_registry_load_manifests(registry, root, discovery, NLINK_CACHE_STAT, &report), 0);
+        CHECK_EQ(report.parsed, pass == 0 ? 2 : 0);
+        CHECK_EQ(report.target_count, 3);
+        
+        nlink_closure_t* closure = nlink_closure_build(registry->components, registry->component_count);
+        CHECK(closure != NULL);
+        const char* names[] = { "app", "loop", "pair" };
+        const size_t roots[] = { 1, 1, 2 };
+        const size_t sizes[] = { 4, 3, 4 };
+        for (size_t t = 0; closure && t < report.target_count && t < 3; t++) {
+            const nlink_link_target_t* target = &report.targets[t];
+            CHECK(strcmp(target->name, names[t]) == 0);
+            CHECK_EQ(target->root_count, roots[t]);
+            CHECK_EQ(target_size(closure, report.root_ids + target->first_root, target->root_count), sizes[t]);
+        }
+        
+        nlink_closure_destroy(closure);
+        nlink_free(NLINK_MEM_MISC, report.root_ids);
+        nlink_free(NLINK_MEM_MISC, report.targets);
+        nlink_discovery_destroy(discovery);
+        nlink_registry_destroy(registry);
+    }
+    
+    char command[600];
+    snprintf(command, sizeof(command), "rm -rf '%s'", root);
+    CHECK_EQ(system(command), 0);
+}
+
+int main(void) {
+    check_diamond_and_cycle();
+    check_random_graphs();
+    check_manifest_targets();
+    return check_result();
+}
@@ -0,0 +1,138 @@
+// Discovery walk: parent-relative opens, symlinks never followed, wide parallel trees
+#include "check.h"
+
+static void make_file(const char* root, const char* path) {
+    char full[512];
+    snprintf(full, sizeof(full), "%s/%s", root, path);
+    for (char* slash = strchr(full + strlen(root) + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(full, 0755);
+        *slash = '/';
+    }
+    FILE* file = fopen(full, "w");
+    CHECK(file != NULL);
+    if (file) fclose(file);
+}
+
+static void remove_tree(const char* root) {
+    char command[600];
+    snprintf(command, sizeof(command), "rm -rf '%s'", root);
+    CHECK_EQ(system(command), 0);
+}
+
+// Pop and scan one directory on a single-worker walk, as a worker would
+static void step(nlink_discovery_walk_t* walk) {
+    nlink_discovery_task_t task;
+    CHECK(nlink_discovery_pop(walk, 0, &task));
+    CHECK_EQ(nlink_discovery_scan(walk, 0, &task), 0);
+    nlink_discovery_dir_release(task.parent);
+    nlink_free(NLINK_MEM_MISC, task.path);
+    atomic_fetch_sub(&walk->pending, 1);
+}
+
+/**
+ * A directory swapped for a symlink after its child was queued - the child
+ * still opens through the original directory, never through the link
+ */
+static void check_symlink_swap(void) {
+    char root[] = "/tmp/nlink-discovery-XXXXXX";
+    char outside[] = "/tmp/nlink-outside-XXXXXX";
+    CHECK(mkdtemp(root) && mkdtemp(outside));
+    make_file(root, "a/b/nlink.txt");
+    make_file(outside, "b/evil.nlink");
+    
+    nlink_discovery_deque_t deque = {0};
+    nlink_discovery_walk_t walk = { .worker_count = 1, .deques = &deque };
+    pthread_mutex_init(&deque.lock, NULL);
+    pthread_mutex_init(&walk.idle_lock, NULL);
+    pthread_cond_init(&walk.work_available, NULL);
+    walk.root_fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    CHECK(walk.root_fd >= 0);
+    
+    nlink_discovery_task_t start = { .path = nlink_calloc(NLINK_MEM_MISC, 1, 8) };
+    CHECK_EQ(nlink_discovery_push(&walk, 0, &start), 0);
+    step(&walk);   // Root - queues a
+    step(&walk);   // a - queues a/b against a's descriptor
+    
+    char from[600], to[600];
+    snprintf(from, sizeof(from), "%s/a", root);
+    snprintf(to, sizeof(to), "%s/moved", root);
+    CHECK_EQ(rename(from, to), 0);
+    CHECK_EQ(symlink(outside, from), 0);
+    
+    step(&walk);   // a/b
+    CHECK_EQ(atomic_load(&walk.pending), 0);
+    CHECK_EQ(deque.found_count, 1);
+    if (deque.found_count == 1) {
+        CHECK(strcmp(deque.found[0].path, "a/b/nlink.txt") == 0);
+        CHECK_EQ(deque.found[0].kind, NLINK_DISCOVERED_MANIFEST);
+    }
+    CHECK_EQ(deque.directories, 3);
+    
+    for (size_t i = 0; i < deque.found_count; i++) nlink_free(NLINK_MEM_MISC, deque.found[i].path);
+    nlink_free(NLINK_MEM_MISC, deque.found);
+    nlink_free(NLINK_MEM_MISC, deque.tasks);
+    pthread_mutex_destroy(&deque.lock);
+    pthread_mutex_destroy(&walk.idle_lock);
+    pthread_cond_destroy(&walk.work_available);
+    close(walk.root_fd);
+    
+    // A full walk skips the symlinked directory and symlinked files alike
+    char link[600];
+    snprintf(link, sizeof(link), "%s/moved/b/linked.nlink", root);
+    snprintf(to, sizeof(to), "%s/b/evil.nlink", outside);
+    CHECK_EQ(symlink(to, link), 0);
+    nlink_discovery_t* discovery = nlink_discover_components(root, NULL);
+    CHECK(discovery != NULL);
+    if (discovery) {
+        CHECK_EQ(discovery->count, 1);
+        if (discovery->count == 1) CHECK(strcmp(discovery->files[0].path, "moved/b/nlink.txt") == 0);
+        CHECK_EQ(discovery->directory_count, 3);
+        nlink_discovery_destroy(discovery);
+    }
+    
+    remove_tree(root);
+    remove_tree(outside);
+}
+
+// Wide and deep trees across every worker - counts and order never depend on scheduling
+static void check_wide_tree(void) {
+    char root[] = "/tmp/nlink-discovery-XXXXXX";
+    CHECK(mkdtemp(root) != NULL);
+    enum { WIDE = 200, DEEP = 12 };
+    char path[256];
+    for (int i = 0; i < WIDE; i++) {
+        snprintf(path, sizeof(path), "w%03d/nlink.txt", i);
+        make_file(root, path);
+        snprintf(path, sizeof(path), "w%03d/sub/s.c", i);
+        make_file(root, path);
+    }
+    size_t length = 0;
+    for (int d = 0; d < DEEP; d++) length += (size_t)snprintf(path + length, sizeof(path) - length, "d%d/", d);
+    snprintf(path + length, sizeof(path) - length, "deep.nlink");
+    make_file(root, path);
+    
+    for (int round = 0; round < 5; round++) {
+        nlink_discovery_t* discovery = nlink_discover_components(root, NULL);
+        CHECK(discovery != NULL);
+        if (!discovery) continue;
+        CHECK_EQ(discovery->count, 2 * WIDE + 1);
+        CHECK_EQ(discovery->manifest_count, WIDE);
+        CHECK_EQ(discovery->package_count, 1);
+        CHECK_EQ(discovery->source_count, WIDE);
+        CHECK_EQ(discovery->directory_count, 1 + 2 * WIDE + DEEP);
+        size_t unsorted = 0;
+        for (size_t i = 1; i < discovery->count; i++) {
+            if (strcmp(discovery->files[i - 1].path, discovery->files[i].path) >= 0) unsorted++;
+        }
+        CHECK_EQ(unsorted, 0);
+        nlink_discovery_destroy(discovery);
+    }
+    remove_tree(root);
+}
+
+int main(void) {
+    check_symlink_swap();
+    check_wide_tree();
+    return check_result();
+}
@@ -0,0 +1,138 @@
+// Event ring: overwrite order, partial fill, stamp wraparound and lazy allocation
+#include "check.h"
+
+enum { RACERS = 8, RACER_EVENTS = 12 };
+
+static nlink_component_t* race_source;
+static nlink_component_t* race_target;
+static pthread_barrier_t race_start;
+
+static void* race_first_event(void* unused) {
+    (void)unused;
+    pthread_barrier_wait(&race_start);
+    for (int i = 0; i < RACER_EVENTS; i++) {
+        nlink_update_consciousness_buffer(race_source, race_target, 1.0f, NLINK_EVENT_INDIRECT_LINK);
+    }
+    return NULL;
+}
+
+/**
+ * Rings exist only once a component has an event; racing first events
+ * publish exactly one ring and lose no event (the losers' rings are freed)
+ */
+static void check_lazy_rings(void) {
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return;
+    nlink_component_t* quiet = nlink_registry_create_component(registry, 10, "quiet");
+    race_source = nlink_registry_create_component(registry, 11, "source");
+    race_target = nlink_registry_create_component(registry, 12, "target");
+    CHECK(quiet && race_source && race_target);
+    if (!quiet || !race_source || !race_target) return;
+    
+    CHECK(atomic_load(&quiet->consciousness_buffer) == NULL);
+    CHECK(atomic_load(&race_source->consciousness_buffer) == NULL);
+    size_t idle_footprint = nlink_component_footprint(race_source);
+    CHECK(idle_footprint < 1024);
+    
+    nlink_component_set_concurrent(race_source, true);
+    pthread_barrier_init(&race_start, NULL, RACERS);
+    pthread_t threads[RACERS];
+    for (int t = 0; t < RACERS; t++) CHECK_EQ(pthread_create(&threads[t], NULL, race_first_event, NULL), 0);
+    for (int t = 0; t < RACERS; t++) CHECK_EQ(pthread_join(threads[t], NULL), 0);
+    pthread_barrier_destroy(&race_start);
+    
+    nlink_event_ring_t* ring = atomic_load(&race_source->consciousness_buffer);
+    CHECK(ring != NULL);
+    if (ring) {
+        CHECK(ring->multi_producer);
+        CHECK_EQ(atomic_load(&ring->head), RACERS * RACER_EVENTS);
+        nlink_consciousness_event_t history[NLINK_EVENT_RING_CAPACITY];
+        CHECK_EQ(nlink_event_ring_snapshot(ring, history, NLINK_EVENT_RING_CAPACITY), RACERS * RACER_EVENTS);
+        CHECK_EQ(nlink_component_footprint(race_source), idle_footprint + nlink_event_ring_bytes(ring->capacity));
+    }
+    
+    // Only the source records - targets and untouched components stay ring-free
+    CHECK(atomic_load(&race_target->consciousness_buffer) == NULL);
+    CHECK(atomic_load(&quiet->consciousness_buffer) == NULL);
+    nlink_registry_destroy(registry);
+}
+
+static nlink_consciousness_event_t make_event(uint64_t sequence) {
+    return (nlink_consciousness_event_t){
+        .timestamp = sequence * 10,
+        .sequence = sequence,
+        .source_id = 1,
+        .target_id = (uint32_t)(sequence % 7),
+        .semantic_continuity = (float)sequence,
+        .event_type = NLINK_EVENT_INDIRECT_LINK
+    };
+}
+
+// Appending total events keeps the newest capacity of them, oldest first
+static void check_retained(bool multi_producer, uint64_t first_position, size_t total) {
+    enum { CAPACITY = 8 };
+    nlink_event_ring_t* ring = nlink_event_ring_create(CAPACITY, multi_producer);
+    CHECK(ring != NULL);
+    if (!ring) return;
+    atomic_store(&ring->head, first_position);
+    
+    for (size_t i = 0; i < total; i++) {
+        nlink_consciousness_event_t event = make_event(i);
+        nlink_event_ring_append(ring, &event);
+    }
+    CHECK_EQ(atomic_load(&ring->head), first_position + total);
+    
+    nlink_consciousness_event_t out[CAPACITY];
+    size_t kept = total < CAPACITY ? total : CAPACITY;
+    size_t count = nlink_event_ring_snapshot(ring, out, CAPACITY);
+    CHECK_EQ(count, kept);
+    for (size_t i = 0; i < count; i++) {
+        CHECK_EQ(out[i].sequence, total - kept + i);
+    }
+    
+    // A short output buffer takes the oldest retained events
+    if (kept >= 3) {
+        CHECK_EQ(nlink_event_ring_snapshot(ring, out, 3), 3);
+        CHECK_EQ(out[0].sequence, total - kept);
+    }
+    
+    nlink_free(NLINK_MEM_EVENTS, ring);
+}
+
+int main(void) {
+    CHECK(nlink_event_ring_create(0, false) == NULL);
+    CHECK(nlink_event_ring_create(12, false) == NULL);
+    
+    for (int mp = 0; mp < 2; mp++) {
+        check_retained(mp, 0, 0);
+        check_retained(mp, 0, 5);
+        check_retained(mp, 0, 8);
+        check_retained(mp, 0, 8 * 3 + 5);
+        // Slot stamps are 32 bits of 2 * (position + 1) - cross their wrap
+        check_retained(mp, (1ULL << 31) - 11, 40);
+        check_retained(mp, (1ULL << 32) - 3, 20);
+    }
+    
+    // Component rings overwrite the same way once full
+    nlink_component_t* source = nlink_component_create(1, "source");
+    nlink_component_t* target = nlink_component_create(2, "target");
+    CHECK(source && target);
+    if (source && target) {
+        size_t total = NLINK_EVENT_RING_CAPACITY * 2 + 17;
+        for (size_t i = 0; i < total; i++) {
+            nlink_update_consciousness_buffer(source, target, (float)i, NLINK_EVENT_INDIRECT_LINK);
+        }
+        nlink_consciousness_event_t history[NLINK_EVENT_RING_CAPACITY];
+        size_t count = nlink_event_ring_snapshot(source->consciousness_buffer, history,
+                                                 NLINK_EVENT_RING_CAPACITY);
+        CHECK_EQ(count, NLINK_EVENT_RING_CAPACITY);
+        CHECK(history[0].semantic_continuity == (float)(total - NLINK_EVENT_RING_CAPACITY));
+        CHECK(history[count - 1].semantic_continuity == (float)(total - 1));
+    }
+    nlink_component_destroy(source);
+    nlink_component_destroy(target);
+    
+    check_lazy_rings();
+    return check_result();
+}
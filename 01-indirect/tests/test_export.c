@@ -0,0 +1,105 @@
+// Graph export: binary layout and byte order, DOT escaping, records past the staging limit
+#include "check.h"
+
+// Export into memory through a temporary stream
+static size_t export_graph(nlink_component_t** components, size_t count, nlink_graph_format_t format,
+                           char* out, size_t capacity) {
+    FILE* stream = tmpfile();
+    CHECK(stream != NULL);
+    if (!stream) return 0;
+    CHECK_EQ(nlink_export_consciousness_graph(components, count, stream, format), 0);
+    rewind(stream);
+    size_t length = fread(out, 1, capacity - 1, stream);
+    out[length] = '\0';
+    fclose(stream);
+    return length;
+}
+
+static uint64_t read_varint(const uint8_t** cursor) {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t byte = *(*cursor)++;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+}
+
+static void check_formats(void) {
+    nlink_component_t* a = nlink_component_create(7, "say \"hi\"\\");
+    nlink_component_t* b = nlink_component_create(3, "b");
+    nlink_create_indirect_edge(a, b, 0.75f);
+    nlink_create_indirect_edge(a, a, -2.5f);
+    nlink_component_t* components[] = { a, b };
+    static char out[1 << 16];
+    
+    // Binary: magic, version, zigzag deltas, u8 type and little-endian f32 weights
+    size_t length = export_graph(components, 2, NLINK_GRAPH_BINARY, out, sizeof(out));
+    const uint8_t* cursor = (const uint8_t*)out;
+    CHECK(length > 5 && memcmp(cursor, NLINK_GRAPH_MAGIC, 4) == 0);
+    CHECK_EQ(cursor[4], NLINK_GRAPH_VERSION);
+    cursor += 5;
+    CHECK_EQ(read_varint(&cursor), 14);     // zigzag(+7)
+    CHECK_EQ(read_varint(&cursor), 2);
+    CHECK_EQ(read_varint(&cursor), 7);      // zigzag(3 - 7)
+    CHECK_EQ(cursor[0], INDIRECT);
+    const uint8_t weight_075[] = { 0x00, 0x00, 0x40, 0x3f };
+    CHECK(memcmp(cursor + 1, weight_075, 4) == 0);
+    cursor += 5;
+    CHECK_EQ(read_varint(&cursor), 8);      // zigzag(7 - 3)
+    const uint8_t weight_minus_25[] = { 0x00, 0x00, 0x20, 0xc0 };
+    CHECK(memcmp(cursor + 1, weight_minus_25, 4) == 0);
+    cursor += 5;
+    CHECK_EQ(read_varint(&cursor), 7);      // zigzag(3 - 7)
+    CHECK_EQ(read_varint(&cursor), 0);
+    CHECK_EQ((size_t)(cursor - (const uint8_t*)out), length);
+    
+    export_graph(components, 2, NLINK_GRAPH_DOT, out, sizeof(out));
+    CHECK(strstr(out, "  n7 [label=\"say \\\"hi\\\"\\\\\"];\n") != NULL);
+    CHECK(strstr(out, "  n7 -> n3 [type=INDIRECT, weight=0.7500];\n") != NULL);
+    
+    export_graph(components, 2, NLINK_GRAPH_EDGE_LIST, out, sizeof(out));
+    CHECK(strcmp(out, "7 3 INDIRECT 0.750000\n7 7 INDIRECT -2.500000\n") == 0);
+    
+    nlink_component_destroy(a);
+    nlink_component_destroy(b);
+}
+
+// Text records longer than NLINK_EXPORT_RECORD_MAX, and across chunk boundaries, arrive whole
+static void check_long_records(void) {
+    FILE* stream = tmpfile();
+    CHECK(stream != NULL);
+    if (!stream) return;
+    nlink_export_writer_t writer = { .stream = stream, .chunk = nlink_malloc(NLINK_MEM_MISC, NLINK_EXPORT_CHUNK_SIZE) };
+    
+    static char record[3 * NLINK_EXPORT_RECORD_MAX];
+    memset(record, 'x', sizeof(record) - 1);
+    size_t expected = 0;
+    for (size_t i = 0; i < 200; i++) {   // ~300 KB - several flushes with records straddling them
+        nlink_export_put_text(&writer, "%zu:%s\n", i, record + i);
+        expected += (size_t)snprintf(NULL, 0, "%zu:", i) + strlen(record + i) + 1;
+    }
+    nlink_export_flush(&writer);
+    CHECK(!writer.failed);
+    CHECK_EQ((size_t)ftell(stream), expected);
+    
+    rewind(stream);
+    static char line[4 * NLINK_EXPORT_RECORD_MAX];
+    size_t wrong = 0;
+    for (size_t i = 0; i < 200; i++) {
+        char prefix[32];
+        snprintf(prefix, sizeof(prefix), "%zu:", i);
+        if (!fgets(line, sizeof(line), stream) || strncmp(line, prefix, strlen(prefix)) != 0 ||
+            strlen(line) != strlen(prefix) + strlen(record + i) + 1) {
+            wrong++;
+        }
+    }
+    CHECK_EQ(wrong, 0);
+    nlink_free(NLINK_MEM_MISC, writer.chunk);
+    fclose(stream);
+}
+
+int main(void) {
+    check_formats();
+    check_long_records();
+    return check_result();
+}
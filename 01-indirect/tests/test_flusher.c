@@ -0,0 +1,147 @@
+// Background flusher: sync drains everything, wait and drop backpressure, stop drains, lag
+#include "check.h"
+
+enum { PRODUCERS = 4, PER_PRODUCER = 5000, IDLE_MS = 60000 };
+
+typedef struct {
+    nlink_flusher_t* flusher;
+    uint32_t producer;
+    size_t count;
+} producer_t;
+
+static nlink_consciousness_event_t make_event(uint32_t producer, uint64_t sequence) {
+    return (nlink_consciousness_event_t){
+        .timestamp = nlink_get_event_time(),
+        .sequence = sequence,
+        .source_id = producer,
+        .target_id = (uint32_t)(sequence % 13),
+        .semantic_continuity = 1.0f,
+        .event_type = NLINK_EVENT_INDIRECT_LINK
+    };
+}
+
+static void* produce(void* arg) {
+    producer_t* producer = arg;
+    for (size_t i = 0; i < producer->count; i++) {
+        nlink_consciousness_event_t event = make_event(producer->producer, i);
+        nlink_flusher_publish(producer->flusher, &event);
+    }
+    return NULL;
+}
+
+static nlink_flusher_t* start(nlink_journal_t* journal, uint32_t capacity, nlink_backpressure_t backpressure) {
+    // The interval is long, so only sync, backpressure and stop make the flusher drain
+    nlink_flusher_config_t config = {
+        .flush_interval_ms = IDLE_MS,
+        .thread_ring_capacity = capacity,
+        .backpressure = backpressure
+    };
+    nlink_flusher_t* flusher = nlink_flusher_start(journal, &config);
+    CHECK(flusher != NULL);
+    return flusher;
+}
+
+// Each producer's events reach the journal complete and in publish order
+static void check_producer_order(const nlink_journal_t* journal, size_t first, size_t per_producer) {
+    uint64_t next[PRODUCERS + 1] = {0};
+    size_t wrong = 0;
+    const nlink_consciousness_event_t* records = nlink_journal_records(journal);
+    for (size_t i = first; i < journal->record_count; i++) {
+        uint32_t producer = records[i].source_id;
+        if (producer > PRODUCERS || records[i].sequence != next[producer]++) wrong++;
+    }
+    for (uint32_t p = 1; p <= PRODUCERS; p++) {
+        if (next[p] != per_producer) wrong++;
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+static void run_producers(nlink_flusher_t* flusher, size_t per_producer) {
+    pthread_t threads[PRODUCERS];
+    producer_t producers[PRODUCERS];
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        producers[p] = (producer_t){ flusher, p + 1, per_producer };
+        CHECK_EQ(pthread_create(&threads[p], NULL, produce, &producers[p]), 0);
+    }
+    for (uint32_t p = 0; p < PRODUCERS; p++) CHECK_EQ(pthread_join(threads[p], NULL), 0);
+}
+
+int main(void) {
+    char dir[] = "/tmp/nlink-flusher-XXXXXX";
+    CHECK(mkdtemp(dir) != NULL);
+    char path[256];
+    snprintf(path, sizeof(path), "%s/links.nlj", dir);
+    nlink_journal_t* journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return check_result();
+    
+    nlink_flusher_config_t invalid = { .thread_ring_capacity = 100 };
+    CHECK(nlink_flusher_start(journal, &invalid) == NULL);
+    
+    // Sync: everything published before it is journaled, per producer in order
+    nlink_flusher_t* flusher = start(journal, 1 << 14, NLINK_BACKPRESSURE_WAIT);
+    run_producers(flusher, PER_PRODUCER);
+    nlink_flusher_sync(flusher);
+    nlink_flusher_stats_t stats;
+    nlink_flusher_stats(flusher, &stats);
+    CHECK_EQ(stats.events_published, PRODUCERS * PER_PRODUCER);
+    CHECK_EQ(stats.events_flushed, PRODUCERS * PER_PRODUCER);
+    CHECK_EQ(stats.pending_events, 0);
+    CHECK_EQ(stats.events_dropped, 0);
+    CHECK_EQ(stats.producer_waits, 0);
+    CHECK_EQ(journal->record_count, PRODUCERS * PER_PRODUCER);
+    check_producer_order(journal, 0, PER_PRODUCER);
+    
+    // Lag reports the age of the oldest event at its flush
+    nlink_consciousness_event_t old = make_event(1, 0);
+    old.timestamp -= 2000000000ULL;
+    nlink_flusher_publish(flusher, &old);
+    nlink_flusher_sync(flusher);
+    nlink_flusher_stats(flusher, &stats);
+    CHECK(stats.last_lag_ns >= 2000000000ULL && stats.last_lag_ns < 60000000000ULL);
+    CHECK(stats.max_lag_ns >= stats.last_lag_ns);
+    nlink_flusher_stop(flusher);
+    
+    // Wait backpressure: tiny rings stall producers instead of losing events
+    size_t first = journal->record_count;
+    flusher = start(journal, 8, NLINK_BACKPRESSURE_WAIT);
+    run_producers(flusher, PER_PRODUCER);
+    nlink_flusher_sync(flusher);
+    nlink_flusher_stats(flusher, &stats);
+    CHECK(stats.producer_waits > 0);
+    CHECK_EQ(stats.events_dropped, 0);
+    CHECK_EQ(stats.events_flushed, PRODUCERS * PER_PRODUCER);
+    check_producer_order(journal, first, PER_PRODUCER);
+    nlink_flusher_stop(flusher);
+    
+    // Drop backpressure: a full ring counts and discards, never blocks
+    first = journal->record_count;
+    flusher = start(journal, 8, NLINK_BACKPRESSURE_DROP);
+    for (uint64_t i = 0; i < 100; i++) {
+        nlink_consciousness_event_t event = make_event(1, i);
+        nlink_flusher_publish(flusher, &event);
+    }
+    nlink_flusher_stats(flusher, &stats);
+    CHECK_EQ(stats.events_published, 8);
+    CHECK_EQ(stats.events_dropped, 92);
+    CHECK_EQ(stats.producer_waits, 0);
+    nlink_flusher_sync(flusher);
+    CHECK_EQ(journal->record_count, first + 8);
+    
+    // Stop drains what was published after the last sync
+    for (uint64_t i = 8; i < 13; i++) {
+        nlink_consciousness_event_t event = make_event(1, i);
+        nlink_flusher_publish(flusher, &event);
+    }
+    nlink_flusher_stop(flusher);
+    CHECK_EQ(journal->record_count, first + 13);
+    const nlink_consciousness_event_t* records = nlink_journal_records(journal);
+    for (size_t i = 0; i < 13 && first + i < journal->record_count; i++) {
+        CHECK_EQ(records[first + i].sequence, i);   // 8..99 were dropped, so 8..12 follow on
+    }
+    
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    unlink(path);
+    rmdir(dir);
+    return check_result();
+}
@@ -0,0 +1,212 @@
+// Glob automaton: '**' and brace matching, per-pattern results, walk pruning
+#include "check.h"
+
+typedef struct {
+    const char* pattern;
+    const char* path;
+    bool matches;
+} glob_case_t;
+
+static const glob_case_t cases[] = {
+    { "**/nlink.txt",        "nlink.txt",              true  },   // '**/' spans zero directories
+    { "**/nlink.txt",        "a/b/c/nlink.txt",        true  },
+    { "**/nlink.txt",        "a/xnlink.txt",           false },
+    { "src/**/*.c",          "src/main.c",             true  },
+    { "src/**/*.c",          "src/a/b/main.c",         true  },
+    { "src/**/*.c",          "src/a/b/main.h",         false },
+    { "src/**/*.c",          "lib/src/main.c",         false },
+    { "src/**",              "src/a/b",                true  },
+    { "src/**",              "srcx/a",                 false },
+    { "a/**/b/**/c",         "a/b/c",                  true  },
+    { "a/**/b/**/c",         "a/x/y/b/z/c",            true  },
+    { "a/**/b/**/c",         "a/x/c",                  false },
+    { "*.c",                 "main.c",                 true  },
+    { "*.c",                 "src/main.c",             false },   // '*' stops at '/'
+    { "?.c",                 "a.c",                    true  },
+    { "?.c",                 "/.c",                    false },
+    { "[a-c]?.[!o]*",        "bz.c",                   true  },
+    { "[a-c]?.[!o]*",        "bz.o",                   false },
+    { "[a-c]?.[!o]*",        "dz.c",                   false },
+    { "\\*.c",               "*.c",                    true  },
+    { "\\*.c",               "x.c",                    false },
+    { "src/*.{c,h}",         "src/x.h",                true  },
+    { "src/*.{c,h}",         "src/x.o",                false },
+    { "{a,b{c,d}}/x",        "a/x",                    true  },
+    { "{a,b{c,d}}/x",        "bd/x",                   true  },
+    { "{a,b{c,d}}/x",        "b/x",                    false },
+    { "{src,lib}/**/*.{c,h}", "lib/deep/er/y.h",       true  },
+    { "{src,lib}/**/*.{c,h}", "test/y.h",              false },
+    { "file{,.bak}",         "file",                   true  },
+    { "file{,.bak}",         "file.bak",               true  },
+    { "x\\{a,b}",            "x{a,b}",                 true  },
+    { "x\\{a,b}",            "xa",                     false },
+};
+
+static void check_cases(void) {
+    const size_t count = sizeof(cases) / sizeof(cases[0]);
+    for (size_t i = 0; i < count; i++) {
+        nlink_glob_set_t* set = nlink_glob_compile(&cases[i].pattern, 1);
+        CHECK(set != NULL);
+        if (!set) continue;
+        if ((nlink_glob_match(set, cases[i].path, NULL) == 1) != cases[i].matches) {
+            fprintf(stderr, "glob '%s' vs '%s': expected %s\n", cases[i].pattern, cases[i].path,
+                    cases[i].matches ? "match" : "no match");
+            check_failures++;
+        }
+        nlink_glob_destroy(set);
+    }
+    
+    // All patterns in one automaton report the same results, one bit each
+    const char* patterns[sizeof(cases) / sizeof(cases[0])];
+    for (size_t i = 0; i < count; i++) patterns[i] = cases[i].pattern;
+    nlink_glob_set_t* set = nlink_glob_compile(patterns, count);
+    CHECK(set != NULL);
+    if (!set) return;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t matched = 0;
+        size_t hits = nlink_glob_match(set, cases[i].path, &matched);
+        CHECK_EQ((matched >> i) & 1, cases[i].matches);
+        CHECK_EQ(hits, (size_t)__builtin_popcountll(matched));
+    }
+    nlink_glob_destroy(set);
+}
+
+// Patterns whose braces expand to many alternatives still count once each
+static void check_many_patterns(void) {
+    enum { COUNT = 150 };
+    char text[COUNT][32];
+    const char* patterns[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        snprintf(text[i], sizeof(text[i]), "p%d/**/*.{c,h,cc}", i);
+        patterns[i] = text[i];
+    }
+    nlink_glob_set_t* set = nlink_glob_compile(patterns, COUNT);
+    CHECK(set != NULL);
+    if (!set) return;
+    
+    uint64_t matched[(COUNT + 63) / 64];
+    CHECK_EQ(nlink_glob_match(set, "p7/a/b.h", matched), 1);
+    CHECK_EQ(matched[0], 1ULL << 7);
+    CHECK_EQ(nlink_glob_match(set, "p149/x.cc", matched), 1);
+    CHECK_EQ(matched[149 / 64], 1ULL << (149 % 64));
+    CHECK_EQ(nlink_glob_match(set, "p150/x.c", matched), 0);
+    CHECK_EQ(nlink_glob_match(set, "p1/x.c", NULL), 1);   // Also "p1" only, never "p1x"
+    nlink_glob_destroy(set);
+    
+    // Past the expansion budget the pattern is rejected, not truncated
+    const char* explosive = "{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}{a,b}";
+    CHECK(nlink_glob_compile(&explosive, 1) == NULL);
+}
+
+// Prefix states decide pruning: live (something may still match) and universal
+static void check_prefix_states(void) {
+    const char* whitelist[] = { "src/**/*.c", "**/nlink.txt" };
+    const char* blacklist[] = { "build/**" };
+    nlink_glob_set_t* white = nlink_glob_compile(whitelist, 1);
+    nlink_glob_set_t* white_all = nlink_glob_compile(whitelist, 2);
+    nlink_glob_set_t* black = nlink_glob_compile(blacklist, 1);
+    CHECK(white && white_all && black);
+    if (!white || !white_all || !black) return;
+    
+    uint64_t state[64];
+    nlink_glob_start(white, state);
+    nlink_glob_feed(white, state, "docs/", 5);
+    CHECK(!nlink_glob_live(white, state));
+    
+    nlink_glob_start(white, state);
+    nlink_glob_feed(white, state, "src/a/", 6);
+    CHECK(nlink_glob_live(white, state));
+    CHECK(!nlink_glob_universal(white, state));
+    
+    // '**/nlink.txt' keeps every directory alive
+    nlink_glob_start(white_all, state);
+    nlink_glob_feed(white_all, state, "docs/", 5);
+    CHECK(nlink_glob_live(white_all, state));
+    
+    nlink_glob_start(black, state);
+    nlink_glob_feed(black, state, "build/", 6);
+    CHECK(nlink_glob_universal(black, state));
+    nlink_glob_start(black, state);
+    nlink_glob_feed(black, state, "builder/", 8);
+    CHECK(!nlink_glob_universal(black, state));
+    CHECK(!nlink_glob_live(black, state));
+    
+    nlink_glob_destroy(white);
+    nlink_glob_destroy(white_all);
+    nlink_glob_destroy(black);
+}
+
+static void make_file(const char* root, const char* path) {
+    char full[512];
+    snprintf(full, sizeof(full), "%s/%s", root, path);
+    for (char* slash = strchr(full + strlen(root) + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(full, 0755);
+        *slash = '/';
+    }
+    FILE* file = fopen(full, "w");
+    CHECK(file != NULL);
+    if (file) fclose(file);
+}
+
+// Whitelist and blacklist applied by discovery, with pruned directories counted
+static void check_discovery(void) {
+    char root[] = "/tmp/nlink-glob-XXXXXX";
+    CHECK(mkdtemp(root) != NULL);
+    
+    const char* files[] = {
+        "nlink.txt", "src/a.c", "src/a.h", "src/x/y/b.c", "src/x/nlink.txt",
+        "docs/c.c", "docs/deep/nlink.txt", "build/out/d.c", "build/nlink.txt",
+        "tools/t.c"
+    };
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) make_file(root, files[i]);
+    
+    const char* whitelist[] = { "src/**/*.c", "{,**/}nlink.txt" };
+    const char* blacklist[] = { "build/**", "**/*.h" };
+    nlink_glob_set_t* white = nlink_glob_compile(whitelist, 2);
+    nlink_glob_set_t* black = nlink_glob_compile(blacklist, 2);
+    CHECK(white && black);
+    
+    nlink_discovery_t* discovery = nlink_discover_components_filtered(root, NULL, white, black);
+    CHECK(discovery != NULL);
+    if (discovery) {
+        const char* expected[] = {
+            "docs/deep/nlink.txt", "nlink.txt", "src/a.c", "src/x/nlink.txt", "src/x/y/b.c"
+        };
+        CHECK_EQ(discovery->count, sizeof(expected) / sizeof(expected[0]));
+        for (size_t i = 0; i < discovery->count && i < sizeof(expected) / sizeof(expected[0]); i++) {
+            if (strcmp(discovery->files[i].path, expected[i]) != 0) {
+                fprintf(stderr, "discovered '%s', expected '%s'\n", discovery->files[i].path, expected[i]);
+                check_failures++;
+            }
+        }
+        CHECK_EQ(discovery->pruned_count, 1);   // build/ - docs/ and tools/ may still hold nlink.txt
+        nlink_discovery_destroy(discovery);
+    }
+    
+    // Without the nlink.txt pattern docs/ and tools/ are pruned too
+    nlink_glob_destroy(white);
+    white = nlink_glob_compile(whitelist, 1);
+    discovery = nlink_discover_components_filtered(root, NULL, white, black);
+    CHECK(discovery != NULL);
+    if (discovery) {
+        CHECK_EQ(discovery->count, 2);
+        CHECK_EQ(discovery->pruned_count, 3);
+        nlink_discovery_destroy(discovery);
+    }
+    
+    nlink_glob_destroy(white);
+    nlink_glob_destroy(black);
+    
+    char command[600];
+    snprintf(command, sizeof(command), "rm -rf '%s'", root);
+    CHECK_EQ(system(command), 0);
+}
+
+int main(void) {
+    check_cases();
+    check_many_patterns();
+    check_prefix_states();
+    check_discovery();
+    return check_result();
+}
@@ -0,0 +1,55 @@
+// Component handles: released handles stop resolving, recycled slots fail the id check
+#include "check.h"
+
+int main(void) {
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return check_result();
+    nlink_component_t* caller = nlink_registry_create_component(registry, 1, "caller");
+    nlink_component_t* callee = nlink_registry_create_component(registry, 2, "callee");
+    CHECK(caller && callee);
+    if (!caller || !callee) return check_result();
+    CHECK(callee->handle != NLINK_HANDLE_NONE);
+    
+    nlink_create_indirect_edge(caller, callee, 1.0f);
+    CHECK_EQ(caller->edge_count, 1);
+    if (caller->edge_count != 1) return check_result();
+    const nlink_invocation_edge_t* edge = &caller->edges[0];
+    nlink_handle_t stale = edge->callee_handle;
+    CHECK_EQ(stale, callee->handle);
+    CHECK(nlink_edge_callee(registry, edge) == callee);
+    CHECK(nlink_registry_find(registry, 2) == callee);
+    
+    // Releasing empties the slot; a second release is a no-op
+    nlink_registry_release_handle(registry, callee);
+    CHECK_EQ(callee->handle, NLINK_HANDLE_NONE);
+    CHECK(nlink_edge_callee(registry, edge) == NULL);
+    CHECK(nlink_registry_find(registry, 2) == NULL);
+    uint32_t free_count = registry->free_handle_count;
+    nlink_registry_release_handle(registry, callee);
+    CHECK_EQ(registry->free_handle_count, free_count);
+    
+    // The next component reuses the slot, but the old edge never resolves to it
+    nlink_component_t* newcomer = nlink_registry_create_component(registry, 3, "newcomer");
+    CHECK(newcomer != NULL);
+    if (!newcomer) return check_result();
+    CHECK_EQ(newcomer->handle, stale);
+    CHECK(nlink_edge_callee(registry, edge) == NULL);
+    CHECK(nlink_registry_find(registry, 2) == NULL);
+    CHECK(nlink_registry_find(registry, 3) == newcomer);
+    
+    // Handles past the high-water mark and the reserved handle resolve to nothing
+    nlink_invocation_edge_t forged = *edge;
+    forged.callee_handle = registry->handle_count + 7;
+    CHECK(nlink_edge_callee(registry, &forged) == NULL);
+    forged.callee_handle = NLINK_HANDLE_NONE;
+    CHECK(nlink_edge_callee(registry, &forged) == NULL);
+    
+    // A fresh edge to the newcomer resolves through the recycled slot
+    nlink_create_indirect_edge(caller, newcomer, 1.0f);
+    CHECK_EQ(caller->edge_count, 2);
+    if (caller->edge_count == 2) CHECK(nlink_edge_callee(registry, &caller->edges[1]) == newcomer);
+    
+    nlink_registry_destroy(registry);
+    return check_result();
+}
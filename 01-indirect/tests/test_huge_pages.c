@@ -0,0 +1,114 @@
+// Huge-page backing: size threshold, 2 MB alignment, explicit fallback, accounting, realloc
+#include "check.h"
+
+enum { MB = 1 << 20 };
+static const nlink_memory_category_t category = NLINK_MEM_INDICES;
+
+static const nlink_large_header_t* header_of(const void* ptr) {
+    return (const nlink_large_header_t*)((const char*)ptr - NLINK_LARGE_HEADER);
+}
+
+static uint64_t live_bytes(void) {
+    nlink_memory_stats_t stats;
+    nlink_memory_stats(&stats);
+    return stats.categories[category].live_bytes;
+}
+
+static uint64_t mapping_count(void) {
+    return atomic_load(&nlink_huge_mappings_explicit) + atomic_load(&nlink_huge_mappings_transparent) +
+           atomic_load(&nlink_huge_mappings_fallback);
+}
+
+// Zeroed, writable end to end
+static void check_usable(unsigned char* data, size_t bytes) {
+    size_t dirty = 0;
+    for (size_t i = 0; i < bytes; i += 4096) dirty += data[i] != 0;
+    dirty += data[bytes - 1] != 0;
+    CHECK_EQ(dirty, 0);
+    memset(data, 0xA5, bytes);
+}
+
+// Allocations under half a huge page stay on the heap, whatever the mode
+static void check_heap_backed(nlink_page_mode_t mode, size_t bytes) {
+    nlink_set_page_mode(mode);
+    uint64_t mappings = mapping_count();
+    unsigned char* data = nlink_large_alloc(category, bytes);
+    CHECK(data != NULL);
+    if (!data) return;
+    CHECK_EQ(header_of(data)->mapped, 0);
+    CHECK_EQ(header_of(data)->bytes, bytes);
+    CHECK_EQ(mapping_count(), mappings);
+    check_usable(data, bytes);
+    nlink_large_free(category, data);
+}
+
+/**
+ * From half a huge page up the block is a whole number of 2 MB-aligned
+ * huge pages, charged at its mapped length; exactly one backing is counted
+ */
+static void check_mapped(nlink_page_mode_t mode, size_t bytes) {
+    nlink_set_page_mode(mode);
+    uint64_t explicit_before = atomic_load(&nlink_huge_mappings_explicit);
+    uint64_t mappings = mapping_count();
+    uint64_t live = live_bytes();
+    
+    unsigned char* data = nlink_large_alloc(category, bytes);
+    CHECK(data != NULL);
+    if (!data) return;
+    const nlink_large_header_t* header = header_of(data);
+    size_t expected = (bytes + NLINK_LARGE_HEADER + NLINK_HUGE_PAGE_SIZE - 1) & ~(size_t)(NLINK_HUGE_PAGE_SIZE - 1);
+    CHECK_EQ(header->mapped, expected);
+    CHECK_EQ((uintptr_t)header % NLINK_HUGE_PAGE_SIZE, 0);
+    CHECK_EQ(mapping_count(), mappings + 1);
+    if (mode == NLINK_PAGES_TRANSPARENT) CHECK_EQ(atomic_load(&nlink_huge_mappings_explicit), explicit_before);
+    CHECK_EQ(live_bytes(), live + expected);
+    check_usable(data, bytes);
+    
+    nlink_large_free(category, data);
+    CHECK_EQ(live_bytes(), live);
+}
+
+// Growing across the threshold keeps the contents and zero-fills the rest
+static void check_realloc(void) {
+    nlink_set_page_mode(NLINK_PAGES_TRANSPARENT);
+    size_t small = 64 * 1024, large = 3 * MB;
+    unsigned char* data = nlink_large_alloc(category, small);
+    CHECK(data != NULL);
+    if (!data) return;
+    for (size_t i = 0; i < small; i++) data[i] = (unsigned char)(i * 7);
+    
+    data = nlink_large_realloc(category, data, large);
+    CHECK(data != NULL);
+    if (!data) return;
+    CHECK(header_of(data)->mapped != 0);
+    size_t wrong = 0;
+    for (size_t i = 0; i < small; i++) wrong += data[i] != (unsigned char)(i * 7);
+    for (size_t i = small; i < large; i += 512) wrong += data[i] != 0;
+    CHECK_EQ(wrong, 0);
+    
+    data = nlink_large_realloc(category, data, small / 2);
+    CHECK(data != NULL);
+    if (!data) return;
+    CHECK_EQ(header_of(data)->mapped, 0);
+    wrong = 0;
+    for (size_t i = 0; i < small / 2; i++) wrong += data[i] != (unsigned char)(i * 7);
+    CHECK_EQ(wrong, 0);
+    nlink_large_free(category, data);
+}
+
+int main(void) {
+    const size_t threshold = NLINK_HUGE_PAGE_SIZE / 2 - NLINK_LARGE_HEADER;
+    check_heap_backed(NLINK_PAGES_DEFAULT, 4 * MB);
+    check_heap_backed(NLINK_PAGES_TRANSPARENT, threshold - 1);
+    check_heap_backed(NLINK_PAGES_EXPLICIT, threshold - 1);
+    
+    check_mapped(NLINK_PAGES_TRANSPARENT, threshold);
+    check_mapped(NLINK_PAGES_TRANSPARENT, NLINK_HUGE_PAGE_SIZE - NLINK_LARGE_HEADER + 1);
+    // Without reserved huge pages MAP_HUGETLB fails and the transparent path takes over
+    check_mapped(NLINK_PAGES_EXPLICIT, threshold);
+    check_mapped(NLINK_PAGES_EXPLICIT, 5 * MB);
+    
+    check_realloc();
+    nlink_set_page_mode(NLINK_PAGES_DEFAULT);
+    return check_result();
+}
@@ -0,0 +1,109 @@
+// Component id map: dense growth, conversion to the hash, removal
+#include "check.h"
+
+enum { REFERENCE_IDS = 1 << 16 };
+
+// Expected value per id, NLINK_ID_ABSENT when unmapped
+static uint32_t reference[REFERENCE_IDS];
+
+static void check_all(const nlink_id_map_t* map, size_t expected_count) {
+    size_t wrong = 0;
+    for (uint32_t id = 0; id < REFERENCE_IDS; id++) {
+        if (nlink_id_map_get(map, id) != reference[id]) wrong++;
+    }
+    CHECK_EQ(wrong, 0);
+    CHECK_EQ(map->count, expected_count);
+}
+
+static void put(nlink_id_map_t* map, uint32_t id, uint32_t value) {
+    CHECK_EQ(nlink_id_map_put(map, id, value), 0);
+    reference[id % REFERENCE_IDS] = value;
+}
+
+int main(void) {
+    for (uint32_t id = 0; id < REFERENCE_IDS; id++) reference[id] = NLINK_ID_ABSENT;
+    nlink_id_map_t map = {0};
+    
+    // Lookups on an empty map
+    CHECK_EQ(nlink_id_map_get(&map, 0), NLINK_ID_ABSENT);
+    CHECK_EQ(nlink_id_map_get(&map, 123456), NLINK_ID_ABSENT);
+    
+    // Compact ids grow the dense table past its first 64 entries
+    for (uint32_t id = 1; id <= 3000; id++) put(&map, id, id * 3);
+    CHECK(!map.hashed);
+    CHECK(map.dense_length > 3000);
+    check_all(&map, 3000);
+    
+    // Overwrites keep the count; removal needs the current value
+    nlink_id_map_remove(&map, 5000, NLINK_ID_ABSENT);
+    put(&map, 42, 7);
+    nlink_id_map_remove(&map, 42, 126);
+    CHECK_EQ(nlink_id_map_get(&map, 42), 7);
+    nlink_id_map_remove(&map, 42, 7);
+    reference[42] = NLINK_ID_ABSENT;
+    for (uint32_t id = 2; id <= 3000; id += 2) {
+        nlink_id_map_remove(&map, id, reference[id]);
+        reference[id] = NLINK_ID_ABSENT;
+    }
+    check_all(&map, 1500);
+    
+    // One id far outside the dense range moves everything into the hash
+    uint32_t far = 4000000000u;
+    CHECK_EQ(nlink_id_map_put(&map, far, 99), 0);
+    CHECK(map.hashed);
+    CHECK(map.dense == NULL);
+    CHECK_EQ(nlink_id_map_get(&map, far), 99);
+    check_all(&map, 1501);
+    
+    // Hash growth, collisions and backward-shift removal in a crowded table
+    for (uint32_t i = 0; i < 20000; i++) {
+        uint32_t id = (i * 2654435761u) % REFERENCE_IDS;
+        if (reference[id] == NLINK_ID_ABSENT) {
+            put(&map, id, i);
+        }
+    }
+    size_t mapped = 1;   // far
+    for (uint32_t id = 0; id < REFERENCE_IDS; id++) mapped += reference[id] != NLINK_ID_ABSENT;
+    check_all(&map, mapped);
+    CHECK(map.count * 2 <= map.mask + 1);
+    
+    uint64_t rng = 88172645463325252ULL;
+    for (int round = 0; round < 40000; round++) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        uint32_t id = (uint32_t)(rng % REFERENCE_IDS);
+        if (reference[id] != NLINK_ID_ABSENT && (rng >> 40) % 3) {
+            nlink_id_map_remove(&map, id, reference[id]);
+            reference[id] = NLINK_ID_ABSENT;
+            mapped--;
+        } else if (reference[id] == NLINK_ID_ABSENT) {
+            put(&map, id, (uint32_t)round);
+            mapped++;
+        }
+    }
+    check_all(&map, mapped);
+    CHECK_EQ(nlink_id_map_get(&map, far), 99);
+    
+    nlink_id_map_release(&map);
+    CHECK_EQ(map.count, 0);
+    CHECK_EQ(nlink_id_map_get(&map, 1), NLINK_ID_ABSENT);
+    
+    // Through the registry: removed ids stop resolving, new ids never reuse them
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return check_result();
+    nlink_component_t* kept = nlink_registry_create_component(registry, 5, "kept");
+    nlink_component_t* dropped = nlink_registry_create_component(registry, 9, "dropped");
+    CHECK(kept && dropped);
+    CHECK(nlink_registry_find(registry, 9) == dropped);
+    
+    uint32_t roots[] = { 5 };
+    nlink_gc_report_t report;
+    CHECK_EQ(nlink_eliminate_dead_components(registry, roots, 1, &report), 0);
+    CHECK_EQ(registry->component_count, 1);
+    CHECK(nlink_registry_find(registry, 5) == kept);
+    CHECK(nlink_registry_find(registry, 9) == NULL);
+    CHECK_EQ(nlink_registry_next_id(registry), 10);
+    nlink_registry_destroy(registry);
+    
+    return check_result();
+}
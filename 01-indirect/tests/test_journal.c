@@ -0,0 +1,271 @@
+// Journal: reopen, replay and time index after a crash-truncated tail,
+// and a time base and sequence that carry across runs
+#include "check.h"
+
+enum { EVENT_COUNT = 1000, COMPONENTS = 20 };
+
+static nlink_consciousness_event_t events[EVENT_COUNT + 100];
+
+typedef struct {
+    size_t count;
+} visit_count_t;
+
+static bool count_event(const nlink_consciousness_event_t* event, void* context) {
+    (void)event;
+    ((visit_count_t*)context)->count++;
+    return true;
+}
+
+typedef struct {
+    size_t record_count;
+    uint64_t t;
+    size_t count;
+    size_t wrong;
+} edge_check_t;
+
+// Every visited edge must carry the weight of its latest event at or before t
+static bool check_edge(const nlink_edge_state_t* edge, void* context) {
+    edge_check_t* check = context;
+    const nlink_consciousness_event_t* latest = NULL;
+    for (size_t i = 0; i < check->record_count; i++) {
+        const nlink_consciousness_event_t* event = &events[i];
+        if (event->timestamp > check->t || event->source_id != edge->caller_id ||
+            event->target_id != edge->callee_id) {
+            continue;
+        }
+        if (!latest || event->timestamp > latest->timestamp ||
+            (event->timestamp == latest->timestamp && event->sequence > latest->sequence)) {
+            latest = event;
+        }
+    }
+    if (!latest || latest->semantic_continuity != edge->semantic_weight) check->wrong++;
+    check->count++;
+    return true;
+}
+
+// Compare queries against a scan of the first record_count events
+static void check_replay(nlink_journal_t* journal, size_t record_count) {
+    CHECK_EQ(journal->record_count, record_count);
+    CHECK_EQ(journal->block_count, (record_count + NLINK_JOURNAL_INDEX_BLOCK - 1) / NLINK_JOURNAL_INDEX_BLOCK);
+    
+    // Each block's bounds cover exactly its own records
+    for (size_t b = 0; b < journal->block_count; b++) {
+        uint64_t low = UINT64_MAX, high = 0;
+        size_t end = (b + 1) * NLINK_JOURNAL_INDEX_BLOCK;
+        for (size_t r = b * NLINK_JOURNAL_INDEX_BLOCK; r < end && r < record_count; r++) {
+            if (events[r].timestamp < low) low = events[r].timestamp;
+            if (events[r].timestamp > high) high = events[r].timestamp;
+        }
+        CHECK_EQ(journal->blocks[b].min_timestamp, low);
+        CHECK_EQ(journal->blocks[b].max_timestamp, high);
+    }
+    
+    const uint64_t ranges[][2] = { { 0, UINT64_MAX }, { 5000, 30000 }, { 69000, 71000 }, { 99000, 200000 } };
+    for (uint32_t id = 0; id < COMPONENTS; id += 3) {
+        for (size_t q = 0; q < sizeof(ranges) / sizeof(ranges[0]); q++) {
+            size_t expected = 0;
+            for (size_t i = 0; i < record_count; i++) {
+                if (events[i].timestamp >= ranges[q][0] && events[i].timestamp <= ranges[q][1] &&
+                    (events[i].source_id == id || events[i].target_id == id)) {
+                    expected++;
+                }
+            }
+            visit_count_t visits = {0};
+            nlink_journal_query_component(journal, id, ranges[q][0], ranges[q][1], count_event, &visits);
+            CHECK_EQ(visits.count, expected);
+        }
+    }
+    
+    const uint64_t times[] = { 0, 25000, 70000, UINT64_MAX };
+    for (size_t q = 0; q < sizeof(times) / sizeof(times[0]); q++) {
+        bool present[COMPONENTS * COMPONENTS] = {0};
+        size_t expected = 0;
+        for (size_t i = 0; i < record_count; i++) {
+            size_t key = events[i].source_id * COMPONENTS + events[i].target_id;
+            if (events[i].timestamp <= times[q] && !present[key]) {
+                present[key] = true;
+                expected++;
+            }
+        }
+        edge_check_t check = { .record_count = record_count, .t = times[q] };
+        size_t edges = 0;
+        CHECK_EQ(nlink_journal_edge_state_at(journal, times[q], check_edge, &check, &edges), 0);
+        CHECK_EQ(edges, expected);
+        CHECK_EQ(check.count, expected);
+        CHECK_EQ(check.wrong, 0);
+    }
+}
+
+static uint64_t wall_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// The clock stepped back mid-history: queries stay exact over the dip
+static void check_clock_step(const char* path) {
+    unlink(path);
+    for (size_t i = 2 * NLINK_JOURNAL_INDEX_BLOCK; i < EVENT_COUNT; i++) {
+        events[i].timestamp -= i < 3 * NLINK_JOURNAL_INDEX_BLOCK ? 40000 : 20000;
+    }
+    nlink_journal_t* journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return;
+    CHECK_EQ(nlink_journal_append(journal, events, EVENT_COUNT), 0);
+    check_replay(journal, EVENT_COUNT);
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    unlink(path);
+}
+
+// One run: a registry links a few events and flushes them into the journal
+static void run_registry(const char* path, size_t links, uint64_t first_sequence) {
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return;
+    CHECK_EQ(nlink_registry_attach_journal(registry, path), 0);
+    CHECK_EQ(atomic_load(&registry->event_sequence), first_sequence);
+    
+    nlink_component_t* source = nlink_registry_create_component(registry, 1, "source");
+    nlink_component_t* target = nlink_registry_create_component(registry, 2, "target");
+    CHECK(source && target);
+    for (size_t i = 0; source && target && i < links; i++) {
+        nlink_update_consciousness_buffer(source, target, (float)i, NLINK_EVENT_INDIRECT_LINK);
+    }
+    CHECK_EQ(nlink_registry_destroy(registry), 0);
+}
+
+// Runs share one journal: wall-clock stamps, sequences continued, never repeated
+static bool last_weight(const nlink_edge_state_t* edge, void* context) {
+    *(float*)context = edge->semantic_weight;
+    return true;
+}
+
+static void check_runs(const char* path) {
+    unlink(path);
+    uint64_t before = wall_clock_ns();
+    run_registry(path, 5, 0);
+    uint64_t first_end = wall_clock_ns();
+    run_registry(path, 7, 5);
+    uint64_t second_end = wall_clock_ns();
+    usleep(20000);   // Coarse reads trail by up to a tick - keep them past second_end
+    nlink_set_clock_mode(NLINK_CLOCK_COARSE);
+    run_registry(path, 3, 12);
+    nlink_set_clock_mode(NLINK_CLOCK_PRECISE);
+    uint64_t after = wall_clock_ns();
+    
+    nlink_journal_t* journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return;
+    CHECK_EQ(journal->record_count, 15);
+    CHECK_EQ(journal->max_sequence, 14);
+    
+    const nlink_consciousness_event_t* records = nlink_journal_records(journal);
+    bool seen[15] = {0};
+    for (uint64_t r = 0; r < journal->record_count; r++) {
+        // Coarse reads may trail the precise wall clock by a tick
+        CHECK(records[r].timestamp + 100000000ULL >= before);
+        CHECK(records[r].timestamp <= after);
+        CHECK(records[r].sequence < 15 && !seen[records[r].sequence]);
+        if (records[r].sequence < 15) seen[records[r].sequence] = true;
+    }
+    
+    // Time queries separate the runs
+    visit_count_t visits = {0};
+    nlink_journal_query_component(journal, 2, first_end, second_end, count_event, &visits);
+    CHECK_EQ(visits.count, 7);
+    visits.count = 0;
+    nlink_journal_query_component(journal, 1, before, after, count_event, &visits);
+    CHECK_EQ(visits.count, 15);
+    
+    float weight = -1.0f;
+    size_t edges = 0;
+    CHECK_EQ(nlink_journal_edge_state_at(journal, first_end, last_weight, &weight, &edges), 0);
+    CHECK_EQ(edges, 1);
+    CHECK(weight == 4.0f);
+    CHECK_EQ(nlink_journal_edge_state_at(journal, second_end, last_weight, &weight, &edges), 0);
+    CHECK(weight == 6.0f);
+    CHECK_EQ(nlink_journal_edge_state_at(journal, after, last_weight, &weight, &edges), 0);
+    CHECK(weight == 2.0f);
+    CHECK_EQ(nlink_journal_edge_state_at(journal, before - 1, last_weight, &weight, &edges), 0);
+    CHECK_EQ(edges, 0);
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    unlink(path);
+}
+
+int main(void) {
+    char dir[] = "/tmp/nlink-journal-XXXXXX";
+    CHECK(mkdtemp(dir) != NULL);
+    char path[256];
+    snprintf(path, sizeof(path), "%s/links.nlj", dir);
+    
+    // Nearly time-sorted history, as components flush whole rings at once
+    uint64_t rng = 88172645463325252ULL;
+    for (size_t i = 0; i < EVENT_COUNT + 100; i++) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        events[i] = (nlink_consciousness_event_t){
+            .timestamp = i * 100 + rng % 700,
+            .sequence = i,
+            .source_id = (uint32_t)(rng >> 16) % COMPONENTS,
+            .target_id = (uint32_t)(rng >> 32) % COMPONENTS,
+            .semantic_continuity = (float)i,
+            .event_type = NLINK_EVENT_INDIRECT_LINK
+        };
+    }
+    
+    nlink_journal_t* journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return check_result();
+    for (size_t i = 0; i < EVENT_COUNT; i += 100) {
+        CHECK_EQ(nlink_journal_append(journal, events + i, 100), 0);
+    }
+    check_replay(journal, EVENT_COUNT);
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    
+    // Clean reopen replays everything
+    journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return check_result();
+    check_replay(journal, EVENT_COUNT);
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    
+    // Crash mid-write: the file ends inside record 700 while the header still claims 1000
+    size_t survived = 700;
+    CHECK_EQ(truncate(path, NLINK_JOURNAL_HEADER_SIZE + survived * sizeof(nlink_consciousness_event_t) + 13), 0);
+    journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return check_result();
+    check_replay(journal, survived);
+    
+    // New records land straight after the surviving ones
+    memmove(events + survived, events + EVENT_COUNT, 100 * sizeof(nlink_consciousness_event_t));
+    for (size_t i = survived; i < survived + 100; i++) events[i].sequence = i;
+    CHECK_EQ(nlink_journal_append(journal, events + survived, 100), 0);
+    check_replay(journal, survived + 100);
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    
+    journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (!journal) return check_result();
+    check_replay(journal, survived + 100);
+    CHECK_EQ(nlink_journal_close(journal), 0);
+    
+    // Only the header survived - an empty history, not an error
+    CHECK_EQ(truncate(path, NLINK_JOURNAL_HEADER_SIZE), 0);
+    journal = nlink_journal_open(path);
+    CHECK(journal != NULL);
+    if (journal) {
+        check_replay(journal, 0);
+        nlink_journal_close(journal);
+    }
+    
+    // Less than a header is not a journal
+    CHECK_EQ(truncate(path, NLINK_JOURNAL_HEADER_SIZE / 2), 0);
+    CHECK(nlink_journal_open(path) == NULL);
+    
+    check_clock_step(path);
+    check_runs(path);
+    
+    unlink(path);
+    rmdir(dir);
+    return check_result();
+}
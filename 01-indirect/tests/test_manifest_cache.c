@@ -0,0 +1,149 @@
+// Manifest cache: hits, and invalidation on size, mtime and content changes
+#include "check.h"
+
+static char root[] = "/tmp/nlink-cache-XXXXXX";
+static time_t base_time;
+
+typedef struct {
+    nlink_manifest_load_report_t report;
+    char components[512];         // "name:anchor,anchor;" per component
+} load_result_t;
+
+static void write_manifest(const char* path, const char* text, time_t mtime) {
+    char full[512];
+    snprintf(full, sizeof(full), "%s/%s", root, path);
+    FILE* file = fopen(full, "w");
+    CHECK(file != NULL);
+    if (!file) return;
+    fputs(text, file);
+    fclose(file);
+    
+    if (mtime) {
+        struct timespec times[2] = { { mtime, 0 }, { mtime, 0 } };
+        CHECK_EQ(utimensat(AT_FDCWD, full, times, 0), 0);
+    }
+}
+
+static void load(nlink_cache_mode_t mode, load_result_t* result) {
+    memset(result, 0, sizeof(*result));
+    nlink_component_registry_t* registry = nlink_registry_create();
+    nlink_discovery_t* discovery = nlink_discover_components(root, NULL);
+    CHECK(registry && discovery);
+    if (!registry || !discovery) return;
+    
+    CHECK_EQ(nlink_registry_load_manifests(registry, root, discovery, mode, &result->report), 0);
+    
+    size_t used = 0;
+    for (size_t i = 0; i < registry->component_count; i++) {
+        const nlink_component_t* comp = registry->components[i];
+        for (size_t r = 0; r < comp->residue_count; r++) {
+            used += snprintf(result->components + used, sizeof(result->components) - used, "%s%s",
+                             nlink_anchor_text(&comp->residues[r].perceptual_anchor),
+                             r == 0 ? ":" : r + 1 < comp->residue_count ? "," : "");
+        }
+        used += snprintf(result->components + used, sizeof(result->components) - used, ";");
+    }
+    
+    nlink_free(NLINK_MEM_MISC, result->report.root_ids);
+    nlink_registry_destroy(registry);
+    nlink_discovery_destroy(discovery);
+}
+
+static void check_components(const load_result_t* result, const char* expected) {
+    if (strcmp(result->components, expected) != 0) {
+        fprintf(stderr, "components '%s', expected '%s'\n", result->components, expected);
+        check_failures++;
+    }
+}
+
+#define CHECK_LOAD(result, parsed_count, hit_count, written) do { \
+    CHECK_EQ((result).report.parsed, parsed_count); \
+    CHECK_EQ((result).report.cache_hits, hit_count); \
+    CHECK_EQ((result).report.cache_written, written); \
+} while (0)
+
+int main(void) {
+    CHECK(mkdtemp(root) != NULL);
+    char sub[600];
+    snprintf(sub, sizeof(sub), "%s/sub", root);
+    CHECK_EQ(mkdir(sub, 0755), 0);
+    
+    // Well outside the racy window, so stat data alone can validate
+    base_time = time(NULL) - 1000;
+    write_manifest("nlink.txt", "component(alpha)\n semantic_anchors(one, two)\nendcomponent()\n", base_time);
+    write_manifest("sub/nlink.txt", "component(beta)\nendcomponent()\n", base_time);
+    load_result_t result;
+    
+    // First load parses and writes the cache; the next one comes from it alone
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 2, 0, true);
+    check_components(&result, "alpha:one,two;beta:;");
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 0, 2, false);
+    check_components(&result, "alpha:one,two;beta:;");
+    
+    // Same size and mtime but new content - only hash mode can tell
+    write_manifest("nlink.txt", "component(gamma)\n semantic_anchors(six, two)\nendcomponent()\n", base_time);
+    load(NLINK_CACHE_HASH, &result);
+    CHECK_LOAD(result, 1, 1, true);
+    check_components(&result, "gamma:six,two;beta:;");
+    
+    // Same size, new content and mtime
+    write_manifest("nlink.txt", "component(delta)\n semantic_anchors(six, two)\nendcomponent()\n", base_time + 10);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 1, 1, true);
+    check_components(&result, "delta:six,two;beta:;");
+    
+    // mtime moved, content did not - the hash keeps the entry and the stat data is refreshed
+    write_manifest("nlink.txt", "component(delta)\n semantic_anchors(six, two)\nendcomponent()\n", base_time + 20);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 0, 2, true);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 0, 2, false);
+    
+    // Size changed under the cached mtime
+    write_manifest("sub/nlink.txt", "component(beta)\n semantic_anchors(seven)\nendcomponent()\n", base_time);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 1, 1, true);
+    check_components(&result, "delta:six,two;beta:seven;");
+    
+    // Written just now: the entry is racy, so an edit within the same timestamp is still caught
+    time_t now = time(NULL);
+    write_manifest("sub/nlink.txt", "component(beta)\n semantic_anchors(eight)\nendcomponent()\n", now);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 1, 1, true);
+    write_manifest("sub/nlink.txt", "component(beta)\n semantic_anchors(nine!)\nendcomponent()\n", now);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_EQ(result.report.parsed, 1);
+    check_components(&result, "delta:six,two;beta:nine!;");
+    
+    // A removed manifest drops its components and rewrites the cache
+    snprintf(sub, sizeof(sub), "%s/sub/nlink.txt", root);
+    CHECK_EQ(unlink(sub), 0);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 0, 1, true);
+    check_components(&result, "delta:six,two;");
+    
+    // A damaged cache is ignored and replaced
+    char cache[600];
+    snprintf(cache, sizeof(cache), "%s/%s", root, NLINK_CACHE_FILE);
+    CHECK_EQ(truncate(cache, 24), 0);
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 1, 0, true);
+    check_components(&result, "delta:six,two;");
+    load(NLINK_CACHE_STAT, &result);
+    CHECK_LOAD(result, 0, 1, false);
+    
+    // With the cache off every manifest is parsed and nothing is written
+    CHECK_EQ(unlink(cache), 0);
+    load(NLINK_CACHE_OFF, &result);
+    CHECK_LOAD(result, 1, 0, false);
+    CHECK(access(cache, F_OK) != 0);
+    
+    snprintf(sub, sizeof(sub), "%s/nlink.txt", root);
+    unlink(sub);
+    snprintf(sub, sizeof(sub), "%s/sub", root);
+    rmdir(sub);
+    rmdir(root);
+    return check_result();
+}
@@ -0,0 +1,142 @@
+// Manifest parser: records, and the line each error is reported on
+#include "check.h"
+
+typedef struct {
+    const char* text;
+    uint32_t line;
+    const char* error;
+} parse_error_case_t;
+
+static const parse_error_case_t errors[] = {
+    { "x\n",                                        1, "expected '(' after command name" },
+    { "\n\nfoo bar\n",                              3, "expected '(' after command name" },
+    { "a(b)\nc(d))\n",                              2, "expected a command name" },
+    { "ok(a)\n\n\n(\n",                             4, "expected a command name" },
+    { "component(a\nversion(1)\n",                  2, "unexpected token" },
+    { "a(x]\n",                                     1, "unexpected token" },
+    { "\nfoo(\"abc\n\n",                            2, "unterminated string" },   // Where it opened
+    { "a(\n\n\nb,\n[c,\n d]\n",                     1, "unterminated command" },
+    { "endcomponent()\n",                           1, "endcomponent() without component()" },
+    { "\n\npattern(a)\n",                           3, "pattern() outside a whitelist or blacklist" },
+    { "component(a)\n component(b)\n",              2, "component() inside another block" },
+    { "component()\n",                              1, "component() needs a name" },
+    { "link_target()\n",                            1, "link_target() needs a name" },
+    { "component(a)\ndepends_on()\nendcomponent()\n", 2, "depends_on() needs a name" },
+    { "\nsemantic_anchors(x)\n",                    2, "component setting outside component()" },
+    { "# note\ncomponent(a)\nversion(1)\n",         2, "component() without endcomponent()" },
+    { "component(a)\nendcomponent()\n\ncomponent(\"b\nc\")\n", 4, "component() without endcomponent()" },
+};
+
+static void check_errors(nlink_manifest_t* manifest) {
+    for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+        const parse_error_case_t* c = &errors[i];
+        int result = nlink_manifest_parse(manifest, c->text, strlen(c->text));
+        CHECK_EQ(result, -1);
+        if (manifest->error_line != c->line || !manifest->error || strcmp(manifest->error, c->error) != 0) {
+            fprintf(stderr, "case %zu: got line %u '%s', expected line %u '%s'\n", i,
+                    manifest->error_line, manifest->error ? manifest->error : "(none)", c->line, c->error);
+            check_failures++;
+        }
+    }
+}
+
+static bool span_is(const nlink_manifest_t* manifest, nlink_span_t span, const char* expected) {
+    return span.length == strlen(expected) && memcmp(manifest->text + span.offset, expected, span.length) == 0;
+}
+
+static void check_records(nlink_manifest_t* manifest) {
+    const char* text =
+        "# Package manifest\n"
+        "project(demo)\n"
+        "component(\"core\")\n"
+        "    version(1.2)\n"
+        "    consciousness_level(high)\n"
+        "    semantic_anchors(parser, \"token stream\", [lexer, ast])\n"
+        "    depends_on(\"util\" \"^2\")\n"
+        "    sources(core.c, core.h)\n"
+        "endcomponent()\n"
+        "\n"
+        "component(util)\n"
+        "endcomponent()\n"
+        "configure_whitelist()\n"
+        "    pattern(\"src/**/*.c\", \"**/nlink.txt\")\n"
+        "endconfigure()\n"
+        "link_target(app, [core, util])\n"
+        "future_command(ignored)\n";
+    
+    CHECK_EQ(nlink_manifest_parse(manifest, text, strlen(text)), 0);
+    CHECK(manifest->error == NULL);
+    CHECK(span_is(manifest, manifest->project, "demo"));
+    CHECK_EQ(manifest->component_count, 2);
+    if (manifest->component_count != 2) return;
+    
+    const nlink_manifest_component_t* core = &manifest->components[0];
+    CHECK(span_is(manifest, core->name, "core"));
+    CHECK(span_is(manifest, core->version, "1.2"));
+    CHECK(span_is(manifest, core->consciousness_level, "high"));
+    CHECK_EQ(core->line, 3);
+    CHECK_EQ(core->anchor_count, 4);
+    CHECK_EQ(core->dependency_count, 1);
+    CHECK_EQ(core->source_count, 2);
+    const char* anchors[] = { "parser", "token stream", "lexer", "ast" };
+    for (uint32_t i = 0; i < core->anchor_count && i < 4; i++) {
+        CHECK(span_is(manifest, manifest->anchors.items[core->first_anchor + i], anchors[i]));
+    }
+    CHECK(span_is(manifest, manifest->dependencies[core->first_dependency].name, "util"));
+    CHECK(span_is(manifest, manifest->dependencies[core->first_dependency].constraint, "^2"));
+    CHECK(span_is(manifest, manifest->sources.items[core->first_source + 1], "core.h"));
+    
+    const nlink_manifest_component_t* util = &manifest->components[1];
+    CHECK(span_is(manifest, util->name, "util"));
+    CHECK_EQ(util->line, 11);
+    CHECK_EQ(util->anchor_count, 0);
+    CHECK_EQ(util->version.length, 0);
+    
+    CHECK_EQ(manifest->whitelist.count, 2);
+    CHECK_EQ(manifest->target_count, 1);
+    CHECK_EQ(manifest->targets[0].member_count, 2);
+    
+    // Parsing again resets the records and the error
+    CHECK_EQ(nlink_manifest_parse(manifest, "x(", 2), -1);
+    CHECK_EQ(nlink_manifest_parse(manifest, "", 0), 0);
+    CHECK_EQ(manifest->component_count, 0);
+    CHECK(manifest->error == NULL);
+    CHECK_EQ(manifest->error_line, 0);
+}
+
+// Errors keep their line when the manifest comes from a file
+static void check_load(void) {
+    char dir[] = "/tmp/nlink-parser-XXXXXX";
+    CHECK(mkdtemp(dir) != NULL);
+    char path[256];
+    snprintf(path, sizeof(path), "%s/nlink.txt", dir);
+    
+    FILE* file = fopen(path, "w");
+    CHECK(file != NULL);
+    if (!file) return;
+    fputs("component(a)\nendcomponent()\n\n\ndepends_on(b)\n", file);
+    fclose(file);
+    
+    nlink_manifest_t manifest = {0};
+    CHECK_EQ(nlink_manifest_load(&manifest, AT_FDCWD, path), -1);
+    CHECK_EQ(manifest.error_line, 5);
+    CHECK(manifest.error && strcmp(manifest.error, "component setting outside component()") == 0);
+    nlink_manifest_release(&manifest);
+    
+    snprintf(path, sizeof(path), "%s/missing.txt", dir);
+    CHECK_EQ(nlink_manifest_load(&manifest, AT_FDCWD, path), -1);
+    nlink_manifest_release(&manifest);
+    
+    snprintf(path, sizeof(path), "%s/nlink.txt", dir);
+    unlink(path);
+    rmdir(dir);
+}
+
+int main(void) {
+    nlink_manifest_t manifest = {0};
+    check_errors(&manifest);
+    check_records(&manifest);
+    nlink_manifest_release(&manifest);
+    check_load();
+    return check_result();
+}
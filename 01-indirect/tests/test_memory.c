@@ -0,0 +1,70 @@
+// Memory accounting: allocations, live and peak bytes per category, realloc deltas
+#include "check.h"
+
+static nlink_memory_category_stats_t category_stats(nlink_memory_category_t category) {
+    nlink_memory_stats_t stats;
+    nlink_memory_stats(&stats);
+    return stats.categories[category];
+}
+
+int main(void) {
+    const nlink_memory_category_t category = NLINK_MEM_ANCHORS;
+    nlink_memory_category_stats_t before = category_stats(category);
+    
+    // realloc(NULL) is the one allocation; growing and shrinking only move bytes
+    char* buffer = nlink_realloc(category, NULL, 100);
+    CHECK(buffer != NULL);
+    nlink_memory_category_stats_t now = category_stats(category);
+    CHECK_EQ(now.allocations, before.allocations + 1);
+    CHECK_EQ(now.live_bytes, before.live_bytes + malloc_usable_size(buffer));
+    
+    for (size_t size = 200; size <= 1 << 20; size *= 2) {
+        buffer = nlink_realloc(category, buffer, size);
+        CHECK(buffer != NULL);
+        if (!buffer) return check_result();
+        buffer[size - 1] = 1;
+    }
+    now = category_stats(category);
+    CHECK_EQ(now.allocations, before.allocations + 1);
+    CHECK_EQ(now.live_bytes, before.live_bytes + malloc_usable_size(buffer));
+    uint64_t peak = now.peak_bytes;
+    CHECK(peak >= now.live_bytes);
+    
+    buffer = nlink_realloc(category, buffer, 64);
+    now = category_stats(category);
+    CHECK_EQ(now.allocations, before.allocations + 1);
+    CHECK_EQ(now.live_bytes, before.live_bytes + malloc_usable_size(buffer));
+    CHECK_EQ(now.peak_bytes, peak);   // Shrinking leaves the peak alone
+    
+    // Every path back to zero
+    char* copy = nlink_strdup(category, "anchor");
+    void* zeroed = nlink_calloc(category, 10, 10);
+    void* aligned = nlink_aligned_alloc(category, 64, 256);
+    CHECK(copy && zeroed && aligned && (uintptr_t)aligned % 64 == 0);
+    CHECK_EQ(category_stats(category).allocations, before.allocations + 4);
+    nlink_free(category, buffer);
+    nlink_free(category, copy);
+    nlink_free(category, zeroed);
+    nlink_free(category, aligned);
+    nlink_free(category, NULL);
+    now = category_stats(category);
+    CHECK_EQ(now.live_bytes, before.live_bytes);
+    CHECK_EQ(now.allocations, before.allocations + 4);
+    
+    // Large tables: zeroed, grown tails zero-filled, balanced on free
+    uint64_t* table = nlink_large_alloc(category, 1000 * sizeof(uint64_t));
+    CHECK(table != NULL);
+    if (table) {
+        for (size_t i = 0; i < 1000; i++) table[i] = i + 1;
+        table = nlink_large_realloc(category, table, 5000 * sizeof(uint64_t));
+        CHECK(table != NULL);
+        size_t wrong = 0;
+        for (size_t i = 0; table && i < 5000; i++) {
+            if (table[i] != (i < 1000 ? i + 1 : 0)) wrong++;
+        }
+        CHECK_EQ(wrong, 0);
+        nlink_large_free(category, table);
+    }
+    CHECK_EQ(category_stats(category).live_bytes, before.live_bytes);
+    return check_result();
+}
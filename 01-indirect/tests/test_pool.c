@@ -0,0 +1,125 @@
+// Slab pools: per-thread magazines, depot spills, thread-exit return, concurrent traffic
+#include "check.h"
+
+enum { THREADS = 8, ROUNDS = 20000, HELD = 64, HANDOFF = 40 };
+
+static size_t depot_count(nlink_pool_kind_t kind) {
+    nlink_slab_pool_t* pool = &nlink_pools[kind];
+    pthread_mutex_lock(&pool->lock);
+    size_t count = pool->depot_count;
+    pthread_mutex_unlock(&pool->lock);
+    return count;
+}
+
+static size_t live(nlink_pool_kind_t kind) {
+    nlink_pool_stats_t stats;
+    nlink_pool_stats(kind, &stats);
+    return stats.objects_live;
+}
+
+// Objects are distinct, aligned and come back for reuse
+static void check_single_thread(void) {
+    size_t live_before = live(NLINK_POOL_RESIDUE);
+    void* objects[200];
+    for (size_t i = 0; i < 200; i++) {
+        objects[i] = nlink_pool_alloc(NLINK_POOL_RESIDUE);
+        CHECK(objects[i] != NULL);
+        CHECK_EQ((uintptr_t)objects[i] % 8, 0);
+        memset(objects[i], (int)i, nlink_pools[NLINK_POOL_RESIDUE].object_size);
+    }
+    CHECK_EQ(live(NLINK_POOL_RESIDUE), live_before + 200);
+    
+    size_t overlaps = 0;
+    for (size_t i = 0; i < 200; i++) {
+        for (size_t j = i + 1; j < 200; j++) {
+            char* a = objects[i];
+            char* b = objects[j];
+            if (a < b + nlink_pools[NLINK_POOL_RESIDUE].object_size &&
+                b < a + nlink_pools[NLINK_POOL_RESIDUE].object_size) {
+                overlaps++;
+            }
+        }
+    }
+    CHECK_EQ(overlaps, 0);
+    
+    for (size_t i = 0; i < 200; i++) nlink_pool_free(NLINK_POOL_RESIDUE, objects[i]);
+    CHECK_EQ(live(NLINK_POOL_RESIDUE), live_before);
+    
+    // The magazine hands the last freed object straight back
+    void* again = nlink_pool_alloc(NLINK_POOL_RESIDUE);
+    CHECK(again == objects[199]);
+    nlink_pool_free(NLINK_POOL_RESIDUE, again);
+    nlink_pool_free(NLINK_POOL_RESIDUE, NULL);
+    CHECK_EQ(live(NLINK_POOL_RESIDUE), live_before);
+}
+
+static void* free_only(void* objects) {
+    for (size_t i = 0; i < HANDOFF; i++) nlink_pool_free(NLINK_POOL_EDGE, ((void**)objects)[i]);
+    return NULL;
+}
+
+// A thread that never allocates still returns its magazine to the depot at exit
+static void check_free_only_thread(void) {
+    void* objects[HANDOFF];
+    for (size_t i = 0; i < HANDOFF; i++) objects[i] = nlink_pool_alloc(NLINK_POOL_EDGE);
+    size_t depot_before = depot_count(NLINK_POOL_EDGE);
+    
+    pthread_t thread;
+    CHECK_EQ(pthread_create(&thread, NULL, free_only, objects), 0);
+    CHECK_EQ(pthread_join(thread, NULL), 0);
+    CHECK_EQ(depot_count(NLINK_POOL_EDGE), depot_before + HANDOFF);
+}
+
+static _Atomic size_t foreign_objects;
+
+// Random alloc/free traffic; each held object carries its owner's tag
+static void* churn(void* arg) {
+    uint64_t tag = (uint64_t)(uintptr_t)arg;
+    uint64_t rng = tag * 0x9e3779b97f4a7c15ULL + 1;
+    uint64_t* held[HELD] = {0};
+    
+    for (size_t round = 0; round < ROUNDS; round++) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        size_t slot = rng % HELD;
+        if (held[slot]) {
+            if (held[slot][0] != tag || held[slot][1] != (uint64_t)(uintptr_t)held[slot]) {
+                atomic_fetch_add(&foreign_objects, 1);
+            }
+            nlink_pool_free(NLINK_POOL_COMPONENT, held[slot]);
+            held[slot] = NULL;
+        } else if ((held[slot] = nlink_pool_alloc(NLINK_POOL_COMPONENT)) != NULL) {
+            held[slot][0] = tag;
+            held[slot][1] = (uint64_t)(uintptr_t)held[slot];
+        }
+    }
+    for (size_t slot = 0; slot < HELD; slot++) nlink_pool_free(NLINK_POOL_COMPONENT, held[slot]);
+    return NULL;
+}
+
+static void check_concurrent(void) {
+    size_t live_before = live(NLINK_POOL_COMPONENT);
+    pthread_t threads[THREADS];
+    for (size_t t = 0; t < THREADS; t++) {
+        CHECK_EQ(pthread_create(&threads[t], NULL, churn, (void*)(uintptr_t)(t + 1)), 0);
+    }
+    for (size_t t = 0; t < THREADS; t++) CHECK_EQ(pthread_join(threads[t], NULL), 0);
+    
+    CHECK_EQ(atomic_load(&foreign_objects), 0);
+    CHECK_EQ(live(NLINK_POOL_COMPONENT), live_before);
+    
+    // Every exited thread spilled its magazine: the depot plus this thread's
+    // magazine and the uncarved tail account for the whole reserve
+    nlink_slab_pool_t* pool = &nlink_pools[NLINK_POOL_COMPONENT];
+    nlink_pool_stats_t stats;
+    nlink_pool_stats(NLINK_POOL_COMPONENT, &stats);
+    size_t carved = stats.objects_capacity - (size_t)(pool->carve_end - pool->carve) / pool->object_size;
+    CHECK_EQ(depot_count(NLINK_POOL_COMPONENT) + nlink_tls_magazines[NLINK_POOL_COMPONENT].count +
+             stats.objects_live, carved);
+}
+
+int main(void) {
+    check_single_thread();
+    check_free_only_thread();
+    check_concurrent();
+    return check_result();
+}
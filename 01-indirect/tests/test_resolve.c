@@ -0,0 +1,94 @@
+// Ranked resolution: anchor index lookups, top-k ordering, ties, order independence
+#include "check.h"
+
+enum { COMPONENTS = 12 };
+
+static float activation_of(void* context) {
+    return *(const float*)context;
+}
+
+// Activations per component; ids are 100 + position, "target" carried by the even positions
+static float activations[COMPONENTS] = { 0.9f, 0.0f, 0.7f, 0.0f, 0.9f, 0.0f, 0.4f, 0.0f, 0.7f, 0.0f, 0.95f, 0.0f };
+
+static void make_components(nlink_component_t** components) {
+    for (uint32_t i = 0; i < COMPONENTS; i++) {
+        components[i] = nlink_component_create(100 + i, (i % 2 == 0) ? "target" : "elsewhere");
+        components[i]->residues[0].activation_fn = activation_of;
+        components[i]->residues[0].contextual_frame = &activations[i];
+    }
+}
+
+static size_t resolve(nlink_component_t* source, const char* target, nlink_component_t** components,
+                      const nlink_resolve_options_t* options, nlink_resolve_candidate_t* out, size_t k) {
+    nlink_anchor_index_t index;
+    CHECK_EQ(nlink_anchor_index_build(&index, components, COMPONENTS), 0);
+    size_t count = nlink_resolve_ranked(source, target, &index, options, out, k);
+    nlink_anchor_index_release(&index);
+    return count;
+}
+
+int main(void) {
+    nlink_component_t* components[COMPONENTS];
+    make_components(components);
+    nlink_component_t* source = nlink_component_create(1, "source");
+    nlink_resolve_options_t options = { .rank_by = NLINK_RANK_ACTIVATION, .activation_threshold = 0.5f };
+    nlink_resolve_candidate_t out[COMPONENTS];
+    
+    // Top-k best-first; 0.9 ties break on the lower id; 0.4 misses the threshold
+    size_t count = resolve(source, "target", components, &options, out, COMPONENTS);
+    CHECK_EQ(count, 5);
+    const uint32_t expected[] = { 110, 100, 104, 102, 108 };
+    for (size_t i = 0; i < count && i < 5; i++) CHECK_EQ(out[i].component_id, expected[i]);
+    CHECK_EQ(out[0].registry_index, 10);
+    CHECK_EQ(source->edge_count, 0);
+    
+    count = resolve(source, "target", components, &options, out, 3);
+    CHECK_EQ(count, 3);
+    for (size_t i = 0; i < count; i++) CHECK_EQ(out[i].component_id, expected[i]);
+    CHECK_EQ(resolve(source, "target", components, &options, out, 0), 0);
+    CHECK_EQ(resolve(source, "absent", components, &options, out, 3), 0);
+    CHECK_EQ(resolve(source, "elsewhere", components, &options, out, 3), 0);   // No activation above zero
+    
+    // Reversed registry order resolves to the same ranking
+    nlink_component_t* reversed[COMPONENTS];
+    for (size_t i = 0; i < COMPONENTS; i++) reversed[i] = components[COMPONENTS - 1 - i];
+    nlink_resolve_candidate_t again[COMPONENTS];
+    CHECK_EQ(resolve(source, "target", reversed, &options, again, 2), 2);
+    CHECK_EQ(again[0].component_id, 110);
+    CHECK_EQ(again[1].component_id, 100);
+    CHECK_EQ(again[0].registry_index, 1);
+    
+    // A component carrying the anchor twice counts once, at its best activation
+    static float second_activation = 0.99f;
+    const char* texts[] = { "extra", "target" };
+    const uint32_t lengths[] = { 5, 6 };
+    nlink_component_t* merged = nlink_component_create(90, "merged");
+    CHECK_EQ(nlink_component_add_anchors_n(merged, texts, lengths, 2), 0);
+    merged->residues[2].activation_fn = activation_of;
+    merged->residues[2].contextual_frame = &second_activation;
+    nlink_component_t* extended[COMPONENTS];
+    memcpy(extended, components, sizeof(extended));
+    nlink_component_destroy(extended[1]);
+    extended[1] = merged;
+    count = resolve(source, "target", extended, &options, out, COMPONENTS);
+    CHECK_EQ(count, 6);
+    CHECK_EQ(out[0].component_id, 90);
+    CHECK(out[0].activation == second_activation);
+    components[1] = merged;
+    
+    // Ranking by edge weight, linking the winner
+    nlink_create_indirect_edge(source, components[8], 2.0f);
+    options.rank_by = NLINK_RANK_SEMANTIC_WEIGHT;
+    options.link_best = true;
+    CHECK_EQ(resolve(source, "target", components, &options, out, 2), 2);
+    CHECK_EQ(out[0].component_id, 108);
+    CHECK(out[0].score == 2.0f);
+    CHECK(out[0].activation == activations[8]);
+    CHECK_EQ(out[1].component_id, 90);
+    CHECK(nlink_find_edge(source, 108, INDIRECT) != NULL);
+    CHECK_EQ(source->edge_count, 1);   // Reinforced in place
+    
+    nlink_component_destroy(source);
+    for (size_t i = 0; i < COMPONENTS; i++) nlink_component_destroy(components[i]);
+    return check_result();
+}
@@ -0,0 +1,101 @@
+// Event sampling: exact counts, one-in-N effective rate, per-source rate limit, runtime switch
+#include "check.h"
+
+enum { EVENTS = 400, ONE_IN = 4, LIMIT = 5, BURST = 50 };
+
+static void link_events(nlink_component_t* source, nlink_component_t* target, size_t first, size_t count) {
+    // The weight carries the event number, so the ring shows which payloads were kept
+    for (size_t i = first; i < first + count; i++) {
+        nlink_update_consciousness_buffer(source, target, (float)i, NLINK_EVENT_INDIRECT_LINK);
+    }
+}
+
+static size_t ring_history(nlink_component_t* component, nlink_consciousness_event_t* history) {
+    nlink_event_ring_t* ring = atomic_load(&component->consciousness_buffer);
+    return ring ? nlink_event_ring_snapshot(ring, history, NLINK_EVENT_RING_CAPACITY) : 0;
+}
+
+static void check_stats(nlink_component_registry_t* registry, uint64_t observed, uint64_t recorded) {
+    nlink_sampling_stats_t stats;
+    nlink_registry_sampling_stats(registry, &stats);
+    CHECK_EQ(stats.events_observed, observed);
+    CHECK_EQ(stats.events_recorded, recorded);
+    CHECK(stats.effective_rate == (double)recorded / (double)observed);
+}
+
+// Every Nth event of the source keeps its payload; counts stay exact
+static void check_one_in_n(void) {
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return;
+    nlink_component_t* source = nlink_registry_create_component(registry, 1, "source");
+    nlink_component_t* target = nlink_registry_create_component(registry, 2, "target");
+    CHECK(source && target);
+    if (!source || !target) return;
+    
+    nlink_sampling_stats_t idle;
+    nlink_registry_sampling_stats(registry, &idle);
+    CHECK_EQ(idle.events_observed, 0);
+    CHECK(idle.effective_rate == 1.0);
+    
+    nlink_registry_set_sampling(registry, &(nlink_sampling_policy_t){NLINK_SAMPLE_ONE_IN_N, ONE_IN});
+    link_events(source, target, 0, EVENTS);
+    CHECK_EQ(atomic_load(&source->events_observed), EVENTS);
+    CHECK_EQ(atomic_load(&target->events_observed), 0);
+    check_stats(registry, EVENTS, EVENTS / ONE_IN);
+    
+    nlink_consciousness_event_t history[NLINK_EVENT_RING_CAPACITY];
+    size_t kept = ring_history(source, history);
+    CHECK_EQ(kept, EVENTS / ONE_IN);
+    size_t wrong = 0;
+    for (size_t i = 0; i < kept; i++) {
+        if (history[i].semantic_continuity != (float)(i * ONE_IN)) wrong++;
+    }
+    CHECK_EQ(wrong, 0);
+    
+    // Back to ALL at runtime: every later payload is kept
+    nlink_registry_set_sampling(registry, &(nlink_sampling_policy_t){NLINK_SAMPLE_ALL, 0});
+    link_events(source, target, EVENTS, ONE_IN);
+    check_stats(registry, EVENTS + ONE_IN, EVENTS / ONE_IN + ONE_IN);
+    kept = ring_history(source, history);
+    CHECK_EQ(kept, EVENTS / ONE_IN + ONE_IN);
+    for (size_t i = 0; i < ONE_IN; i++) {
+        CHECK(history[kept - ONE_IN + i].semantic_continuity == (float)(EVENTS + i));
+    }
+    nlink_registry_destroy(registry);
+}
+
+// A burst keeps at most LIMIT payloads per source, each source on its own budget
+static void check_rate_limit(void) {
+    nlink_component_registry_t* registry = nlink_registry_create();
+    CHECK(registry != NULL);
+    if (!registry) return;
+    nlink_component_t* first = nlink_registry_create_component(registry, 1, "first");
+    nlink_component_t* second = nlink_registry_create_component(registry, 2, "second");
+    nlink_component_t* target = nlink_registry_create_component(registry, 3, "target");
+    CHECK(first && second && target);
+    if (!first || !second || !target) return;
+    
+    nlink_registry_set_sampling(registry, &(nlink_sampling_policy_t){NLINK_SAMPLE_RATE_LIMIT, LIMIT});
+    link_events(first, target, 0, BURST);
+    link_events(second, target, 0, BURST);
+    check_stats(registry, 2 * BURST, 2 * LIMIT);
+    CHECK_EQ(atomic_load(&first->events_observed), BURST);
+    CHECK_EQ(atomic_load(&second->events_observed), BURST);
+    
+    // The first LIMIT events of each burst are the ones kept
+    nlink_consciousness_event_t history[NLINK_EVENT_RING_CAPACITY];
+    nlink_component_t* sources[] = {first, second};
+    for (size_t s = 0; s < 2; s++) {
+        size_t kept = ring_history(sources[s], history);
+        CHECK_EQ(kept, LIMIT);
+        for (size_t i = 0; i < kept; i++) CHECK(history[i].semantic_continuity == (float)i);
+    }
+    nlink_registry_destroy(registry);
+}
+
+int main(void) {
+    check_one_in_n();
+    check_rate_limit();
+    return check_result();
+}
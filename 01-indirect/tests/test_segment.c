@@ -0,0 +1,123 @@
+// Columnar segments: block splitting, dictionary codes, range counts and weight histograms
+#include "check.h"
+
+enum { EVENTS = 20000, BINS = 8 };
+
+static nlink_consciousness_event_t events[EVENTS];
+
+// Timestamps with small steps, occasional 2^33 ns jumps and backwards steps
+static void make_events(void) {
+    uint64_t rng = 0x2545F4914F6CDD1DULL;
+    uint64_t t = 1000;
+    const float specials[] = { NAN, INFINITY, -INFINITY, -0.5f, 1.0f, 7.0f, 1e30f, -1e30f };
+    for (size_t i = 0; i < EVENTS; i++) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        if (i % 5000 == 4999) {
+            t += 1ULL << 33;
+        } else if (i % 777 == 0 && t > 5000) {
+            t -= 3000;
+        } else {
+            t += rng % 100000;
+        }
+        events[i] = (nlink_consciousness_event_t){
+            .timestamp = t,
+            .sequence = i,
+            .source_id = (uint32_t)(rng % 50) * 3 + 1,
+            .target_id = (uint32_t)((rng >> 16) % 40) * 5 + 2,
+            .semantic_continuity = i % 97 == 0 ? specials[(i / 97) % 8]
+                                               : (float)((rng >> 32) & 0xFFFF) / 65536.0f,
+            .event_type = (rng >> 60) & 1 ? NLINK_EVENT_LINK_REINFORCED : NLINK_EVENT_INDIRECT_LINK
+        };
+    }
+}
+
+static uint32_t reference_bin(float weight) {
+    if (isnan(weight) || weight <= 0.0f) return 0;
+    if (weight >= 1.0f) return BINS - 1;
+    uint32_t bin = (uint32_t)(weight * BINS);
+    return bin < BINS ? bin : BINS - 1;
+}
+
+static void check_layout(const nlink_event_segment_t* segment) {
+    CHECK_EQ(segment->event_count, EVENTS);
+    CHECK(segment->block_count >= EVENTS / NLINK_SEGMENT_BLOCK + 4);   // Full blocks plus the jumps
+    CHECK_EQ(segment->block_start[segment->block_count], EVENTS);
+    
+    size_t wrong = 0;
+    for (size_t b = 0; b < segment->block_count; b++) {
+        size_t begin = segment->block_start[b], end = segment->block_start[b + 1];
+        if (end <= begin || end - begin > NLINK_SEGMENT_BLOCK) wrong++;
+        for (size_t i = begin; i < end; i++) {
+            uint64_t t = segment->block_base[b] + segment->timestamp_offset[i];
+            if (t != events[i].timestamp || t > segment->block_max[b]) wrong++;
+            if (segment->dictionary[segment->source_code[i]] != events[i].source_id ||
+                segment->dictionary[segment->target_code[i]] != events[i].target_id) {
+                wrong++;
+            }
+        }
+    }
+    for (uint32_t d = 1; d < segment->dictionary_size; d++) {
+        if (segment->dictionary[d - 1] >= segment->dictionary[d]) wrong++;
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+static void check_counts(const nlink_event_segment_t* segment, uint64_t bucket_ns, uint64_t t1, uint64_t t2) {
+    size_t buckets = nlink_segment_bucket_count(segment, bucket_ns);
+    size_t cells = buckets * segment->dictionary_size;
+    uint32_t* counts = calloc(cells + 1, sizeof(uint32_t));
+    uint32_t* expected = calloc(cells + 1, sizeof(uint32_t));
+    CHECK(counts && expected);
+    if (!counts || !expected) return;
+    
+    nlink_segment_count_by_target(segment, bucket_ns, t1, t2, counts);
+    for (size_t i = 0; i < EVENTS; i++) {
+        uint64_t t = events[i].timestamp;
+        if (t < t1 || t >= t2) continue;
+        expected[((t - segment->min_timestamp) / bucket_ns) * segment->dictionary_size +
+                 segment->target_code[i]]++;
+    }
+    CHECK(memcmp(counts, expected, cells * sizeof(uint32_t)) == 0);
+    free(counts);
+    free(expected);
+}
+
+int main(void) {
+    make_events();
+    nlink_event_segment_t* segment = nlink_event_segment_build(events, EVENTS);
+    CHECK(segment != NULL);
+    if (!segment) return check_result();
+    check_layout(segment);
+    
+    uint64_t span = segment->max_timestamp - segment->min_timestamp;
+    check_counts(segment, 1ULL << 30, 0, UINT64_MAX);
+    check_counts(segment, 1ULL << 31, segment->min_timestamp + span / 3, segment->min_timestamp + span / 2);
+    check_counts(segment, span + 1, events[100].timestamp, events[12000].timestamp);
+    
+    // Histogram - NaN in the first bin, out-of-range weights in the end bins
+    uint64_t histogram[NLINK_EVENT_TYPE_COUNT * BINS];
+    uint64_t expected[NLINK_EVENT_TYPE_COUNT * BINS] = {0};
+    nlink_segment_weight_histogram(segment, BINS, histogram);
+    for (size_t i = 0; i < EVENTS; i++) {
+        expected[events[i].event_type * BINS + reference_bin(events[i].semantic_continuity)]++;
+    }
+    CHECK(memcmp(histogram, expected, sizeof(expected)) == 0);
+    
+    uint64_t single[NLINK_EVENT_TYPE_COUNT];
+    nlink_segment_weight_histogram(segment, 1, single);
+    CHECK_EQ(single[NLINK_EVENT_INDIRECT_LINK] + single[NLINK_EVENT_LINK_REINFORCED], EVENTS);
+    nlink_event_segment_destroy(segment);
+    
+    // Empty segment
+    segment = nlink_event_segment_build(NULL, 0);
+    CHECK(segment != NULL);
+    if (segment) {
+        CHECK_EQ(segment->block_count, 0);
+        CHECK_EQ(nlink_segment_bucket_count(segment, 1000), 0);
+        nlink_segment_weight_histogram(segment, BINS, histogram);
+        uint64_t zero[NLINK_EVENT_TYPE_COUNT * BINS] = {0};
+        CHECK(memcmp(histogram, zero, sizeof(zero)) == 0);
+        nlink_event_segment_destroy(segment);
+    }
+    return check_result();
+}